@@ -0,0 +1,139 @@
+// MARE
+#include "BatchMath.hpp"
+
+// Standard Library
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+// External Libraries
+#include "glm.hpp"
+#include "gtc/matrix_transform.hpp"
+
+using namespace mare;
+
+namespace {
+
+constexpr size_t COUNT = 1 << 16; /**< Elements processed per iteration.*/
+constexpr int ITERATIONS = 200;   /**< Timed iterations per kernel.*/
+
+/**
+ * @brief Run a kernel once to warm the caches, then time it.
+ *
+ * @param kernel The kernel to run over COUNT elements.
+ * @return The mean time per element in nanoseconds.
+ */
+double time_kernel(const std::function<void()> &kernel) {
+  kernel();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++) {
+    kernel();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (double(ITERATIONS) * double(COUNT));
+}
+
+/**
+ * @brief Time a kernel with glm and with each batch instruction set and print
+ * one row of results.
+ *
+ * @param name The name of the kernel.
+ * @param reference The plain glm loop to compare against.
+ * @param kernel The batch kernel.
+ */
+void compare(const char *name, const std::function<void()> &reference,
+             const std::function<void()> &kernel) {
+  double glm_ns = time_kernel(reference);
+  std::printf("%-18s %10.3f", name, glm_ns);
+  for (batch::InstructionSet set :
+       {batch::InstructionSet::SCALAR, batch::InstructionSet::SSE,
+        batch::InstructionSet::AVX2}) {
+    if (batch::set_instruction_set(set) != set) {
+      std::printf(" %10s", "n/a");
+      continue;
+    }
+    std::printf(" %10.3f", time_kernel(kernel));
+  }
+  std::printf("\n");
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  auto random_vec3 = [&]() {
+    return glm::vec3(dist(rng), dist(rng), dist(rng));
+  };
+  auto random_matrix = [&]() {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), random_vec3());
+    m = glm::rotate(m, dist(rng), glm::normalize(random_vec3()));
+    return glm::scale(m, glm::abs(random_vec3()) + 0.1f);
+  };
+
+  std::vector<glm::mat4> a(COUNT), b(COUNT), out(COUNT);
+  std::vector<glm::vec3> points(COUNT), out_points(COUNT);
+  std::vector<glm::vec3> mins(COUNT), maxs(COUNT);
+  std::vector<glm::vec3> out_mins(COUNT), out_maxs(COUNT);
+  for (size_t i = 0; i < COUNT; i++) {
+    a[i] = random_matrix();
+    b[i] = random_matrix();
+    points[i] = random_vec3();
+    mins[i] = glm::min(points[i], random_vec3());
+    maxs[i] = glm::max(points[i], random_vec3());
+  }
+  glm::mat4 parent = random_matrix();
+
+  std::printf("%-18s %10s %10s %10s %10s\n", "ns per element", "glm", "scalar",
+              "sse", "avx2");
+  compare(
+      "multiply",
+      [&]() {
+        for (size_t i = 0; i < COUNT; i++) {
+          out[i] = a[i] * b[i];
+        }
+      },
+      [&]() { batch::multiply(a.data(), b.data(), out.data(), COUNT); });
+  compare(
+      "multiply parent",
+      [&]() {
+        for (size_t i = 0; i < COUNT; i++) {
+          out[i] = parent * b[i];
+        }
+      },
+      [&]() { batch::multiply(parent, b.data(), out.data(), COUNT); });
+  compare(
+      "transform_points",
+      [&]() {
+        for (size_t i = 0; i < COUNT; i++) {
+          out_points[i] = glm::vec3(parent * glm::vec4(points[i], 1.0f));
+        }
+      },
+      [&]() {
+        batch::transform_points(parent, points.data(), out_points.data(),
+                                COUNT);
+      });
+  compare(
+      "transform_aabbs",
+      [&]() {
+        for (size_t i = 0; i < COUNT; i++) {
+          glm::vec3 center = glm::vec3(a[i] * glm::vec4(
+                                                  0.5f * (mins[i] + maxs[i]),
+                                                  1.0f));
+          glm::vec3 half = 0.5f * (maxs[i] - mins[i]);
+          glm::mat3 m(a[i]);
+          glm::vec3 extent = glm::abs(m[0]) * half.x +
+                             glm::abs(m[1]) * half.y + glm::abs(m[2]) * half.z;
+          out_mins[i] = center - extent;
+          out_maxs[i] = center + extent;
+        }
+      },
+      [&]() {
+        batch::transform_aabbs(a.data(), mins.data(), maxs.data(),
+                               out_mins.data(), out_maxs.data(), COUNT);
+      });
+  return 0;
+}
@@ -0,0 +1,565 @@
+#ifndef ARCHETYPES
+#define ARCHETYPES
+
+// MARE
+#include "EntityPool.hpp"
+#include "JobSystem.hpp"
+#include "Mare.hpp"
+#include "TypeIndex.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief A generational handle to an entity stored in an ArchetypeStore.
+ * @details Packed the same way as an EntityHandle, so a handle to a destroyed
+ * entity stays invalid after its slot is reused.
+ * @see EntityHandle
+ */
+using ComponentEntity = EntityHandle;
+/**
+ * @brief A unique id for each type of component.
+ */
+using ComponentID = TypeID;
+
+/**
+ * @brief Get the ComponentID of a component type.
+ *
+ * @tparam <T> The type of component.
+ * @return The ComponentID of <T>.
+ */
+template <typename T> ComponentID component_id() { return type_id<T>(); }
+
+/**
+ * @brief A type erased array holding one component of every entity in an
+ * Archetype.
+ */
+class IComponentColumn {
+public:
+  virtual ~IComponentColumn() {}
+  /**
+   * @brief Remove a row by moving the last row into it.
+   *
+   * @param row The row to remove.
+   */
+  virtual void swap_remove(size_t row) = 0;
+  /**
+   * @brief Append a row to another column of the same type and then remove it
+   * from this column by moving the last row into it.
+   *
+   * @param row The row to move.
+   * @param destination The column to append the row to.
+   */
+  virtual void move_row(size_t row, IComponentColumn *destination) = 0;
+  /**
+   * @brief Reserve storage for a number of rows.
+   *
+   * @param count The number of rows.
+   */
+  virtual void reserve(size_t count) = 0;
+  /**
+   * @brief Create an empty column of the same type.
+   *
+   * @return The empty column.
+   */
+  virtual Scoped<IComponentColumn> gen_empty() const = 0;
+};
+
+/**
+ * @brief A contiguous array of components of type <T>.
+ *
+ * @tparam <T> The type of component.
+ */
+template <typename T> class ComponentColumn : public IComponentColumn {
+public:
+  void swap_remove(size_t row) override {
+    if (row + 1 != data.size()) {
+      data[row] = std::move(data.back());
+    }
+    data.pop_back();
+  }
+  void move_row(size_t row, IComponentColumn *destination) override {
+    static_cast<ComponentColumn<T> *>(destination)
+        ->data.push_back(std::move(data[row]));
+    swap_remove(row);
+  }
+  void reserve(size_t count) override { data.reserve(count); }
+  Scoped<IComponentColumn> gen_empty() const override {
+    return gen_scoped<ComponentColumn<T>>();
+  }
+  std::vector<T> data{}; /**< The components.*/
+};
+
+/**
+ * @brief The storage of every entity with exactly the same set of component
+ * types.
+ * @details Each component type is stored in its own contiguous array and an
+ * entity is a row across all of the arrays.
+ */
+class Archetype {
+public:
+  /**
+   * @brief Get the contiguous array of a component type.
+   *
+   * @tparam <T> The type of component.
+   * @return A pointer to the first component or nullptr if the Archetype does
+   * not have the component type.
+   */
+  template <typename T> T *data() {
+    int column = find(component_id<T>());
+    if (column < 0) {
+      return nullptr;
+    }
+    return static_cast<ComponentColumn<T> *>(columns[column].get())
+        ->data.data();
+  }
+  /**
+   * @brief Check if the Archetype has a component type.
+   *
+   * @param id The ComponentID of the type.
+   * @return true if the Archetype has the component type.
+   */
+  bool has(ComponentID id) const { return find(id) >= 0; }
+  /**
+   * @brief Get the column index of a component type.
+   *
+   * @param id The ComponentID of the type.
+   * @return The column index or -1 if the Archetype does not have the type.
+   */
+  int find(ComponentID id) const {
+    for (size_t i = 0; i < signature.size(); i++) {
+      if (signature[i] == id) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+  /**
+   * @brief Get the number of entities in the Archetype.
+   *
+   * @return The number of entities.
+   */
+  size_t size() const { return entities.size(); }
+
+  std::vector<ComponentID> signature{}; /**< Sorted ComponentIDs.*/
+  std::vector<Scoped<IComponentColumn>>
+      columns{}; /**< One column per ComponentID in the signature.*/
+  std::vector<ComponentEntity> entities{}; /**< The entity of each row.*/
+};
+
+/**
+ * @brief Contiguous, data-oriented storage for entities made of plain struct
+ * components.
+ * @details Entities are grouped into Archetypes by their set of component
+ * types. Each component type of an Archetype lives in a contiguous array, so
+ * each<Ts...>() iterates components linearly without any virtual calls or
+ * RTTI. Entities are addressed by generational ComponentEntity handles which
+ * stay valid while components are added or removed and become invalid when
+ * the entity is destroyed. Removal is O(1) by moving the last row of the
+ * Archetype into the removed row.
+ *
+ * This is an alternative to the Entity and Component inheritance model for
+ * scenes with very large numbers of simple objects. Every Layer and Scene owns
+ * an ArchetypeStore. Only Systems written against the store reach its
+ * entities: BatchPacketRenderer draws Transform and MeshPacket entities and
+ * BatchEulerMethod integrates Transform and RigidbodyState entities when
+ * attached to the Layer or Scene. The IRenderSystems, IPhysicsSystems and
+ * IControlsSystems of Entities on the Entity stack never see them, and neither
+ * do the Layer's SpatialIndex, TransformHierarchy or Renderer::pick(), so
+ * component entities are not culled through the BVH, picked or parented.
+ * @see Layer::each()
+ */
+class ArchetypeStore {
+public:
+  ArchetypeStore() {}
+  ArchetypeStore(const ArchetypeStore &) = delete;
+  ArchetypeStore &operator=(const ArchetypeStore &) = delete;
+  /**
+   * @brief Create an entity from a set of components.
+   *
+   * @tparam <Ts> The types of components, each type at most once.
+   * @param components The components of the entity.
+   * @return The handle of the new entity.
+   */
+  template <typename... Ts> ComponentEntity gen_entity(Ts... components) {
+    Archetype *archetype = get_archetype<Ts...>();
+    return push_row(archetype, std::move(components)...);
+  }
+  /**
+   * @brief Create a number of entities with the same components.
+   * @details Storage is reserved once for all of the entities.
+   *
+   * @tparam <Ts> The types of components, each type at most once.
+   * @param count The number of entities.
+   * @param components The components copied into every entity.
+   * @return The handles of the new entities.
+   */
+  template <typename... Ts>
+  std::vector<ComponentEntity> gen_entities(uint32_t count,
+                                            Ts... components) {
+    Archetype *archetype = get_archetype<Ts...>();
+    for (auto &column : archetype->columns) {
+      column->reserve(archetype->size() + count);
+    }
+    archetype->entities.reserve(archetype->size() + count);
+    records_.reserve(records_.size() + count);
+    std::vector<ComponentEntity> entities{};
+    entities.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      entities.push_back(push_row(archetype, components...));
+    }
+    return entities;
+  }
+  /**
+   * @brief Destroy an entity and all of its components.
+   *
+   * @param entity The handle of the entity.
+   */
+  void pull_entity(ComponentEntity entity) {
+    if (!valid(entity)) {
+      return;
+    }
+    Record &record = records_[entity.index()];
+    for (auto &column : record.archetype->columns) {
+      column->swap_remove(record.row);
+    }
+    swap_remove_entity(record.archetype, record.row);
+    record.archetype = nullptr;
+    record.generation =
+        (record.generation + 1) & EntityHandle::generation_mask;
+    free_.push_back(entity.index());
+    size_--;
+  }
+  /**
+   * @brief Check if a handle refers to a live entity.
+   *
+   * @param entity The handle of the entity.
+   * @return true if the entity exists.
+   */
+  bool valid(ComponentEntity entity) const {
+    uint32_t index = entity.index();
+    return entity != ComponentEntity{} && index < records_.size() &&
+           records_[index].archetype &&
+           records_[index].generation == entity.generation();
+  }
+  /**
+   * @brief Get a component of an entity.
+   * @details The pointer is invalidated when entities are added to or removed
+   * from the entity's Archetype.
+   *
+   * @tparam <T> The type of component.
+   * @param entity The handle of the entity.
+   * @return A pointer to the component or nullptr if the entity does not have
+   * the component.
+   */
+  template <typename T> T *get(ComponentEntity entity) {
+    if (!valid(entity)) {
+      return nullptr;
+    }
+    Record &record = records_[entity.index()];
+    T *data = record.archetype->data<T>();
+    return data ? data + record.row : nullptr;
+  }
+  /**
+   * @brief Add a component to an entity, moving the entity to the Archetype
+   * with the new set of components. If the entity already has a component of
+   * type <T>, it is replaced.
+   *
+   * @tparam <T> The type of component.
+   * @param entity The handle of the entity.
+   * @param component The component to add.
+   */
+  template <typename T> void add(ComponentEntity entity, T component) {
+    if (!valid(entity)) {
+      return;
+    }
+    if (T *existing = get<T>(entity)) {
+      *existing = std::move(component);
+      return;
+    }
+    Archetype *source = records_[entity.index()].archetype;
+    std::vector<ComponentID> signature = source->signature;
+    signature.push_back(component_id<T>());
+    std::sort(signature.begin(), signature.end());
+    Archetype *destination = find_archetype(signature);
+    if (!destination) {
+      destination = gen_archetype(signature);
+      for (size_t i = 0; i < signature.size(); i++) {
+        int column = source->find(signature[i]);
+        destination->columns[i] = column < 0
+                                      ? gen_scoped<ComponentColumn<T>>()
+                                      : source->columns[column]->gen_empty();
+      }
+    }
+    move_entity(entity, destination);
+    static_cast<ComponentColumn<T> *>(
+        destination->columns[destination->find(component_id<T>())].get())
+        ->data.push_back(std::move(component));
+  }
+  /**
+   * @brief Remove a component from an entity, moving the entity to the
+   * Archetype with the new set of components.
+   *
+   * @tparam <T> The type of component.
+   * @param entity The handle of the entity.
+   */
+  template <typename T> void remove(ComponentEntity entity) {
+    if (!valid(entity)) {
+      return;
+    }
+    Archetype *source = records_[entity.index()].archetype;
+    int removed = source->find(component_id<T>());
+    if (removed < 0) {
+      return;
+    }
+    std::vector<ComponentID> signature = source->signature;
+    signature.erase(signature.begin() + removed);
+    Archetype *destination = find_archetype(signature);
+    if (!destination) {
+      destination = gen_archetype(signature);
+      for (size_t i = 0; i < signature.size(); i++) {
+        destination->columns[i] =
+            source->columns[source->find(signature[i])]->gen_empty();
+      }
+    }
+    // drop the removed component before the row is moved
+    source->columns[removed]->swap_remove(records_[entity.index()].row);
+    move_entity(entity, destination, removed);
+  }
+  /**
+   * @brief Call a function on every entity that has all of the component
+   * types <Ts>.
+   * @details The components are iterated linearly, one Archetype at a time.
+   * The function must not add or remove entities or components.
+   *
+   * @tparam <Ts> The types of components.
+   * @tparam <F> A function taking (Ts&...).
+   * @param fn The function.
+   */
+  template <typename... Ts, typename F> void each(F &&fn) {
+    for (auto &archetype : archetypes_) {
+      size_t count = archetype->size();
+      if (!count) {
+        continue;
+      }
+      auto columns = std::make_tuple(archetype->template data<Ts>()...);
+      if (!all_columns(columns, std::index_sequence_for<Ts...>{})) {
+        continue;
+      }
+      std::apply(
+          [&](Ts *... data) {
+            for (size_t i = 0; i < count; i++) {
+              fn(data[i]...);
+            }
+          },
+          columns);
+    }
+  }
+  /**
+   * @brief Call a function on every entity that has all of the component
+   * types <Ts> and pass its component of type <O> if it has one.
+   * @details Same iteration rules as each().
+   *
+   * @tparam <O> The type of the optional component.
+   * @tparam <Ts> The types of components.
+   * @tparam <F> A function taking (Ts&..., O*), O* is nullptr for entities
+   * without a component of type <O>.
+   * @param fn The function.
+   */
+  template <typename O, typename... Ts, typename F> void each_optional(F &&fn) {
+    for (auto &archetype : archetypes_) {
+      size_t count = archetype->size();
+      if (!count) {
+        continue;
+      }
+      auto columns = std::make_tuple(archetype->template data<Ts>()...);
+      if (!all_columns(columns, std::index_sequence_for<Ts...>{})) {
+        continue;
+      }
+      O *optional = archetype->template data<O>();
+      std::apply(
+          [&](Ts *... data) {
+            for (size_t i = 0; i < count; i++) {
+              fn(data[i]..., optional ? optional + i : nullptr);
+            }
+          },
+          columns);
+    }
+  }
+  /**
+   * @brief Call a function on every entity that has all of the component
+   * types <Ts>, spreading the entities over the threads of a JobSystem.
+   * @details Returns when every call has finished. The function must be safe
+   * to call concurrently on different entities.
+   *
+   * @tparam <Ts> The types of components.
+   * @tparam <F> A function taking (Ts&...).
+   * @param jobs The JobSystem.
+   * @param grain_size The number of entities per task.
+   * @param fn The function.
+   */
+  template <typename... Ts, typename F>
+  void parallel_each(JobSystem &jobs, size_t grain_size, F &&fn) {
+    for (auto &archetype : archetypes_) {
+      size_t count = archetype->size();
+      if (!count) {
+        continue;
+      }
+      auto columns = std::make_tuple(archetype->template data<Ts>()...);
+      if (!all_columns(columns, std::index_sequence_for<Ts...>{})) {
+        continue;
+      }
+      jobs.parallel_for(count, grain_size, [&](size_t begin, size_t end) {
+        std::apply(
+            [&](Ts *... data) {
+              for (size_t i = begin; i < end; i++) {
+                fn(data[i]...);
+              }
+            },
+            columns);
+      });
+    }
+  }
+  /**
+   * @brief Get the number of live entities.
+   *
+   * @return The number of entities.
+   */
+  size_t size() const { return size_; }
+  /**
+   * @brief Destroy every entity and Archetype.
+   * @details Every handle is invalidated, the slots are kept for reuse.
+   */
+  void clear() {
+    archetypes_.clear();
+    free_.clear();
+    for (uint32_t i = 0; i < records_.size(); i++) {
+      Record &record = records_[i];
+      if (record.archetype) {
+        record.archetype = nullptr;
+        record.generation =
+            (record.generation + 1) & EntityHandle::generation_mask;
+      }
+      free_.push_back(i);
+    }
+    size_ = 0;
+  }
+
+private:
+  /**
+   * @brief The location of an entity.
+   */
+  struct Record {
+    Archetype *archetype{nullptr}; /**< nullptr if the entity is destroyed.*/
+    size_t row{0};                 /**< The row in the Archetype.*/
+    uint32_t generation{0};        /**< Incremented when the slot is freed.*/
+  };
+  template <typename Tuple, size_t... Is>
+  static bool all_columns(const Tuple &columns, std::index_sequence<Is...>) {
+    return (true && ... && (std::get<Is>(columns) != nullptr));
+  }
+  template <typename... Ts> Archetype *get_archetype() {
+    std::vector<ComponentID> signature{component_id<Ts>()...};
+    std::sort(signature.begin(), signature.end());
+    if (Archetype *archetype = find_archetype(signature)) {
+      return archetype;
+    }
+    Archetype *archetype = gen_archetype(signature);
+    // columns are stored in signature order
+    ((archetype->columns[archetype->find(component_id<Ts>())] =
+          gen_scoped<ComponentColumn<Ts>>()),
+     ...);
+    return archetype;
+  }
+  Archetype *find_archetype(const std::vector<ComponentID> &signature) {
+    for (auto &archetype : archetypes_) {
+      if (archetype->signature == signature) {
+        return archetype.get();
+      }
+    }
+    return nullptr;
+  }
+  Archetype *gen_archetype(const std::vector<ComponentID> &signature) {
+    archetypes_.push_back(gen_scoped<Archetype>());
+    Archetype *archetype = archetypes_.back().get();
+    archetype->signature = signature;
+    archetype->columns.resize(signature.size());
+    return archetype;
+  }
+  template <typename... Ts>
+  ComponentEntity push_row(Archetype *archetype, Ts... components) {
+    ((static_cast<ComponentColumn<Ts> *>(
+          archetype->columns[archetype->find(component_id<Ts>())].get())
+          ->data.push_back(std::move(components))),
+     ...);
+    uint32_t index;
+    if (free_.empty()) {
+      index = static_cast<uint32_t>(records_.size());
+      records_.push_back({});
+    } else {
+      index = free_.back();
+      free_.pop_back();
+    }
+    Record &record = records_[index];
+    record.archetype = archetype;
+    record.row = archetype->size();
+    ComponentEntity entity{(record.generation << EntityHandle::index_bits) |
+                           index};
+    archetype->entities.push_back(entity);
+    size_++;
+    return entity;
+  }
+  /**
+   * @brief Remove the entity of a row and update the record of the entity
+   * that was moved into the row.
+   */
+  void swap_remove_entity(Archetype *archetype, size_t row) {
+    ComponentEntity last = archetype->entities.back();
+    archetype->entities[row] = last;
+    archetype->entities.pop_back();
+    if (row < archetype->entities.size()) {
+      records_[last.index()].row = row;
+    }
+  }
+  /**
+   * @brief Move the components an entity shares with another Archetype into
+   * it.
+   *
+   * @param entity The handle of the entity.
+   * @param destination The Archetype to move the entity to.
+   * @param skip A column of the source already removed, -1 for none.
+   */
+  void move_entity(ComponentEntity entity, Archetype *destination,
+                   int skip = -1) {
+    Record &record = records_[entity.index()];
+    Archetype *source = record.archetype;
+    size_t row = record.row;
+    for (size_t i = 0; i < source->signature.size(); i++) {
+      if (static_cast<int>(i) == skip) {
+        continue;
+      }
+      int column = destination->find(source->signature[i]);
+      source->columns[i]->move_row(row, destination->columns[column].get());
+    }
+    swap_remove_entity(source, row);
+    record.archetype = destination;
+    record.row = destination->size();
+    destination->entities.push_back(entity);
+  }
+
+  std::vector<Scoped<Archetype>> archetypes_{}; /**< Every Archetype.*/
+  std::vector<Record> records_{}; /**< The location of every handle.*/
+  std::vector<uint32_t> free_{};  /**< Record slots free for reuse.*/
+  size_t size_{0};                /**< Live entities.*/
+};
+
+} // namespace mare
+
+#endif
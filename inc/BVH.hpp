@@ -0,0 +1,259 @@
+#ifndef BOUNDINGVOLUMEHIERARCHY
+#define BOUNDINGVOLUMEHIERARCHY
+
+// MARE
+#include "Bounds.hpp"
+
+// Standard Library
+#include <cstdint>
+#include <vector>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+// Forward Declarations
+class Entity;
+
+/**
+ * @brief A dynamic bounding volume hierarchy of Entity bounding boxes.
+ * @details Each Entity is a leaf with a *fat* AABB that is its bounding box
+ * grown by a margin, so small movements do not change the tree at all. When an
+ * Entity moves out of its fat AABB the leaf is removed and reinserted. Leaves
+ * are inserted next to the sibling with the lowest surface area cost and the
+ * ancestors are refit and rebalanced with tree rotations on the way back up, so
+ * the tree stays balanced under any insertion order. build() rebuilds the
+ * whole tree top down with the binned surface area heuristic, which gives
+ * better trees for static content after loading.
+ *
+ * Every operation on the tree reuses the nodes of removed leaves and does not
+ * allocate once the tree has grown. Queries do not modify the tree and may run
+ * concurrently.
+ * @see SpatialIndex
+ */
+class BVH {
+public:
+  static constexpr int32_t null_node = -1; /**< An invalid proxy.*/
+  /**
+   * @brief Construct a new empty BVH.
+   *
+   * @param margin The distance the fat AABB of each leaf extends past its
+   * bounding box.
+   */
+  BVH(float margin = 0.1f) : margin_(margin) {}
+  /**
+   * @brief Insert an Entity.
+   *
+   * @param entity The Entity.
+   * @param box The bounding box of the Entity in world space.
+   * @return The proxy of the leaf used to move or remove the Entity.
+   */
+  int32_t insert(Entity *entity, const AABB &box);
+  /**
+   * @brief Remove an Entity.
+   *
+   * @param proxy The proxy of the Entity returned by insert().
+   */
+  void remove(int32_t proxy);
+  /**
+   * @brief Update the bounding box of an Entity.
+   *
+   * @param proxy The proxy of the Entity returned by insert().
+   * @param box The new bounding box of the Entity in world space.
+   * @return true if the leaf was reinserted, false if the box still fits in
+   * its fat AABB.
+   */
+  bool move(int32_t proxy, const AABB &box);
+  /**
+   * @brief Rebuild the tree from its leaves with the surface area heuristic.
+   * @details Proxies stay valid.
+   */
+  void build();
+  /**
+   * @brief Remove every Entity.
+   */
+  void clear();
+  /**
+   * @brief Get the Entity of a leaf.
+   *
+   * @param proxy The proxy of the Entity.
+   * @return The Entity.
+   */
+  Entity *get_entity(int32_t proxy) const { return nodes_[proxy].entity; }
+  /**
+   * @brief Get the fat AABB of a leaf.
+   *
+   * @param proxy The proxy of the Entity.
+   * @return The fat AABB.
+   */
+  const AABB &get_fat_aabb(int32_t proxy) const { return nodes_[proxy].box; }
+  /**
+   * @brief Get the number of Entities in the tree.
+   *
+   * @return The number of Entities.
+   */
+  size_t size() const { return leaf_count_; }
+  /**
+   * @brief Get the height of the tree.
+   *
+   * @return The height, 0 for an empty tree or a single leaf.
+   */
+  int32_t get_height() const {
+    return root_ == null_node ? 0 : nodes_[root_].height;
+  }
+  /**
+   * @brief Find every Entity whose fat AABB overlaps a box.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param box The box in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F> void query(const AABB &box, F callback) const {
+    traverse([&box](const AABB &node) { return box.overlaps(node); },
+             callback);
+  }
+  /**
+   * @brief Find every Entity whose fat AABB overlaps a sphere.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param sphere The sphere in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F>
+  void query(const BoundingSphere &sphere, F callback) const {
+    traverse(
+        [&sphere](const AABB &node) {
+          return node.overlaps(sphere.center, sphere.radius);
+        },
+        callback);
+  }
+  /**
+   * @brief Find every Entity whose fat AABB intersects a Frustum.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param frustum The Frustum in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F> void query(const Frustum &frustum, F callback) const {
+    traverse([&frustum](const AABB &node) { return frustum.intersects(node); },
+             callback);
+  }
+  /**
+   * @brief Find the Entities whose fat AABB is hit by a ray.
+   * @details Entities are not reported in order of distance. The callback
+   * returns the new length of the ray, so returning the exact distance to a
+   * hit prunes everything behind it, returning \p max_distance keeps the ray
+   * unchanged and returning 0 stops the query.
+   *
+   * @tparam <F> float(Entity *, float distance), distance is where the ray
+   * enters the fat AABB.
+   * @param origin The origin of the ray in world space.
+   * @param direction The direction of the ray.
+   * @param max_distance The length of the ray in units of \p direction.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F>
+  void raycast(glm::vec3 origin, glm::vec3 direction, float max_distance,
+               F callback) const {
+    glm::vec3 inverse_direction = 1.0f / direction;
+    Stack stack{};
+    if (root_ != null_node) {
+      stack.push(root_);
+    }
+    while (!stack.empty() && max_distance > 0.0f) {
+      const Node &node = nodes_[stack.pop()];
+      float distance;
+      if (!node.box.intersects(origin, inverse_direction, max_distance,
+                               distance)) {
+        continue;
+      }
+      if (node.is_leaf()) {
+        max_distance = callback(node.entity, distance);
+      } else {
+        stack.push(node.left);
+        stack.push(node.right);
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief A node of the tree, either a leaf holding an Entity or an internal
+   * node with two children.
+   */
+  struct Node {
+    AABB box{};                /**< The fat AABB or the union of the children.*/
+    Entity *entity{nullptr};   /**< The Entity of a leaf.*/
+    int32_t parent{null_node}; /**< The parent, or the next free node.*/
+    int32_t left{null_node};   /**< The first child.*/
+    int32_t right{null_node};  /**< The second child.*/
+    int32_t height{-1};        /**< 0 for leaves, -1 for free nodes.*/
+    bool is_leaf() const { return left == null_node; }
+  };
+  /**
+   * @brief A traversal stack that only allocates for very deep trees.
+   */
+  class Stack {
+  public:
+    void push(int32_t node) {
+      if (size_ < fixed_size) {
+        fixed_[size_++] = node;
+      } else {
+        overflow_.push_back(node);
+      }
+    }
+    int32_t pop() {
+      if (!overflow_.empty()) {
+        int32_t node = overflow_.back();
+        overflow_.pop_back();
+        return node;
+      }
+      return fixed_[--size_];
+    }
+    bool empty() const { return size_ == 0 && overflow_.empty(); }
+
+  private:
+    static constexpr int fixed_size = 64;
+    int32_t fixed_[fixed_size];
+    int size_{0};
+    std::vector<int32_t> overflow_{};
+  };
+  template <typename Test, typename F>
+  void traverse(Test test, F callback) const {
+    Stack stack{};
+    if (root_ != null_node) {
+      stack.push(root_);
+    }
+    while (!stack.empty()) {
+      const Node &node = nodes_[stack.pop()];
+      if (!test(node.box)) {
+        continue;
+      }
+      if (node.is_leaf()) {
+        if (!callback(node.entity)) {
+          return;
+        }
+      } else {
+        stack.push(node.left);
+        stack.push(node.right);
+      }
+    }
+  }
+  int32_t allocate_node();
+  void free_node(int32_t node);
+  void insert_leaf(int32_t leaf);
+  void remove_leaf(int32_t leaf);
+  void refit(int32_t node);
+  int32_t balance(int32_t node);
+  int32_t build_range(int32_t *leaves, int32_t count);
+  std::vector<Node> nodes_{};     /**< Every node, including free nodes.*/
+  int32_t root_{null_node};       /**< The root node.*/
+  int32_t free_list_{null_node};  /**< The first free node.*/
+  size_t leaf_count_{0};          /**< The number of leaves.*/
+  float margin_;                  /**< The margin of the fat AABBs.*/
+};
+
+} // namespace mare
+
+#endif
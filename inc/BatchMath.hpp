@@ -0,0 +1,132 @@
+#ifndef BATCHMATH
+#define BATCHMATH
+
+// Standard Library
+#include <cstddef>
+#include <cstdint>
+
+// External Libraries
+#include "glm.hpp"
+#include "gtc/quaternion.hpp"
+
+namespace mare {
+
+/**
+ * @brief Matrix and vector kernels that process whole arrays of Transforms at
+ * once.
+ * @details Each kernel has an AVX2, an SSE and a scalar implementation. The
+ * fastest one the CPU supports is selected at runtime the first time any
+ * kernel is called. Unless stated otherwise the output array of a kernel may
+ * be the same array as one of its inputs, but must not partially overlap it.
+ */
+namespace batch {
+
+/**
+ * @brief The instruction sets the kernels are implemented with.
+ */
+enum class InstructionSet {
+  SCALAR, /**< Plain C++ with glm.*/
+  SSE,    /**< 128-bit SSE2.*/
+  AVX2    /**< 256-bit AVX2 with FMA, matrix products only. The other kernels
+             use SSE.*/
+};
+
+/**
+ * @brief Get the instruction set the kernels are currently using.
+ *
+ * @return The InstructionSet.
+ */
+InstructionSet get_instruction_set();
+/**
+ * @brief Use a different instruction set, for example to compare against the
+ * scalar kernels.
+ * @details Instruction sets the CPU does not support fall back to the best
+ * supported one below them. Must not be called while kernels are running.
+ *
+ * @param instruction_set The InstructionSet to use.
+ * @return The InstructionSet that is now in use.
+ */
+InstructionSet set_instruction_set(InstructionSet instruction_set);
+/**
+ * @brief Multiply two arrays of matrices element by element.
+ * @details out[i] = a[i] * b[i]
+ *
+ * @param a The left hand matrices.
+ * @param b The right hand matrices.
+ * @param out The products.
+ * @param count The number of matrices.
+ */
+void multiply(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *out,
+              size_t count);
+/**
+ * @brief Multiply one parent matrix with an array of local matrices.
+ * @details out[i] = parent * locals[i]
+ *
+ * @param parent The parent matrix.
+ * @param locals The local matrices.
+ * @param out The products.
+ * @param count The number of local matrices.
+ */
+void multiply(const glm::mat4 &parent, const glm::mat4 *locals,
+              glm::mat4 *out, size_t count);
+/**
+ * @brief Compose the local matrices of a hierarchy with the world matrices of
+ * their parents.
+ * @details For each index i in \p indices, in order:
+ * worlds[i] = worlds[parents[i]] * locals[i]. Indices must be sorted so every
+ * parent is updated before its children.
+ *
+ * @param worlds The world matrices of the hierarchy, read and written.
+ * @param locals The local matrices of the hierarchy.
+ * @param parents The index of the parent of each node.
+ * @param indices The nodes to update.
+ * @param count The number of indices.
+ */
+void multiply_parents(glm::mat4 *worlds, const glm::mat4 *locals,
+                      const int32_t *parents, const uint32_t *indices,
+                      size_t count);
+/**
+ * @brief Compose matrices from positions, rotations and scales.
+ * @details out[i] = T(positions[i]) * R(rotations[i]) * S(scales[i]). This
+ * kernel is scalar on every instruction set.
+ *
+ * @param positions The positions.
+ * @param rotations The unit rotation quaternions.
+ * @param scales The scales.
+ * @param out The composed matrices.
+ * @param count The number of matrices.
+ */
+void compose(const glm::vec3 *positions, const glm::quat *rotations,
+             const glm::vec3 *scales, glm::mat4 *out, size_t count);
+/**
+ * @brief Transform an array of points by a matrix.
+ * @details out[i] = vec3(matrix * vec4(points[i], 1))
+ *
+ * @param matrix The affine matrix to transform by.
+ * @param points The points.
+ * @param out The transformed points.
+ * @param count The number of points.
+ */
+void transform_points(const glm::mat4 &matrix, const glm::vec3 *points,
+                      glm::vec3 *out, size_t count);
+/**
+ * @brief Transform an array of axis aligned bounding boxes, each by its own
+ * matrix.
+ * @details The outputs are the smallest axis aligned boxes containing the
+ * transformed boxes.
+ *
+ * @param matrices The affine matrix of each box.
+ * @param mins The minimum corner of each box.
+ * @param maxs The maximum corner of each box.
+ * @param out_mins The minimum corner of each transformed box.
+ * @param out_maxs The maximum corner of each transformed box.
+ * @param count The number of boxes.
+ */
+void transform_aabbs(const glm::mat4 *matrices, const glm::vec3 *mins,
+                     const glm::vec3 *maxs, glm::vec3 *out_mins,
+                     glm::vec3 *out_maxs, size_t count);
+
+} // namespace batch
+} // namespace mare
+
+#endif
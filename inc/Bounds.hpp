@@ -0,0 +1,331 @@
+#ifndef BOUNDS
+#define BOUNDS
+
+// Standard Library
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+// Forward Declarations
+class Entity;
+class Mesh;
+
+/**
+ * @brief A ray with a unit direction and a length.
+ */
+struct Ray {
+  glm::vec3 origin{0.0f};                 /**< The start of the ray.*/
+  glm::vec3 direction{0.0f, 0.0f, -1.0f}; /**< The unit direction.*/
+  float length{std::numeric_limits<float>::max()}; /**< The length.*/
+  /**
+   * @brief Get a point along the ray.
+   *
+   * @param distance The distance from the origin.
+   * @return The point.
+   */
+  glm::vec3 at(float distance) const { return origin + distance * direction; }
+};
+
+/**
+ * @brief The closest intersection of a Ray with the triangles of a Scene or
+ * Layer.
+ * @see Renderer::pick()
+ */
+struct RayHit {
+  Entity *entity{nullptr};  /**< The Entity hit.*/
+  Mesh *mesh{nullptr};      /**< The SimpleMesh hit, nullptr if none.*/
+  uint32_t triangle{0};     /**< The index of the triangle in the Mesh.*/
+  glm::vec3 position{0.0f}; /**< The world space position of the hit.*/
+  float distance{
+      std::numeric_limits<float>::max()}; /**< The distance along the Ray.*/
+  /**
+   * @brief Check if anything was hit.
+   *
+   * @return true if a triangle was hit.
+   */
+  explicit operator bool() const { return mesh != nullptr; }
+};
+
+/**
+ * @brief An axis aligned bounding box.
+ * @details A default constructed AABB is empty and contains nothing. Expanding
+ * it by a point or another AABB grows it to contain them.
+ */
+struct AABB {
+  glm::vec3 min{std::numeric_limits<float>::max()}; /**< The minimum corner.*/
+  glm::vec3 max{
+      std::numeric_limits<float>::lowest()}; /**< The maximum corner.*/
+  /**
+   * @brief Check if the AABB contains nothing.
+   *
+   * @return true if the AABB is empty.
+   */
+  bool empty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+  /**
+   * @brief Grow the AABB to contain a point.
+   *
+   * @param point The point.
+   */
+  void expand(glm::vec3 point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+  /**
+   * @brief Grow the AABB to contain another AABB.
+   *
+   * @param other The other AABB.
+   */
+  void expand(const AABB &other) {
+    if (!other.empty()) {
+      min = glm::min(min, other.min);
+      max = glm::max(max, other.max);
+    }
+  }
+  /**
+   * @brief Get the center of the AABB.
+   *
+   * @return The center.
+   */
+  glm::vec3 center() const { return 0.5f * (min + max); }
+  /**
+   * @brief Get the half size of the AABB along each axis.
+   *
+   * @return The half size.
+   */
+  glm::vec3 extent() const { return 0.5f * (max - min); }
+  /**
+   * @brief Get the surface area of the AABB.
+   *
+   * @return The surface area, 0 if the AABB is empty.
+   */
+  float area() const {
+    if (empty()) {
+      return 0.0f;
+    }
+    glm::vec3 size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+  /**
+   * @brief Check if the AABB completely contains another AABB.
+   *
+   * @param other The other AABB.
+   * @return true if \p other is inside this AABB.
+   */
+  bool contains(const AABB &other) const {
+    return min.x <= other.min.x && min.y <= other.min.y &&
+           min.z <= other.min.z && other.max.x <= max.x &&
+           other.max.y <= max.y && other.max.z <= max.z;
+  }
+  /**
+   * @brief Check if the AABB overlaps another AABB.
+   *
+   * @param other The other AABB.
+   * @return true if the AABBs overlap.
+   */
+  bool overlaps(const AABB &other) const {
+    return min.x <= other.max.x && other.min.x <= max.x &&
+           min.y <= other.max.y && other.min.y <= max.y &&
+           min.z <= other.max.z && other.min.z <= max.z;
+  }
+  /**
+   * @brief Check if the AABB overlaps a sphere.
+   *
+   * @param center The center of the sphere.
+   * @param radius The radius of the sphere.
+   * @return true if the AABB and the sphere overlap.
+   */
+  bool overlaps(glm::vec3 center, float radius) const {
+    glm::vec3 closest = glm::clamp(center, min, max);
+    glm::vec3 offset = closest - center;
+    return glm::dot(offset, offset) <= radius * radius;
+  }
+  /**
+   * @brief Intersect a ray with the AABB.
+   *
+   * @param origin The origin of the ray.
+   * @param inverse_direction One divided by each component of the direction
+   * of the ray.
+   * @param max_distance The length of the ray in units of the direction.
+   * @param distance Set to the distance along the ray where it enters the
+   * AABB, 0 if the origin is inside.
+   * @return true if the ray hits the AABB within \p max_distance.
+   */
+  bool intersects(glm::vec3 origin, glm::vec3 inverse_direction,
+                  float max_distance, float &distance) const {
+    float enter = 0.0f;
+    float exit = max_distance;
+    for (int i = 0; i < 3; i++) {
+      float t0 = (min[i] - origin[i]) * inverse_direction[i];
+      float t1 = (max[i] - origin[i]) * inverse_direction[i];
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+      // NaN from 0 * inf keeps the current interval
+      enter = t0 > enter ? t0 : enter;
+      exit = t1 < exit ? t1 : exit;
+      if (enter > exit) {
+        return false;
+      }
+    }
+    distance = enter;
+    return true;
+  }
+  /**
+   * @brief Get the smallest AABB containing this AABB transformed by an affine
+   * matrix.
+   *
+   * @param matrix The affine matrix.
+   * @return The transformed AABB. Empty if this AABB is empty.
+   */
+  AABB transformed(const glm::mat4 &matrix) const {
+    if (empty()) {
+      return *this;
+    }
+    glm::vec3 world_center = glm::vec3(matrix * glm::vec4(center(), 1.0f));
+    glm::vec3 half = extent();
+    glm::vec3 world_extent{0.0f};
+    for (int i = 0; i < 3; i++) {
+      world_extent += glm::abs(glm::vec3(matrix[i])) * half[i];
+    }
+    return {world_center - world_extent, world_center + world_extent};
+  }
+};
+
+/**
+ * @brief A bounding sphere.
+ * @details A default constructed BoundingSphere has a negative radius and is
+ * empty.
+ */
+struct BoundingSphere {
+  glm::vec3 center{0.0f}; /**< The center of the sphere.*/
+  float radius{-1.0f};    /**< The radius of the sphere.*/
+  /**
+   * @brief Check if the BoundingSphere contains nothing.
+   *
+   * @return true if the BoundingSphere is empty.
+   */
+  bool empty() const { return radius < 0.0f; }
+  /**
+   * @brief Get a sphere containing this sphere transformed by an affine
+   * matrix.
+   * @details The radius is scaled by the largest scale of the matrix.
+   *
+   * @param matrix The affine matrix.
+   * @return The transformed BoundingSphere. Empty if this sphere is empty.
+   */
+  BoundingSphere transformed(const glm::mat4 &matrix) const {
+    if (empty()) {
+      return *this;
+    }
+    float scale = std::max({glm::length(glm::vec3(matrix[0])),
+                            glm::length(glm::vec3(matrix[1])),
+                            glm::length(glm::vec3(matrix[2]))});
+    return {glm::vec3(matrix * glm::vec4(center, 1.0f)), radius * scale};
+  }
+};
+
+/**
+ * @brief The six planes of a view frustum.
+ * @details The planes are extracted from a projection * view matrix and point
+ * inwards, so a point is inside the frustum if it is in front of every plane.
+ * @see Camera::get_frustum()
+ */
+class Frustum {
+public:
+  /**
+   * @brief Construct a Frustum that contains everything.
+   */
+  Frustum() {
+    for (auto &plane : planes_) {
+      plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+  }
+  /**
+   * @brief Construct the Frustum of a projection * view matrix.
+   *
+   * @param view_projection The projection matrix multiplied by the view
+   * matrix.
+   */
+  Frustum(const glm::mat4 &view_projection) {
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+      rows[i] = glm::vec4(view_projection[0][i], view_projection[1][i],
+                          view_projection[2][i], view_projection[3][i]);
+    }
+    // left, right, bottom, top, near, far
+    for (int i = 0; i < 3; i++) {
+      planes_[2 * i] = rows[3] + rows[i];
+      planes_[2 * i + 1] = rows[3] - rows[i];
+    }
+    for (auto &plane : planes_) {
+      float length = glm::length(glm::vec3(plane));
+      if (length > 0.0f) {
+        plane /= length;
+      }
+    }
+  }
+  /**
+   * @brief Check if an AABB is at least partially inside the Frustum.
+   * @details Conservative, boxes near the corners of the Frustum may be
+   * reported as inside. Empty boxes are always inside.
+   *
+   * @param box The AABB in the same space as the Frustum.
+   * @return true if the box may be visible.
+   */
+  bool intersects(const AABB &box) const {
+    if (box.empty()) {
+      return true;
+    }
+    for (const auto &plane : planes_) {
+      // the corner of the box furthest along the plane normal
+      glm::vec3 corner{plane.x >= 0.0f ? box.max.x : box.min.x,
+                       plane.y >= 0.0f ? box.max.y : box.min.y,
+                       plane.z >= 0.0f ? box.max.z : box.min.z};
+      if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /**
+   * @brief Check if a BoundingSphere is at least partially inside the Frustum.
+   * @details Empty spheres are always inside.
+   *
+   * @param sphere The BoundingSphere in the same space as the Frustum.
+   * @return true if the sphere may be visible.
+   */
+  bool intersects(const BoundingSphere &sphere) const {
+    if (sphere.empty()) {
+      return true;
+    }
+    for (const auto &plane : planes_) {
+      if (glm::dot(glm::vec3(plane), sphere.center) + plane.w <
+          -sphere.radius) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /**
+   * @brief Get a plane of the Frustum.
+   *
+   * @param i The index of the plane in the order left, right, bottom, top,
+   * near, far.
+   * @return The plane as (normal, distance).
+   */
+  const glm::vec4 &get_plane(int i) const { return planes_[i]; }
+
+private:
+  glm::vec4 planes_[6]; /**< The inward facing planes.*/
+};
+
+} // namespace mare
+
+#endif
@@ -33,9 +33,13 @@ enum class BufferType {
   READ_WRITE_DOUBLE_BUFFERED, /**< Same as READ_WRITE but a back buffer is also
                                  created which can be swapped with the front
                                  buffer using IBuffer::swap_buffer().*/
-  READ_WRITE_TRIPLE_BUFFERED  /**< Same as READ_WRITE but two back buffers are
+  READ_WRITE_TRIPLE_BUFFERED, /**< Same as READ_WRITE but two back buffers are
                                    also created which can be cycled though with
                                    IBuffer::swap_buffer().*/
+  DYNAMIC /**< The buffer is not mapped. It can only be written to by the
+             client (CPU) with Buffer::flush(), which hands the data to the
+             Rendering API so it never overwrites data the GPU has yet to
+             read. Reading it back waits for the Rendering API.*/
 };
 /**
  * @brief The type of attribute used in a BufferAttribute to describe the data
@@ -227,6 +231,15 @@ public:
    * @return The unique name of the buffer generated by the Rendering API.
    */
   virtual inline uint32_t name() const { return buffer_ID_; }
+  /**
+   * @brief Get the offset in bytes of the data into the buffer named by
+   * name().
+   * @details Always 0 unless the Buffer is a view into a larger buffer, such as
+   * a Buffer stored in a GeometryHeap.
+   *
+   * @return The offset in bytes of the data.
+   */
+  virtual inline size_t offset() const { return 0; }
   /**
    * @brief Get the number of elements in the buffer. The total size in bytes
    * divided by the size in bytes of the data type used to create the buffer.
@@ -295,6 +308,20 @@ protected:
   BufferFormat format_; /**< The BufferFormat of the buffered data*/
 };
 
+/**
+ * @brief The parameters of a single indexed draw in an indirect draw Buffer.
+ * @details The layout matches the indirect commands read by the Rendering API,
+ * so a Buffer<DrawCommand> can be used to draw many Meshes at once.
+ * @see BatchedMesh
+ */
+struct DrawCommand {
+  uint32_t count;          /**< The number of indices to draw.*/
+  uint32_t instance_count; /**< The number of instances to draw.*/
+  uint32_t first_index;    /**< The first index in the Index Buffer.*/
+  int32_t base_vertex;     /**< Added to every index before fetching.*/
+  uint32_t base_instance;  /**< The first instance to draw.*/
+};
+
 /**
  * @brief A template class for storing data in a Buffer managed by the Rendering
  * API.
@@ -417,6 +444,19 @@ public:
    * @return <T> The data read from the buffer at the provided index.
    */
   virtual T operator[](uint32_t i) const = 0;
+  /**
+   * @brief Copy data from the active buffer in the swap chain back to the
+   * client.
+   * @details Works for every BufferType, including BufferType::STATIC. Reading
+   * a Buffer that is not mapped for reading waits for the Rendering API, so
+   * this is meant for one-off reads such as computing Mesh bounds.
+   *
+   * @param data A pointer to allocated memory at least \p size_in_bytes large.
+   * @param offset_index The index into the buffer to start reading from.
+   * @param size_in_bytes The size in bytes of the data to read.
+   */
+  virtual void read(T *data, uint32_t offset_index,
+                    size_t size_in_bytes) const = 0;
   /**
    * @brief Clear the entire Buffer to a uniform value.
    *
@@ -442,6 +482,8 @@ enum class TextureType {
              point numbers.*/
   RGBA32F, /**< The Texture data is formated as four channel 32-bit floating
               point numbers.*/
+  R32UI,   /**< The Texture data is formated as single channel 32-bit unsigned
+              integers. Used for the Entity ID pass.*/
   DEPTH    /**< The Texture data is formated as single channel 32-bit floating
               point numbers. And used to create textures of the depth values from a
               Framebuffer.*/
@@ -534,8 +576,10 @@ public:
    *
    * @param width The width in pixels of the Framebuffer.
    * @param height The height in pixels of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
    */
-  Framebuffer(int width, int height) {}
+  Framebuffer(int width, int height,
+              TextureType color_type = TextureType::RGBA32F) {}
   /**
    * @brief Virtual destructor of the Framebuffer object
    *
@@ -0,0 +1,163 @@
+#ifndef COMMANDS
+#define COMMANDS
+
+// MARE
+#include "Mare.hpp"
+#include "Scene.hpp"
+
+// Standard Library
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief A buffer of deferred structural changes to the active Scene.
+ * @details Spawning and destroying Entities, attaching and detaching Systems
+ * and pushing and pulling Layers can be recorded from anywhere, including the
+ * physics Systems running on the JobSystem. Recording is thread safe. The
+ * Renderer applies every recorded command in recording order at a single sync
+ * point at the start of each frame, before any System runs, and then removes
+ * everything that was pulled in one pass. Commands recorded while the buffer
+ * is being applied are applied at the next sync point.
+ *
+ * The Entities, Layers and Scenes a command refers to must stay alive until
+ * the command is applied. Objects constructed by a command are constructed on
+ * the render thread, so their constructors may create Renderer resources.
+ * @see Renderer::commands()
+ */
+class CommandBuffer {
+public:
+  /**
+   * @brief Record the generation of an Entity on a Layer's Entity stack.
+   *
+   * @tparam <T> The type of Entity. <T> must be an Entity.
+   * @tparam <Args> The type of the arguments for the Contructor of the Entity.
+   * @param layer The Layer to generate the Entity on.
+   * @param args The arguments for the Constructor of the Entity.
+   * @see Layer::spawn_entity()
+   */
+  template <typename T, typename... Args>
+  void spawn_entity(Layer *layer, Args... args) {
+    record([=]() { layer->spawn_entity<T>(args...); });
+  }
+  /**
+   * @brief Record the removal of an Entity from a Layer's Entity stack.
+   *
+   * @param layer The Layer the Entity is on.
+   * @param handle The EntityHandle of the Entity.
+   * @see Layer::destroy_entity()
+   */
+  void destroy_entity(Layer *layer, EntityHandle handle) {
+    record([=]() { layer->destroy_entity(handle); });
+  }
+  /**
+   * @brief Record the removal of an Entity from a Layer's Entity stack.
+   *
+   * @param layer The Layer the Entity is on.
+   * @param entity A pointer to the Entity.
+   * @see Layer::pull_entity()
+   */
+  void destroy_entity(Layer *layer, Entity *entity) {
+    record([=]() { layer->pull_entity(entity); });
+  }
+  /**
+   * @brief Record the generation of a System on an Entity's System stack.
+   *
+   * @tparam <T> The type of System. <T> must be a System.
+   * @tparam <Args> The type of the arguments for the Contructor of the System.
+   * @param entity The Entity to attach the System to.
+   * @param args The arguments for the Constructor of the System.
+   * @see Entity::gen_system()
+   */
+  template <typename T, typename... Args>
+  void attach_system(Entity *entity, Args... args) {
+    record([=]() { entity->gen_system<T>(args...); });
+  }
+  /**
+   * @brief Record pushing an existing Referenced System onto an Entity's
+   * System stack.
+   *
+   * @param entity The Entity to attach the System to.
+   * @param system The Referenced System.
+   * @see Entity::push_system()
+   */
+  void attach_system(Entity *entity, Referenced<System> system) {
+    record([=]() { entity->push_system(system); });
+  }
+  /**
+   * @brief Record the removal of a System from an Entity's System stack.
+   *
+   * @param entity The Entity the System is attached to.
+   * @param system A pointer to the System.
+   * @see Entity::pull_system()
+   */
+  void detach_system(Entity *entity, System *system) {
+    record([=]() { entity->pull_system(system); });
+  }
+  /**
+   * @brief Record pushing an existing Referenced Layer onto a Scene's Layer
+   * stack.
+   *
+   * @param scene The Scene.
+   * @param layer The Referenced Layer.
+   * @see Scene::push_layer()
+   */
+  void push_layer(Scene *scene, Referenced<Layer> layer) {
+    record([=]() { scene->push_layer(layer); });
+  }
+  /**
+   * @brief Record the removal of a Layer from a Scene's Layer stack.
+   *
+   * @param scene The Scene.
+   * @param layer A pointer to the Layer.
+   * @see Scene::pull_layer()
+   */
+  void pull_layer(Scene *scene, Layer *layer) {
+    record([=]() { scene->pull_layer<Layer>(layer); });
+  }
+  /**
+   * @brief Record an arbitrary structural change.
+   *
+   * @param command The function to call at the sync point.
+   */
+  void record(std::function<void()> command) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.push_back(std::move(command));
+    pending_.store(true, std::memory_order_release);
+  }
+  /**
+   * @brief Check if any commands are waiting to be applied.
+   *
+   * @return true if the buffer is empty.
+   */
+  bool empty() const { return !pending_.load(std::memory_order_acquire); }
+  /**
+   * @brief Apply and clear every recorded command in recording order.
+   * @details Called by the Renderer at the sync point on the render thread.
+   */
+  void apply() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::swap(commands_, applying_);
+      pending_.store(false, std::memory_order_release);
+    }
+    for (auto &command : applying_) {
+      command();
+    }
+    applying_.clear();
+  }
+
+private:
+  std::vector<std::function<void()>> commands_{}; /**< Recorded commands.*/
+  std::vector<std::function<void()>> applying_{}; /**< Commands being
+                                                     applied.*/
+  std::atomic<bool> pending_{false}; /**< Any commands recorded?*/
+  std::mutex mutex_{};
+};
+
+} // namespace mare
+
+#endif
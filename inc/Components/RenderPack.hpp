@@ -12,14 +12,58 @@
 #include <vector>
 
 namespace mare {
+/**
+ * @brief A single *Render Packet* stored as a plain component of an
+ * ArchetypeStore.
+ * @details Entities in an ArchetypeStore with a Transform and a MeshPacket are
+ * drawn by a BatchPacketRenderer attached to the Layer that owns the store.
+ * @see BatchPacketRenderer
+ */
+struct MeshPacket {
+  Referenced<Mesh> mesh{nullptr};         /**< The Mesh to render.*/
+  Referenced<Material> material{nullptr}; /**< The Material to render with.*/
+};
+
 /**
  * @brief A Component that renders *Render Packets*.
  * @details A RenderPack contains pairs of Referenced Mesh-Material pairs called
  * *Render Packets* which are rendered each frame. Any Entity that inherits from
  * RenderPack can push Render Packets to the Component which will render them.
+ *
+ * Pushing and pulling Packets marks the bounds of the Entity dirty in its
+ * Layer's SpatialIndex, and so does changing a Mesh on the Packet stack.
+ * @see Entity::mark_bounds_dirty()
  */
 class RenderPack : virtual public Entity {
 public:
+  /**
+   * @brief Destroy the RenderPack object and unregister it from the Meshes on
+   * its Packet stack.
+   */
+  virtual ~RenderPack() {
+    for (auto &packet : packets_) {
+      packet.first->remove_owner(this);
+    }
+  }
+  /**
+   * @brief Get the bounding box of every Packet on the Packet stack.
+   * @details Combines the bounds of each Mesh transformed by its own Transform.
+   *
+   * @return The AABB of the Packets. Empty if a Mesh has empty bounds, since
+   * the Entity could then be anywhere.
+   */
+  AABB get_bounds() override {
+    AABB bounds{};
+    for (auto &packet : packets_) {
+      Mesh *mesh = packet.first.get();
+      const AABB &box = mesh->get_aabb();
+      if (box.empty()) {
+        return AABB{};
+      }
+      bounds.expand(box.transformed(mesh->get_transformation_matrix()));
+    }
+    return bounds;
+  }
   /**
    * @brief Get a pointer to the first Packet of type <T,U> in the Entity's
    * Packet stack.
@@ -69,7 +113,9 @@ public:
    * @param packet The Packet to push.
    */
   void push_packet(std::pair<Referenced<Mesh>, Referenced<Material>> packet) {
+    packet.first->add_owner(this);
     packets_.push_back(packet);
+    mark_bounds_dirty();
   }
   /**
    * @brief Push a `std::vector` of existing Packets onto the Packet stack.
@@ -79,8 +125,10 @@ public:
   void push_packets(
       std::vector<std::pair<Referenced<Mesh>, Referenced<Material>>> packets) {
     for (size_t i = 0; i < packets.size(); i++) {
+      packets[i].first->add_owner(this);
       packets_.push_back(packets[i]);
     }
+    mark_bounds_dirty();
   }
   /**
    * @brief Remove the first Packet of type <T,U> from the Packet stack and
@@ -97,7 +145,9 @@ public:
         if (auto material = std::dynamic_pointer_cast<U>((*pack_it).second)) {
           std::pair<Referenced<T>, Referenced<U>> pulled_packet =
               std::pair<Referenced<T>, Referenced<U>>{mesh, material};
+          mesh->remove_owner(this);
           packets_.erase(pack_it);
+          mark_bounds_dirty();
           return pulled_packet;
         }
       }
@@ -124,9 +174,10 @@ public:
               std::pair<Referenced<T>, Referenced<U>>{mesh, material};
           packets.push_back(pulled_packet);
           rm.push_back(i);
-          i++;
+          mesh->remove_owner(this);
         }
       }
+      i++;
     }
     // remove all pulled packets
     size_t rm_index = 0;
@@ -140,6 +191,9 @@ public:
                                     return false;
                                   }),
                    std::end(packets_));
+    if (!packets.empty()) {
+      mark_bounds_dirty();
+    }
     return packets;
   }
 
@@ -9,14 +9,43 @@
 
 namespace mare {
 /**
- * @brief A Rigidbody Component that provides Rigidbody properties.
+ * @brief The plain data of a Rigidbody.
+ * @details Also used directly as a component of an ArchetypeStore together
+ * with a Transform.
+ * @see ArchetypeStore
  */
-class Rigidbody : virtual public Entity {
-public:
+struct RigidbodyState {
   glm::vec3 linear_velocity{};  /**< The linear velocity of the body.*/
   glm::vec3 angular_velocity{}; /**< The angular velocity of the body.*/
   glm::vec3 force{};            /**< The linear force acting on the body.*/
   glm::vec3 torque{};           /**< The angular force acting on the body.*/
+  glm::vec3 previous_position{}; /**< The position before the last physics
+                                    step, written by the Renderer.*/
+  bool previous_stored{false}; /**< Has a fixed physics step stored
+                                  previous_position yet?*/
+};
+
+/**
+ * @brief A Rigidbody Component that provides Rigidbody properties.
+ */
+class Rigidbody : virtual public Entity, public RigidbodyState {
+public:
+  /**
+   * @brief Get the position of the body interpolated between the last two
+   * physics steps.
+   * @details Used to render smoothly when physics runs at a fixed timestep.
+   * A body that has not been stepped yet is at its current position.
+   *
+   * @param alpha The interpolation factor, usually
+   * RendererInfo::interpolation_alpha.
+   * @return The interpolated position.
+   */
+  glm::vec3 get_interpolated_position(float alpha) const {
+    if (!previous_stored) {
+      return get_position();
+    }
+    return glm::mix(previous_position, get_position(), alpha);
+  }
 };
 } // namespace mare
 
@@ -0,0 +1,308 @@
+#ifndef TRSTRANSFORM
+#define TRSTRANSFORM
+
+// MARE
+#include "Components/Transform.hpp"
+#include "Mare.hpp"
+
+// Standard Library
+#include <cstdint>
+
+// External Libraries
+#include "glm.hpp"
+#include "gtc/quaternion.hpp"
+
+namespace mare {
+/**
+ * @brief A Transform stored as a separate position, rotation quaternion and
+ * scale.
+ * @details TRSTransform has the same interface as Transform but never has to
+ * decompose a matrix. Rotating, scaling and facing a point only change the
+ * component involved, and the forward, right and up vectors are read directly
+ * from the quaternion. The transformation matrix, its inverse (the view
+ * matrix) and the normal matrix are built on first read after a change and
+ * cached, and the inverse and normal matrix are built from the components
+ * instead of with a general matrix inverse.
+ *
+ * Use it wherever a Transform is stored by value and changed often, such as
+ * components in an ArchetypeStore. Every Camera keeps its pose in one, so
+ * camera controls and the view matrix never decompose or invert a matrix.
+ * get_transform() returns an equivalent Transform for APIs that take one.
+ * @see Transform
+ */
+class TRSTransform {
+public:
+  /**
+   * @brief Construct a new TRSTransform at the origin with no rotation and a
+   * scale of 1.
+   */
+  TRSTransform() {}
+  /**
+   * @brief Construct a new TRSTransform from a TRS matrix.
+   *
+   * @param transform_matrix The matrix to decompose.
+   */
+  TRSTransform(glm::mat4 transform_matrix) {
+    set_transformation_matrix(transform_matrix);
+  }
+  /**
+   * @brief Construct a new TRSTransform from a Transform.
+   *
+   * @param transform The Transform to decompose.
+   */
+  TRSTransform(Transform transform)
+      : TRSTransform(transform.get_transformation_matrix()) {}
+  /**
+   * @brief Get the position of the Transform.
+   *
+   * @return The position.
+   */
+  glm::vec3 get_position() const { return position_; }
+  /**
+   * @brief Get the rotation of the Transform.
+   *
+   * @return The rotation quaternion.
+   */
+  glm::quat get_rotation() const { return rotation_; }
+  /**
+   * @brief Get the scale of the Transform.
+   *
+   * @return The scale.
+   */
+  glm::vec3 get_scale() const { return scale_; }
+  /**
+   * @brief Get the translation matrix of the Transform.
+   *
+   * @return The translation matrix
+   */
+  glm::mat4 get_translation_matrix() const {
+    return glm::translate(glm::mat4(1.0f), position_);
+  }
+  /**
+   * @brief Get the rotation matrix of the Transform.
+   *
+   * @return The rotation matrix
+   */
+  glm::mat4 get_rotation_matrix() const { return glm::mat4_cast(rotation_); }
+  /**
+   * @brief Get the scale matrix of the Transform.
+   *
+   * @return The scale matrix.
+   */
+  glm::mat4 get_scale_matrix() const {
+    return glm::scale(glm::mat4(1.0f), scale_);
+  }
+  /**
+   * @brief Get the transformation matrix.
+   *
+   * @return The cached transformation matrix.
+   */
+  glm::mat4 get_transformation_matrix() const {
+    update_matrix();
+    return transform_.get_transformation_matrix();
+  }
+  /**
+   * @brief Get an equivalent Transform.
+   *
+   * @return A pointer to the cached Transform, valid until the TRSTransform is
+   * changed or destroyed.
+   */
+  Transform *get_transform() const {
+    update_matrix();
+    return &transform_;
+  }
+  /**
+   * @brief Set the transformation matrix of the Transform
+   * @details The matrix is decomposed into position, rotation and scale. The
+   * matrix must not contain shear.
+   *
+   * @param transformation_matrix The matrix to set.
+   */
+  void set_transformation_matrix(glm::mat4 transformation_matrix) {
+    position_ = glm::vec3(transformation_matrix[3]);
+    scale_ = glm::vec3(glm::length(glm::vec3(transformation_matrix[0])),
+                       glm::length(glm::vec3(transformation_matrix[1])),
+                       glm::length(glm::vec3(transformation_matrix[2])));
+    glm::mat3 rotation(1.0f);
+    for (int i = 0; i < 3; i++) {
+      if (scale_[i] != 0.0f) {
+        rotation[i] = glm::vec3(transformation_matrix[i]) / scale_[i];
+      }
+    }
+    rotation_ = glm::normalize(glm::quat_cast(rotation));
+    changed();
+  }
+  /**
+   * @brief Get the normal matrix of the Transform used to transform normals in
+   * shaders.
+   *
+   * @return The cached normal matrix.
+   */
+  const glm::mat3 &get_normal_matrix() const {
+    if (dirty_ & NORMAL_DIRTY) {
+      // transpose(inverse(R * S)) = R * inverse(S)
+      glm::mat3 rotation = glm::mat3_cast(rotation_);
+      for (int i = 0; i < 3; i++) {
+        normal_matrix_[i] = rotation[i] * inverse_scale(i);
+      }
+      dirty_ &= ~NORMAL_DIRTY;
+    }
+    return normal_matrix_;
+  }
+  /**
+   * @brief Get the view matrix of the Transform used by Cameras.
+   *
+   * @return The cached inverse of the transformation matrix.
+   */
+  const glm::mat4 &get_view_matrix() const {
+    if (dirty_ & INVERSE_DIRTY) {
+      // inverse(T * R * S) = inverse(S) * transpose(R) * inverse(T)
+      glm::mat3 inverse_rotation = glm::mat3_cast(glm::conjugate(rotation_));
+      glm::mat3 upper{};
+      for (int i = 0; i < 3; i++) {
+        upper[i] = inverse_rotation[i] * glm::vec3(inverse_scale(0),
+                                                   inverse_scale(1),
+                                                   inverse_scale(2));
+      }
+      view_matrix_ = glm::mat4(upper);
+      view_matrix_[3] = glm::vec4(-(upper * position_), 1.0f);
+      dirty_ &= ~INVERSE_DIRTY;
+    }
+    return view_matrix_;
+  }
+  /**
+   * @brief Face the Transform towards a point in space and orient it such that
+   * the horizontal plane is level.
+   *
+   * @param point The point in space to face towards.
+   * @param normal_vector The normal vector for the horizontal plane.
+   */
+  void face_towards(glm::vec3 point, glm::vec3 normal_vector) {
+    glm::vec3 forward = glm::normalize(point - position_);
+    glm::vec3 right = glm::normalize(glm::cross(forward, normal_vector));
+    glm::vec3 up = glm::cross(right, forward);
+    rotation_ = glm::normalize(glm::quat_cast(glm::mat3(right, up, -forward)));
+    changed();
+  }
+  /**
+   * @brief Translate the transform by an offsetting 3D vector.
+   *
+   * @param offset The 3D vector to translate by.
+   */
+  void translate(glm::vec3 offset) {
+    position_ += offset;
+    changed();
+  }
+  /**
+   * @brief Set the position of the Transform.
+   *
+   * @param position The position to set.
+   */
+  void set_position(glm::vec3 position) {
+    position_ = position;
+    changed();
+  }
+  /**
+   * @brief Rotate the Transform from its current rotation by an angle about an
+   * axis.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void rotate(glm::vec3 axis, float angle) {
+    rotation_ =
+        glm::normalize(glm::angleAxis(angle, glm::normalize(axis)) * rotation_);
+    changed();
+  }
+  /**
+   * @brief Set the rotation of the Transform.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void set_rotation(glm::vec3 axis, float angle) {
+    rotation_ = glm::angleAxis(angle, glm::normalize(axis));
+    changed();
+  }
+  /**
+   * @brief Set the rotation of the Transform.
+   *
+   * @param rotation The rotation quaternion to set.
+   */
+  void set_rotation(glm::quat rotation) {
+    rotation_ = glm::normalize(rotation);
+    changed();
+  }
+  void set_rotation_matrix(glm::mat4 rotation_matrix) {
+    rotation_ = glm::normalize(glm::quat_cast(glm::mat3(rotation_matrix)));
+    changed();
+  }
+  /**
+   * @brief Set the scale of the Transform
+   *
+   * @param scale The scale to set.
+   */
+  void set_scale(glm::vec3 scale) {
+    scale_ = scale;
+    changed();
+  }
+  /**
+   * @brief Get the forward vector of the Transform.
+   *
+   * @return The forward vector.
+   */
+  glm::vec3 get_forward_vector() const {
+    return rotation_ * glm::vec3(0.0f, 0.0f, -1.0f);
+  }
+  /**
+   * @brief Get the right vector of the Transform.
+   *
+   * @return The right vector.
+   */
+  glm::vec3 get_right_vector() const {
+    return rotation_ * glm::vec3(1.0f, 0.0f, 0.0f);
+  }
+  /**
+   * @brief Get the up vector of the Transform.
+   *
+   * @return The up vector.
+   */
+  glm::vec3 get_up_vector() const {
+    return rotation_ * glm::vec3(0.0f, 1.0f, 0.0f);
+  }
+
+private:
+  enum : uint8_t {
+    MATRIX_DIRTY = 1 << 0,
+    INVERSE_DIRTY = 1 << 1,
+    NORMAL_DIRTY = 1 << 2,
+    ALL_DIRTY = MATRIX_DIRTY | INVERSE_DIRTY | NORMAL_DIRTY
+  };
+  void changed() { dirty_ = ALL_DIRTY; }
+  void update_matrix() const {
+    if (dirty_ & MATRIX_DIRTY) {
+      glm::mat3 rotation = glm::mat3_cast(rotation_);
+      glm::mat4 matrix(1.0f);
+      for (int i = 0; i < 3; i++) {
+        matrix[i] = glm::vec4(rotation[i] * scale_[i], 0.0f);
+      }
+      matrix[3] = glm::vec4(position_, 1.0f);
+      transform_.set_transformation_matrix(matrix);
+      dirty_ &= ~MATRIX_DIRTY;
+    }
+  }
+  float inverse_scale(int i) const {
+    return scale_[i] != 0.0f ? 1.0f / scale_[i] : 0.0f;
+  }
+  glm::vec3 position_{0.0f};                  /**< The position.*/
+  glm::quat rotation_{1.0f, 0.0f, 0.0f, 0.0f}; /**< The rotation.*/
+  glm::vec3 scale_{1.0f};                     /**< The scale.*/
+  mutable Transform transform_{};             /**< The cached matrix.*/
+  mutable glm::mat4 view_matrix_{1.0f};       /**< The cached inverse.*/
+  mutable glm::mat3 normal_matrix_{1.0f};     /**< The cached normal matrix.*/
+  mutable uint8_t dirty_{ALL_DIRTY};          /**< Caches to rebuild.*/
+};
+
+} // namespace mare
+
+#endif
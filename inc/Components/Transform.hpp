@@ -134,8 +134,14 @@ public:
    * @param normal_vector The normal vector for the horizontal plane.
    */
   void face_towards(glm::vec3 point, glm::vec3 normal_vector) {
-    glm::mat4 view = glm::lookAt(get_position(), point, normal_vector);
-    transformation_matrix_ = glm::inverse(view) * get_scale_matrix();
+    // Build the inverse of the look at matrix directly from its basis
+    glm::vec3 scale = get_scale();
+    glm::vec3 forward = glm::normalize(point - get_position());
+    glm::vec3 right = glm::normalize(glm::cross(forward, normal_vector));
+    glm::vec3 up = glm::cross(right, forward);
+    transformation_matrix_[0] = glm::vec4(right * scale.x, 0.0f);
+    transformation_matrix_[1] = glm::vec4(up * scale.y, 0.0f);
+    transformation_matrix_[2] = glm::vec4(-forward * scale.z, 0.0f);
   }
   /**
    * @brief Translate the transform by an offsetting 3D vector.
@@ -165,10 +171,13 @@ public:
    * @param angle The angle to rotate by.
    */
   void rotate(glm::vec3 axis, float angle) {
-    glm::mat4 rotation =
-        glm::rotate(glm::mat4(1.0f), angle, axis) * get_rotation_matrix();
-    transformation_matrix_ =
-        get_translation_matrix() * rotation * get_scale_matrix();
+    // R * (R0 * S) only needs the scaled basis, not a decomposition
+    glm::mat3 rotation =
+        glm::mat3(glm::rotate(glm::mat4(1.0f), angle, axis)) *
+        glm::mat3(transformation_matrix_);
+    for (int i = 0; i < 3; i++) {
+      transformation_matrix_[i] = glm::vec4(rotation[i], 0.0f);
+    }
   }
   /**
    * @brief Set the rotation of the Transform.
@@ -177,13 +186,13 @@ public:
    * @param angle The angle to rotate by.
    */
   void set_rotation(glm::vec3 axis, float angle) {
-    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), angle, axis);
-    transformation_matrix_ =
-        get_translation_matrix() * rotation * get_scale_matrix();
+    set_rotation_matrix(glm::rotate(glm::mat4(1.0f), angle, axis));
   }
   void set_rotation_matrix(glm::mat4 rotation_matrix) {
-    transformation_matrix_ =
-        get_translation_matrix() * rotation_matrix * get_scale_matrix();
+    glm::vec3 scale = get_scale();
+    for (int i = 0; i < 3; i++) {
+      transformation_matrix_[i] = rotation_matrix[i] * scale[i];
+    }
   }
   /**
    * @brief Set the scale of the Transform
@@ -191,9 +200,15 @@ public:
    * @param scale The scale to set.
    */
   void set_scale(glm::vec3 scale) {
-    glm::mat4 scale_matrix = glm::scale(glm::mat4(1.0f), scale);
-    transformation_matrix_ =
-        get_translation_matrix() * get_rotation_matrix() * scale_matrix;
+    for (int i = 0; i < 3; i++) {
+      float length = glm::length(transformation_matrix_[i]);
+      if (length != 0.0f) {
+        transformation_matrix_[i] *= scale[i] / length;
+      } else {
+        transformation_matrix_[i] = glm::vec4(0.0f);
+        transformation_matrix_[i][i] = scale[i];
+      }
+    }
   }
   /**
    * @brief Get the forward vector of the Transform.
@@ -10,6 +10,7 @@
 #include "glm.hpp"
 
 // Standar Library
+#include <cmath>
 #include <variant>
 
 namespace mare {
@@ -60,7 +61,7 @@ public:
                    1.0f);
         v5 = {x, y};
       } else {
-        v5 = glm::vec2(Renderer::raycast(base_layer));
+        v5 = glm::vec2(get_cursor_position());
       }
       float bounded_area = math::shoelace({v1, v2, v3, v4});
       if (bounded_area < math::shoelace({v1, v2, v3, v4, v5})) {
@@ -103,10 +104,29 @@ public:
                          glm::vec4(x, y, 0.0f, 1.0f));
       }
       return glm::vec2(glm::inverse(get_transformation_matrix()) *
-                       glm::vec4(Renderer::raycast(base_layer), 1.0f));
+                       glm::vec4(get_cursor_position(), 1.0f));
     }
     return glm::vec2(0.0f, 0.0f);
   }
+  /**
+   * @brief Get the point under the cursor on the plane of the UIElement.
+   * @details The cursor Ray of the base Layer is intersected with the plane of
+   * the UIElement on the CPU. Renderer::raycast() reads the depth buffer
+   * instead and is only used when the Ray is parallel to the plane.
+   *
+   * @return The position of the cursor in world space.
+   */
+  glm::vec3 get_cursor_position() {
+    Ray ray = Renderer::get_cursor_ray(base_layer);
+    glm::mat4 model = get_transformation_matrix();
+    glm::vec3 normal = glm::cross(glm::vec3(model[0]), glm::vec3(model[1]));
+    float denominator = glm::dot(normal, ray.direction);
+    if (std::fabs(denominator) < 1e-6f) {
+      return Renderer::raycast(base_layer);
+    }
+    return ray.at(glm::dot(normal, glm::vec3(model[3]) - ray.origin) /
+                  denominator);
+  }
   bool is_focused() { return (Renderer::get_info().focused_element == this); }
   virtual void on_focus() {}
   virtual void on_unfocus() {}
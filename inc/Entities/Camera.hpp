@@ -2,6 +2,8 @@
 #define CAMERA
 
 // MARE
+#include "Bounds.hpp"
+#include "Components/TRSTransform.hpp"
 #include "Components/Transform.hpp"
 #include "Entity.hpp"
 #include "Renderer.hpp"
@@ -20,6 +22,21 @@ enum class ProjectionType { PERSPECTIVE, ORTHOGRAPHIC };
 // forward declare camera system
 class CameraControls;
 
+/**
+ * @brief The uniform block of a Camera shared by every Material.
+ * @details Matches the std140 "camera_properties" uniform block of the glsl
+ * shaders, which is bound at Shader::camera_binding.
+ */
+struct camera_properties {
+  glm::mat4 view;            /**< The view matrix.*/
+  glm::mat4 projection;      /**< The projection matrix.*/
+  glm::mat4 view_projection; /**< The projection matrix times the view
+                                matrix.*/
+  glm::mat4 inverse_view;    /**< The inverse of the view matrix.*/
+  glm::vec4 position;        /**< The position of the Camera in world space,
+                                w is 1.*/
+};
+
 /**
  * @brief A Camera Entity that is the base class for all Layers.
  * @details Cameras are the base class of all Layers. Since Camera's are
@@ -64,6 +81,7 @@ public:
                      -ortho_scale_, ortho_scale_, ortho_near_, ortho_far_);
       break;
     }
+    frustum_dirty_ = true;
   }
   /**
    * @brief Set the ProjectionType of the Camera.
@@ -208,8 +226,155 @@ public:
    * @return The distance to the far clip plane from the Camera.
    */
   float get_far_clip_plane_persp() const { return persp_far_; }
+  /**
+   * @brief Get the view matrix of the Camera.
+   * @details The Camera keeps its pose as a TRSTransform, so the view matrix is
+   * built from the position, rotation and scale on the first read after the
+   * Camera moves and cached, instead of inverting the transformation matrix on
+   * every call.
+   *
+   * @return The cached view matrix.
+   */
+  const glm::mat4 &get_view_matrix() { return pose().get_view_matrix(); }
+  /**
+   * @brief Get the forward vector of the Camera.
+   *
+   * @return The forward vector.
+   */
+  glm::vec3 get_forward_vector() { return pose().get_forward_vector(); }
+  /**
+   * @brief Get the right vector of the Camera.
+   *
+   * @return The right vector.
+   */
+  glm::vec3 get_right_vector() { return pose().get_right_vector(); }
+  /**
+   * @brief Get the up vector of the Camera.
+   *
+   * @return The up vector.
+   */
+  glm::vec3 get_up_vector() { return pose().get_up_vector(); }
+  /**
+   * @brief Face the Camera towards a point in space and orient it such that
+   * the horizontal plane is level.
+   *
+   * @param point The point in space to face towards.
+   * @param normal_vector The normal vector for the horizontal plane.
+   */
+  void face_towards(glm::vec3 point, glm::vec3 normal_vector) {
+    pose().face_towards(point, normal_vector);
+    store_pose();
+  }
+  /**
+   * @brief Translate the Camera by an offsetting 3D vector.
+   *
+   * @param offset The 3D vector to translate by.
+   */
+  void translate(glm::vec3 offset) {
+    pose().translate(offset);
+    store_pose();
+  }
+  /**
+   * @brief Set the position of the Camera.
+   *
+   * @param position The position to set.
+   */
+  void set_position(glm::vec3 position) {
+    pose().set_position(position);
+    store_pose();
+  }
+  /**
+   * @brief Rotate the Camera from its current rotation by an angle about an
+   * axis.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void rotate(glm::vec3 axis, float angle) {
+    pose().rotate(axis, angle);
+    store_pose();
+  }
+  /**
+   * @brief Set the rotation of the Camera.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void set_rotation(glm::vec3 axis, float angle) {
+    pose().set_rotation(axis, angle);
+    store_pose();
+  }
+  /**
+   * @brief Get the view frustum of the Camera in world space.
+   * @details The planes are cached and only rebuilt when the projection or the
+   * Camera's Transform changed since the last call.
+   *
+   * @return The cached Frustum.
+   */
+  const Frustum &get_frustum() {
+    glm::mat4 transform = get_transformation_matrix();
+    if (frustum_dirty_ || transform != frustum_transform_) {
+      frustum_ = Frustum(projection_ * get_view_matrix());
+      frustum_transform_ = transform;
+      frustum_dirty_ = false;
+    }
+    return frustum_;
+  }
+  /**
+   * @brief Get the uniform Buffer holding the camera_properties of the Camera.
+   * @details The Buffer is created on first use and written once per frame,
+   * the first time the Camera renders in that frame. Changes to the Camera
+   * after that are seen by the shaders in the next frame. The Buffer is a
+   * BufferType::DYNAMIC Buffer, so each write is an ordered sub-data upload
+   * rather than a memcpy into storage that draws of the last frame may still
+   * be reading.
+   *
+   * @param frame The frame being rendered.
+   * @return The camera_properties Buffer.
+   * @see Renderer::bind_camera(Camera*)
+   */
+  Buffer<camera_properties> *get_properties(uint64_t frame) {
+    if (!properties_) {
+      properties_ = Renderer::gen_buffer<camera_properties>(
+          nullptr, sizeof(camera_properties), BufferType::DYNAMIC);
+    } else if (frame == properties_frame_) {
+      return properties_.get();
+    }
+    camera_properties props{};
+    props.view = get_view_matrix();
+    props.projection = projection_;
+    props.view_projection = projection_ * props.view;
+    props.inverse_view = get_transformation_matrix();
+    props.position = glm::vec4(get_position(), 1.0f);
+    properties_->flush(&props, 0, sizeof(camera_properties));
+    properties_frame_ = frame;
+    return properties_.get();
+  }
 
 private:
+  /**
+   * @brief Get the pose of the Camera.
+   * @details The Camera's Transform is the matrix every other System sees. If
+   * it was changed through the Transform interface since the pose was last
+   * stored, the pose is decomposed from it again.
+   *
+   * @return The pose.
+   */
+  TRSTransform &pose() {
+    glm::mat4 transform = get_transformation_matrix();
+    if (transform != pose_transform_) {
+      pose_.set_transformation_matrix(transform);
+      pose_transform_ = transform;
+    }
+    return pose_;
+  }
+  /**
+   * @brief Write the pose back to the Camera's Transform.
+   */
+  void store_pose() {
+    pose_transform_ = pose_.get_transformation_matrix();
+    set_transformation_matrix(pose_transform_);
+  }
   glm::mat4 projection_; /**< The projection matrix of the Camera.*/
   float fovy_ = 45.0f;   /**< The vertical field of view of the Camera with type
                             ProjectionType::PERSPECTIVE.*/
@@ -226,6 +391,16 @@ private:
                  Camera using ProjectionType::PERSPECTIVE.*/
 
   ProjectionType type_; /**< The ProjectionType of the Camera.*/
+  Frustum frustum_{};   /**< The cached view frustum.*/
+  glm::mat4 frustum_transform_{
+      1.0f}; /**< The Camera Transform the frustum was built with.*/
+  bool frustum_dirty_{true}; /**< Rebuild the frustum on the next call?*/
+  Scoped<Buffer<camera_properties>>
+      properties_{}; /**< The uniform Buffer of the Camera.*/
+  uint64_t properties_frame_{0}; /**< The frame properties_ was written in.*/
+  TRSTransform pose_{}; /**< The position, rotation and scale of the Camera.*/
+  glm::mat4 pose_transform_{
+      1.0f}; /**< The Camera Transform pose_ was last synced with.*/
 };
 
 /**
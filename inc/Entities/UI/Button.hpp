@@ -112,13 +112,15 @@ private:
 template <typename T> class ButtonControls : public ControlsSystem<Button<T>> {
 public:
   bool on_mouse_button(const RendererInput &input, Button<T> *button) override {
-    if (input.LEFT_MOUSE_JUST_PRESSED && button->is_cursor_in_bounds()) {
+    if (input.event().pressed(MouseButton::LEFT) &&
+        button->is_cursor_in_bounds()) {
       UIElement::focus(button);
       button->box_material->set_color(button->box_pushed_color);
       button->label_material->set_color(button->label_pushed_color);
       return true;
     }
-    if(input.LEFT_MOUSE_JUST_RELEASED && button->is_cursor_in_bounds() && button->is_focused())
+    if (input.event().released(MouseButton::LEFT) &&
+        button->is_cursor_in_bounds() && button->is_focused())
     {
       button->box_material->set_color(button->box_color);
       button->label_material->set_color(button->label_color);
@@ -366,6 +366,7 @@ public:
   void set_alpha(float alpha) {
     if (transparency) {
       get_meshes<Mesh>()[4]->set_position({0.75f, alpha - 0.5f, 0.0f});
+      update_bounds();
     }
     color_hsva[3] = alpha;
   }
@@ -387,6 +388,7 @@ public:
     glm::vec2 picker_pos =
         math::clamp_point_to_triangle(v1, v2, v3, widget_coords);
     get_meshes<Mesh>()[2]->set_position(glm::vec3(picker_pos, 0.0f));
+    update_bounds();
     color_hsva = get_picker_hsva_color();
     set_alpha_slider_hsva_color(color_hsva);
   }
@@ -618,7 +620,8 @@ public:
    * @return false pass on event.
    */
   bool on_mouse_button(const RendererInput &input, ColorPicker *picker) {
-    if (input.LEFT_MOUSE_JUST_PRESSED && picker->is_cursor_in_bounds()) {
+    if (input.event().pressed(MouseButton::LEFT) &&
+        picker->is_cursor_in_bounds()) {
       UIElement::focus(picker);
       if (picker->is_in_color_triangle()) {
         focused_mesh = picker->mesh->get_meshes<Mesh>()[1];
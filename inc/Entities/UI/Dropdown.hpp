@@ -292,12 +292,14 @@ class DropdownControls : public ControlsSystem<Dropdown<T>> {
 public:
   bool on_mouse_button(const RendererInput &input,
                        Dropdown<T> *dropdown) override {
-    if(input.LEFT_MOUSE_JUST_PRESSED && dropdown->is_cursor_in_bounds())
+    if (input.event().pressed(MouseButton::LEFT) &&
+        dropdown->is_cursor_in_bounds())
     {
       UIElement::focus(dropdown);
       return true;
     }
-    if (input.LEFT_MOUSE_JUST_RELEASED && dropdown->is_cursor_in_bounds() &&
+    if (input.event().released(MouseButton::LEFT) &&
+        dropdown->is_cursor_in_bounds() &&
         dropdown->dropdown_list->opened == false && dropdown->is_focused()) {
       dropdown->get_layer()->push_entity(dropdown->dropdown_list);
       dropdown->dropdown_list->opened = true;
@@ -320,10 +322,10 @@ class DropdownListControls : public ControlsSystem<DropdownList<T>> {
 public:
   bool on_mouse_button(const RendererInput &input,
                        DropdownList<T> *dropdown_list) override {
-    if (input.LEFT_MOUSE_JUST_RELEASED) {
+    if (input.event().released(MouseButton::LEFT)) {
       return dropdown_list->dropdown_box->update_selection();
     }
-    if (input.LEFT_MOUSE_JUST_PRESSED &&
+    if (input.event().pressed(MouseButton::LEFT) &&
         dropdown_list->dropdown_box->is_cursor_in_list_bounds()) {
       return true;
     }
@@ -333,12 +335,12 @@ public:
   bool on_key(const RendererInput &input,
               DropdownList<T> *dropdown_list) override {
     if (dropdown_list->opened) {
-      if (input.UP_JUST_PRESSED) {
+      if (input.event().pressed(Key::UP)) {
         dropdown_list->scroll_pos =
             std::max(static_cast<int>(dropdown_list->scroll_pos) - 1, 0);
         dropdown_list->rescale();
       }
-      if (input.DOWN_JUST_PRESSED) {
+      if (input.event().pressed(Key::DOWN)) {
         dropdown_list->scroll_pos = std::min(
             dropdown_list->scroll_pos + 1,
             static_cast<unsigned int>(dropdown_list->get_value().size() -
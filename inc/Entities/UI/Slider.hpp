@@ -69,9 +69,9 @@ public:
                                        sizeof(float) * ring_indes.size());
     ring_vert_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
     ring_color_buffer->set_format({{AttributeType::COLOR, "color"}});
-    add_geometry_buffer(ring_vert_buffer);
+    add_geometry_buffer(ring_vert_buffer, ring_verts.data());
     add_geometry_buffer(ring_color_buffer);
-    set_index_buffer(ring_index_buffer);
+    set_index_buffer(ring_index_buffer, ring_indes.data());
   }
 };
 
@@ -212,7 +212,8 @@ public:
    * @return false pass on event.
    */
   bool on_mouse_button(const RendererInput &input, Slider *slider_ui) {
-    if (input.LEFT_MOUSE_JUST_PRESSED && slider_ui->is_cursor_in_bounds()) {
+    if (input.event().pressed(MouseButton::LEFT) &&
+        slider_ui->is_cursor_in_bounds()) {
       UIElement::focus(slider_ui);
       return on_mouse_move(input, slider_ui);
     }
@@ -99,7 +99,8 @@ public:
 class SwitchControls : public ControlsSystem<Switch> {
 public:
   bool on_mouse_button(const RendererInput &input, Switch *sw) override {
-    if (input.LEFT_MOUSE_JUST_PRESSED && sw->is_cursor_in_bounds()) {
+    if (input.event().pressed(MouseButton::LEFT) &&
+        sw->is_cursor_in_bounds()) {
       UIElement::focus(sw);
       return true;
     }
@@ -275,11 +275,11 @@ public:
    */
   bool on_mouse_button(const RendererInput &input, TextBox *text_box) override {
     if (text_box->is_cursor_in_bounds()) {
-      if (input.LEFT_MOUSE_JUST_PRESSED) {
+      if (input.event().pressed(MouseButton::LEFT)) {
         UIElement::focus(text_box);
         return true;
       }
-      if (text_box->is_focused() && input.LEFT_MOUSE_JUST_RELEASED) {
+      if (text_box->is_focused() && input.event().released(MouseButton::LEFT)) {
         return true;
       }
     }
@@ -299,16 +299,17 @@ public:
   bool on_key(const RendererInput &input, TextBox *text_box) override {
     if (text_box->is_focused()) {
       // Control Characters
-      if (input.BACKSPACE_PRESSED) {
+      const InputEvent &event = input.event();
+      if (event.pressed(Key::BACKSPACE) || event.repeated(Key::BACKSPACE)) {
         text_box->delete_char(-1);
       }
-      if (input.ENTER_PRESSED) {
+      if (event.pressed(Key::ENTER) || event.repeated(Key::ENTER)) {
         text_box->append_char('\n');
       }
-      if (input.LEFT_CONTROL_PRESSED && input.C_JUST_PRESSED) {
+      if (input.pressed(Key::LEFT_CONTROL) && event.pressed(Key::C)) {
         Renderer::set_clipboard_string(text_box->get_text());
       }
-      if (input.LEFT_CONTROL_PRESSED && input.V_JUST_PRESSED) {
+      if (input.pressed(Key::LEFT_CONTROL) && event.pressed(Key::V)) {
         text_box->set_text(Renderer::get_clipboard_string());
       }
       return true;
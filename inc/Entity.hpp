@@ -2,11 +2,17 @@
 #define ENTITY
 
 // MARE
+#include "Bounds.hpp"
 #include "Components/Transform.hpp"
+#include "EntityPool.hpp"
 #include "Mare.hpp"
 #include "Systems.hpp"
+#include "TypeIndex.hpp"
 
 namespace mare {
+// Forward Declarations
+class Layer;
+class TransformHierarchy;
 
 /**
  * @brief An Entity is an element of a Scene or Layer.
@@ -50,7 +56,9 @@ public:
   Referenced<T> gen_system(Args... args) {
     static_assert(std::is_base_of<System, T>::value);
     Referenced<T> sys = gen_ref<T>(args...);
+    listen_to_overrides(sys.get());
     systems_.push_back(sys);
+    cache_system(sys.get());
     return sys;
   }
   /**
@@ -73,7 +81,9 @@ public:
     std::vector<Referenced<T>> systems{};
     for (uint32_t i = 0; i < count; i++) {
       Referenced<T> sys = gen_ref<T>(args...);
+      listen_to_overrides(sys.get());
       systems_.push_back(sys);
+      cache_system(sys.get());
       systems.push_back(sys);
     }
     return systems;
@@ -89,12 +99,7 @@ public:
    */
   template <typename T> T *get_system() {
     static_assert(std::is_base_of<System, T>::value);
-    for (auto sys_it = systems_begin(); sys_it != systems_end(); sys_it++) {
-      if (auto system = std::dynamic_pointer_cast<T>(*sys_it)) {
-        return system.get();
-      }
-    }
-    return nullptr;
+    return system_index_.first<T>(systems_);
   }
   /**
    * @brief Get a `std::vector` of pointers to all of the Systems of type <T> in
@@ -103,18 +108,13 @@ public:
    * @tparam <T> The type of System to get. <T> must be a System.
    * @return A `std::vector` of pointers to all of the Systems of type <T> in
    * the System stack. An empty vector is returned if no System of type <T>
-   * exists on the System stack.
+   * exists on the System stack. The vector is a copy, so the System stack may
+   * change while it is iterated.
    * @see System
    */
   template <typename T> std::vector<T *> get_systems() {
     static_assert(std::is_base_of<System, T>::value);
-    std::vector<T *> systems{};
-    for (auto sys_it = systems_begin(); sys_it != systems_end(); sys_it++) {
-      if (auto system = std::dynamic_pointer_cast<T>(*sys_it)) {
-        systems.push_back(system.get());
-      }
-    }
-    return systems;
+    return system_index_.get<T>(systems_);
   }
   /**
    * @brief Push an existing Referenced System onto the Entity's System stack.
@@ -122,7 +122,26 @@ public:
    * @param system A Referenced System.
    * @see System
    */
-  void push_system(Referenced<System> system) { systems_.push_back(system); }
+  void push_system(Referenced<System> system) {
+    systems_.push_back(system);
+    cache_system(system.get());
+  }
+  /**
+   * @brief Push an existing Referenced System of type <T> onto the Entity's
+   * System stack.
+   * @details An IControlsSystem pushed this way listens only to the events
+   * whose callbacks <T> overrides.
+   *
+   * @tparam <T> The type of System. <T> must be a System.
+   * @param system A Referenced System.
+   * @see System
+   */
+  template <typename T> void push_system(Referenced<T> system) {
+    static_assert(std::is_base_of<System, T>::value);
+    listen_to_overrides(system.get());
+    systems_.push_back(system);
+    cache_system(system.get());
+  }
   /**
    * @brief Push a `std::vector` of existing Referenced Systems onto the
    * Entity's System stack.
@@ -133,6 +152,7 @@ public:
   void push_systems(std::vector<Referenced<System>> systems) {
     for (size_t i = 0; i < systems.size(); i++) {
       systems_.push_back(systems[i]);
+      cache_system(systems[i].get());
     }
   }
   /**
@@ -149,8 +169,10 @@ public:
     for (auto sys_it = systems_begin(); sys_it != systems_end(); sys_it++) {
       if (system == (*sys_it).get()) {
         Referenced<T> pulled_system = (*sys_it);
+        uncache_system((*sys_it).get());
         (*sys_it) = nullptr;
         system_pulled = true;
+        Renderer::invalidate_structure();
         return pulled_system;
       }
     }
@@ -235,6 +257,123 @@ public:
   std::vector<Referenced<System>>::reverse_iterator systems_rend() {
     return systems_.rend();
   }
+  /**
+   * @brief Get the cached list of IPhysicsSystems on the System stack.
+   * @details The list is kept in System stack order and is only rebuilt when
+   * the System stack changes, so it can be iterated every frame without any
+   * RTTI or allocation. Pulled Systems are left as nullptr entries until the
+   * next call to remove_null_systems().
+   *
+   * @return A const reference to the cached IPhysicsSystem list.
+   * @see IPhysicsSystem
+   */
+  const std::vector<IPhysicsSystem *> &physics_systems() const {
+    return physics_systems_;
+  }
+  /**
+   * @brief Get the cached list of IRenderSystems on the System stack.
+   * @details Same caching rules as physics_systems().
+   *
+   * @return A const reference to the cached IRenderSystem list.
+   * @see IRenderSystem
+   */
+  const std::vector<IRenderSystem *> &render_systems() const {
+    return render_systems_;
+  }
+  /**
+   * @brief Get the cached list of IControlsSystems on the System stack.
+   * @details Same caching rules as physics_systems().
+   *
+   * @return A const reference to the cached IControlsSystem list.
+   * @see IControlsSystem
+   */
+  const std::vector<IControlsSystem *> &controls_systems() const {
+    return controls_systems_;
+  }
+  /**
+   * @brief Get the parent of the Entity in its Layer's TransformHierarchy.
+   *
+   * @return A pointer to the parent Entity. nullptr if the Entity has no
+   * parent.
+   * @see Layer::set_parent()
+   */
+  Entity *get_parent() const { return parent_; }
+  /**
+   * @brief Get the Layer whose Entity stack holds the Entity.
+   *
+   * @return A pointer to the Layer. nullptr if the Entity is not on an Entity
+   * stack.
+   */
+  Layer *get_layer() const { return layer_; }
+  /**
+   * @brief Get the world Transform of the Entity.
+   * @details The Entity's own Transform is relative to its parent. The world
+   * Transform combines it with the world Transform of the parent and is
+   * updated once per frame, after the physics phase, by the Layer's
+   * TransformHierarchy. An Entity without a parent returns itself, or its
+   * render Transform while one is set.
+   *
+   * @return A pointer to the world Transform.
+   * @see TransformHierarchy
+   */
+  Transform *get_world_transform() {
+    if (parent_) {
+      return &world_transform_;
+    }
+    return interpolated_ ? &render_transform_ : static_cast<Transform *>(this);
+  }
+  /**
+   * @brief Draw the Entity with a different local Transform than its own.
+   * @details Used by the Renderer to draw Rigidbodies between two fixed
+   * physics steps. The Entity's own Transform is left unchanged, only the
+   * world Transform and the TransformHierarchy use the matrix until
+   * clear_render_transform() is called.
+   *
+   * @param local The local transformation matrix to draw with.
+   * @see Renderer::step_physics()
+   */
+  void set_render_transform(const glm::mat4 &local) {
+    render_transform_.set_transformation_matrix(local);
+    interpolated_ = true;
+  }
+  /**
+   * @brief Draw the Entity with its own Transform again.
+   */
+  void clear_render_transform() { interpolated_ = false; }
+  /**
+   * @brief Get the local transformation matrix the Entity is drawn with.
+   *
+   * @return The matrix set by set_render_transform() or the Entity's own
+   * transformation matrix.
+   */
+  glm::mat4 get_render_matrix() {
+    return interpolated_ ? render_transform_.get_transformation_matrix()
+                         : get_transformation_matrix();
+  }
+  /**
+   * @brief Get the bounding box of the Entity.
+   * @details The box is in the model space of the Entity, before its world
+   * Transform is applied, and is used to place the Entity in its Layer's
+   * SpatialIndex. The default box is empty, which leaves the Entity out of the
+   * SpatialIndex.
+   *
+   * @return The AABB of the Entity.
+   * @see SpatialIndex
+   */
+  virtual AABB get_bounds() { return AABB{}; }
+  /**
+   * @brief Recompute the bounds of the Entity in its Layer's SpatialIndex on
+   * the next update.
+   * @details Call it after get_bounds() changes without the Entity's Transform
+   * changing. RenderPacks and the Meshes on their Packet stacks call it
+   * themselves. Does nothing if the Entity is not on a Layer.
+   * @see SpatialIndex::mark_dirty()
+   */
+  void mark_bounds_dirty();
+  /**
+   * @brief Erase the nullptr entries left on the System stack by
+   * pull_system() and rebuild the cached System lists.
+   */
   void remove_null_systems() {
     if (system_pulled) {
       system_pulled = false;
@@ -243,12 +382,102 @@ public:
                                       return sys.get() == nullptr;
                                     }),
                      systems_end());
+      rebuild_system_cache();
     }
   }
 
 private:
+  /**
+   * @brief Subscribe an IControlsSystem to the events whose callbacks its type
+   * overrides.
+   *
+   * @tparam <T> The type of System.
+   * @param system The System, may be nullptr.
+   */
+  template <typename T> static void listen_to_overrides(T *system) {
+    if constexpr (std::is_base_of<IControlsSystem, T>::value) {
+      if (system) {
+        system->listen_to(T::template overridden_events<T>());
+      }
+    }
+  }
+  /**
+   * @brief Append a System to each cached list whose interface it implements.
+   *
+   * @param system The System that was pushed onto the System stack.
+   */
+  void cache_system(System *system) {
+    if (!system) {
+      return;
+    }
+    system_index_.insert(system);
+    if (auto sys = dynamic_cast<IPhysicsSystem *>(system)) {
+      physics_systems_.push_back(sys);
+    }
+    if (auto sys = dynamic_cast<IRenderSystem *>(system)) {
+      render_systems_.push_back(sys);
+    }
+    if (auto sys = dynamic_cast<IControlsSystem *>(system)) {
+      controls_systems_.push_back(sys);
+      Renderer::invalidate_controls(this);
+    }
+  }
+  /**
+   * @brief Null out a System in the cached lists without changing their size.
+   * @details The lists may be iterated while a System pulls itself, so the
+   * entries are compacted later by remove_null_systems().
+   *
+   * @param system The System being pulled from the System stack.
+   */
+  void uncache_system(System *system) {
+    system_index_.remove(system);
+    for (auto &sys : physics_systems_) {
+      if (sys == system) {
+        sys = nullptr;
+      }
+    }
+    for (auto &sys : render_systems_) {
+      if (sys == system) {
+        sys = nullptr;
+      }
+    }
+    for (auto &sys : controls_systems_) {
+      if (sys == system) {
+        sys = nullptr;
+        Renderer::invalidate_controls(this);
+      }
+    }
+  }
+  /**
+   * @brief Erase the nullptr entries left in the cached System lists by
+   * uncache_system().
+   */
+  void rebuild_system_cache() {
+    auto erase_null = [](auto &systems) {
+      systems.erase(std::remove(systems.begin(), systems.end(), nullptr),
+                    systems.end());
+    };
+    erase_null(physics_systems_);
+    erase_null(render_systems_);
+    erase_null(controls_systems_);
+  }
   std::vector<Referenced<System>> systems_; /**< The System stack.*/
+  std::vector<IPhysicsSystem *>
+      physics_systems_; /**< Cached IPhysicsSystems on the System stack.*/
+  std::vector<IRenderSystem *>
+      render_systems_; /**< Cached IRenderSystems on the System stack.*/
+  std::vector<IControlsSystem *>
+      controls_systems_; /**< Cached IControlsSystems on the System stack.*/
   bool system_pulled = false;
+  TypeIndex<System> system_index_{}; /**< Typed views of the System stack.*/
+  friend class TransformHierarchy;
+  friend class Layer;
+  Entity *parent_{nullptr};      /**< The parent in the TransformHierarchy.*/
+  Layer *layer_{nullptr};        /**< The Layer whose Entity stack holds this.*/
+  EntityHandle handle_{};        /**< The EntityHandle on layer_'s stack.*/
+  Transform world_transform_{};  /**< Cached world Transform if parented.*/
+  Transform render_transform_{}; /**< Local Transform to draw with.*/
+  bool interpolated_{false};     /**< Draw with render_transform_?*/
 };
 } // namespace mare
 
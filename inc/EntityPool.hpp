@@ -0,0 +1,289 @@
+#ifndef ENTITYPOOL
+#define ENTITYPOOL
+
+// MARE
+#include "Mare.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief A 32-bit generational handle to an Entity on a Layer's Entity stack.
+ * @details The low EntityHandle::index_bits bits are the index of a slot in a
+ * HandleTable and the remaining bits are the generation of that slot. Every
+ * time a slot is released its generation is incremented so handles to the old
+ * Entity are no longer valid when the slot is reused.
+ * @see HandleTable
+ */
+struct EntityHandle {
+  static constexpr uint32_t index_bits = 22;
+  static constexpr uint32_t index_mask = (1u << index_bits) - 1;
+  static constexpr uint32_t generation_mask = (1u << (32 - index_bits)) - 1;
+  static constexpr uint32_t invalid = 0xFFFFFFFF;
+  uint32_t value{invalid}; /**< The packed index and generation.*/
+  /**
+   * @brief Get the slot index of the handle.
+   *
+   * @return The slot index.
+   */
+  uint32_t index() const { return value & index_mask; }
+  /**
+   * @brief Get the generation of the handle.
+   *
+   * @return The generation.
+   */
+  uint32_t generation() const { return value >> index_bits; }
+  bool operator==(const EntityHandle &other) const {
+    return value == other.value;
+  }
+  bool operator!=(const EntityHandle &other) const {
+    return value != other.value;
+  }
+};
+
+/**
+ * @brief Maps EntityHandles to positions in a densely packed array.
+ * @details Released slots are kept on a first in, first out free list and are
+ * only reused once more than HandleTable::min_free slots are free, so a slot
+ * that is released and reacquired over and over still goes through many other
+ * slots before its generation repeats. A slot whose generation is exhausted is
+ * retired instead of wrapping around, so a stale handle never becomes valid
+ * again. Creating and destroying handles does not allocate once the table has
+ * grown. All operations are O(1).
+ */
+class HandleTable {
+public:
+  /**
+   * @brief Create a new handle.
+   *
+   * @param position The position in the packed array the handle refers to.
+   * @return The new handle.
+   */
+  EntityHandle insert(uint32_t position) {
+    uint32_t index;
+    if (free_.size() <= min_free) {
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back({position, 0});
+      // the last index with the last generation would be EntityHandle::invalid
+      assert(slots_.size() <= EntityHandle::index_mask);
+    } else {
+      index = free_.front();
+      free_.pop_front();
+      slots_[index].position = position;
+    }
+    return {(slots_[index].generation << EntityHandle::index_bits) | index};
+  }
+  /**
+   * @brief Check if a handle refers to a live slot.
+   *
+   * @param handle The handle to check.
+   * @return true if the handle is valid.
+   */
+  bool valid(EntityHandle handle) const {
+    uint32_t index = handle.index();
+    return handle != EntityHandle{} && index < slots_.size() &&
+           slots_[index].generation == handle.generation() &&
+           slots_[index].position != released;
+  }
+  /**
+   * @brief Get the position a valid handle refers to.
+   *
+   * @param handle A valid handle.
+   * @return The position in the packed array.
+   */
+  uint32_t position(EntityHandle handle) const {
+    return slots_[handle.index()].position;
+  }
+  /**
+   * @brief Update the position a valid handle refers to after the packed
+   * array has been rearranged.
+   *
+   * @param handle A valid handle.
+   * @param position The new position.
+   */
+  void move(EntityHandle handle, uint32_t position) {
+    slots_[handle.index()].position = position;
+  }
+  /**
+   * @brief Release a valid handle so its slot can be reused.
+   *
+   * @param handle A valid handle.
+   */
+  void erase(EntityHandle handle) {
+    Slot &slot = slots_[handle.index()];
+    slot.position = released;
+    if (slot.generation == EntityHandle::generation_mask) {
+      // retire the slot, reusing it would wrap its generation
+      return;
+    }
+    slot.generation++;
+    free_.push_back(handle.index());
+  }
+  /**
+   * @brief Reserve space for a number of handles.
+   *
+   * @param count The number of handles.
+   */
+  void reserve(size_t count) { slots_.reserve(count); }
+
+  /**
+   * @brief The number of released slots kept on the free list before any of
+   * them are reused.
+   */
+  static constexpr size_t min_free = 1024;
+
+private:
+  static constexpr uint32_t released = 0xFFFFFFFF;
+  /**
+   * @brief The position and current generation of a handle.
+   */
+  struct Slot {
+    uint32_t position;   /**< The position in the packed array.*/
+    uint32_t generation; /**< The generation of the slot.*/
+  };
+  std::vector<Slot> slots_{};   /**< Every slot ever created.*/
+  std::deque<uint32_t> free_{}; /**< Released slots, oldest first.*/
+};
+
+/**
+ * @brief A free list allocator of fixed size blocks.
+ * @details Blocks are carved out of large chunks that are never returned to
+ * the system. There is one BlockPool for each block size and alignment, and
+ * each BlockPool is intentionally never destroyed so Referenced objects that
+ * outlive static destruction can still be released.
+ *
+ * @tparam <Size> The size of each block.
+ * @tparam <Align> The alignment of each block.
+ */
+template <size_t Size, size_t Align> class BlockPool {
+public:
+  /**
+   * @brief Get the BlockPool for this block size and alignment.
+   *
+   * @return The BlockPool.
+   */
+  static BlockPool &get() {
+    static BlockPool *pool = new BlockPool();
+    return *pool;
+  }
+  /**
+   * @brief Allocate a block.
+   *
+   * @param reserve If the free list is empty, the number of blocks to allocate
+   * in the new chunk.
+   * @return A pointer to the block.
+   */
+  void *allocate(size_t reserve) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_) {
+      grow(std::max(reserve, min_chunk_size));
+    }
+    Block *block = free_;
+    free_ = block->next;
+    return block;
+  }
+  /**
+   * @brief Return a block to the free list.
+   *
+   * @param pointer A pointer to a block allocated from this BlockPool.
+   */
+  void deallocate(void *pointer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Block *block = static_cast<Block *>(pointer);
+    block->next = free_;
+    free_ = block;
+  }
+
+private:
+  BlockPool() {}
+  static constexpr size_t min_chunk_size = 64;
+  union Block {
+    Block *next;
+    alignas(Align) unsigned char storage[Size];
+  };
+  void grow(size_t count) {
+    chunks_.push_back(Scoped<Block[]>(new Block[count]));
+    Block *chunk = chunks_.back().get();
+    for (size_t i = 0; i < count; i++) {
+      chunk[i].next = i + 1 < count ? &chunk[i + 1] : free_;
+    }
+    free_ = chunk;
+  }
+  std::vector<Scoped<Block[]>> chunks_{}; /**< All allocated chunks.*/
+  Block *free_{nullptr};                  /**< The first free block.*/
+  std::mutex mutex_{};
+};
+
+/**
+ * @brief A standard allocator that allocates single objects from a BlockPool.
+ * @details Used with `std::allocate_shared` so the object and its control
+ * block share a single pooled block. Arrays fall back to the global operator
+ * new.
+ *
+ * @tparam <T> The type of object to allocate.
+ */
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+  /**
+   * @brief Construct a new PoolAllocator.
+   *
+   * @param reserve The number of blocks to allocate at once if the BlockPool
+   * runs out of free blocks.
+   */
+  explicit PoolAllocator(size_t reserve = 0) : reserve(reserve) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) : reserve(other.reserve) {}
+  T *allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T *>(
+        BlockPool<sizeof(T), alignof(T)>::get().allocate(reserve));
+  }
+  void deallocate(T *pointer, size_t n) {
+    if (n != 1) {
+      ::operator delete(pointer);
+      return;
+    }
+    BlockPool<sizeof(T), alignof(T)>::get().deallocate(pointer);
+  }
+  template <typename U> bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const PoolAllocator<U> &) const {
+    return false;
+  }
+  size_t reserve; /**< Blocks to allocate when the BlockPool is empty.*/
+};
+
+/**
+ * @brief Used to generate a Referenced variable from a BlockPool.
+ * @details Pooled Referenced variables of the same type reuse each other's
+ * memory when they are deleted instead of going through the global heap.
+ *
+ * @tparam <T> The type of Referenced variable to generate
+ * @tparam <Args> The types of the arguments used to construct <T>
+ * @param reserve The number of objects of type <T> to make room for if the
+ * pool needs to grow.
+ * @param args The arguments used to construct <T>
+ * @return The Referenced variable.
+ */
+template <typename T, typename... Args>
+Referenced<T> gen_pooled(size_t reserve, Args... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(reserve), args...);
+}
+
+} // namespace mare
+
+#endif
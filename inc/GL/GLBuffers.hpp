@@ -3,6 +3,8 @@
 
 // MARE
 #include "Buffers.hpp"
+#include "GL/GLState.hpp"
+#include "GeometryHeap.hpp"
 #include "Mare.hpp"
 
 // Standard Library
@@ -91,6 +93,10 @@ public:
     case BufferType::STATIC:
       glNamedBufferStorage(buffer_ID_, size_in_bytes, data, flags);
       break;
+    case BufferType::DYNAMIC:
+      glNamedBufferStorage(buffer_ID_, size_in_bytes, data,
+                           GL_DYNAMIC_STORAGE_BIT);
+      break;
     case BufferType::READ_ONLY:
       flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
       glNamedBufferStorage(buffer_ID_, size_in_bytes, data, flags);
@@ -122,7 +128,8 @@ public:
       break;
     }
     if (buffer_type != BufferType::STATIC &&
-        buffer_type != BufferType::READ_ONLY) {
+        buffer_type != BufferType::READ_ONLY &&
+        buffer_type != BufferType::DYNAMIC) {
       glNamedBufferStorage(buffer_ID_, num_buffers_ * size_in_bytes, nullptr,
                            flags);
       buffer_pointer_ = static_cast<T *>(
@@ -143,6 +150,7 @@ public:
    * @brief Destroy the GLBuffer object.
    */
   ~GLBuffer() {
+    GLState::forget_buffer(this->buffer_ID_);
     glDeleteBuffers(1, &this->buffer_ID_);
     for (unsigned short i = 0; i < this->num_buffers_; i++) {
       if (buffer_fence_) {
@@ -158,6 +166,7 @@ public:
    * size_in_bytes large. The \p offset_index must not be larger than the
    * maximum amount of Buffer elements - 1. \p size_in_bytes must not be larger
    * than the space left in the Buffer after \p offset_index elements.
+   * BufferType::DYNAMIC Buffers are written with glNamedBufferSubData().
    *
    * @param data A pointer to the data to flush.
    * @param offset_index An index into the Buffer to start writing data.
@@ -172,6 +181,11 @@ public:
     count_ = std::max(static_cast<uint32_t>(size_in_bytes / sizeof(T)) +
                           offset_index,
                       count_);
+    if (type_ == BufferType::DYNAMIC) {
+      glNamedBufferSubData(buffer_ID_, offset_index * sizeof(T), size_in_bytes,
+                           data);
+      return;
+    }
     // size_t write_offset =
     //    sizeof(T) *
     //    (offset_index +
@@ -190,6 +204,7 @@ public:
   T &operator[](uint32_t i) {
     assert(type_ != BufferType::STATIC);    // Buffer must not be static
     assert(type_ != BufferType::READ_ONLY); // Buffer must not be read only
+    assert(type_ != BufferType::DYNAMIC);   // Buffer must be mapped
     return buffer_pointer_[buffer_index_ * static_cast<uint32_t>(size_ / sizeof(T)) + i];
   }
   /**
@@ -206,12 +221,43 @@ public:
                                                              // be write only
     assert(type_ != BufferType::WRITE_ONLY_TRIPLE_BUFFERED); // Buffer must not
                                                              // be write only
+    assert(type_ != BufferType::DYNAMIC); // Buffer must be mapped
     T element;
     element = buffer_pointer_[buffer_index_ *
                                   static_cast<uint32_t>(size_ / sizeof(T)) +
                               i];
     return element;
   }
+  /**
+   * @brief The OpenGL 4.5 implementation of the Buffer::read(T*, uint32_t,
+   * size_t) function.
+   * @details Buffers mapped for reading are copied from the mapped pointer.
+   * Every other Buffer is read back with glGetNamedBufferSubData().
+   *
+   * @param data A pointer to allocated memory at least \p size_in_bytes large.
+   * @param offset_index The index into the buffer to start reading from.
+   * @param size_in_bytes The size in bytes of the data to read.
+   */
+  void read(T *data, uint32_t offset_index, size_t size_in_bytes) const {
+    assert(size_in_bytes + offset_index * sizeof(T) <=
+           size_); // buffer must contain the data to read
+    size_t offset = buffer_index_ * size_ + offset_index * sizeof(T);
+    bool readable = type_ == BufferType::READ_ONLY ||
+                    type_ == BufferType::READ_WRITE ||
+                    type_ == BufferType::READ_WRITE_DOUBLE_BUFFERED ||
+                    type_ == BufferType::READ_WRITE_TRIPLE_BUFFERED;
+    if (buffer_pointer_ && readable) {
+      std::memcpy(static_cast<void *>(data),
+                  reinterpret_cast<const char *>(buffer_pointer_) + offset,
+                  size_in_bytes);
+    } else {
+      // make client writes to coherent mappings visible to the server first
+      if (buffer_pointer_) {
+        glFlush();
+      }
+      glGetNamedBufferSubData(buffer_ID_, offset, size_in_bytes, data);
+    }
+  }
   /**
    * @brief Wait for any locks to be released on the buffer before
    * proceeding. Used only on multibuffered buffers before writing data.
@@ -257,6 +303,7 @@ public:
   void clear(T value) {
     assert(type_ != BufferType::STATIC);    // Buffer must not be static
     assert(type_ != BufferType::READ_ONLY); // Buffer must not be read only
+    assert(type_ != BufferType::DYNAMIC);   // Buffer must be mapped
     for (uint32_t i = 0; i < count_; i++) {
       buffer_pointer_[i] = value;
     }
@@ -307,13 +354,52 @@ public:
    *
    * @param width The width in pixels or fragments of the Framebuffer.
    * @param height The height in pixels or fragments of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
    */
-  GLFramebuffer(int width, int height);
+  GLFramebuffer(int width, int height,
+                TextureType color_type = TextureType::RGBA32F);
   /**
    * @brief Destroy the GLFramebuffer object
    */
   virtual ~GLFramebuffer();
 };
+
+/**
+ * @brief The OpenGL 4.5 implementation of the GeometryHeap class.
+ * @details Pages are immutable buffers with GL_DYNAMIC_STORAGE_BIT so they can
+ * stay in GPU memory. Buffers are copied into the pages with
+ * glCopyNamedBufferSubData() and never pass through the client.
+ * @see GeometryHeap
+ */
+class GLGeometryHeap : public GeometryHeap {
+public:
+  /**
+   * @brief Construct a new GLGeometryHeap.
+   *
+   * @param page_size The size in bytes of each page.
+   */
+  GLGeometryHeap(size_t page_size) : GeometryHeap(page_size) {}
+  /**
+   * @brief Destroy the GLGeometryHeap and its pages.
+   */
+  ~GLGeometryHeap();
+
+protected:
+  uint32_t create_page(size_t size) override;
+  void destroy_page(uint32_t name) override;
+  void write_page(uint32_t name, size_t offset, const void *data,
+                  size_t size) override;
+  void read_page(uint32_t name, size_t offset, void *data,
+                 size_t size) const override;
+  void move_in_page(uint32_t name, size_t from, size_t to,
+                    size_t size) override;
+  bool copy_to_page(const IBuffer &source, uint32_t name, size_t offset,
+                    size_t size) override;
+
+private:
+  GLuint scratch_{0};      /**< Staging for moves of overlapping ranges.*/
+  size_t scratch_size_{0}; /**< The size in bytes of the staging buffer.*/
+};
 } // namespace mare
 
 #endif
\ No newline at end of file
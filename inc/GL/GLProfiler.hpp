@@ -0,0 +1,51 @@
+#ifndef GLPROFILER
+#define GLPROFILER
+
+// MARE
+#include "Profiler.hpp"
+
+// Standard Library
+#include <array>
+#include <vector>
+
+// OpenGL
+#include "GL/glew.h"
+
+namespace mare {
+/**
+ * @brief GPU timing implemented with OpenGL timestamp queries.
+ * @details Every scope issues a GL_TIMESTAMP query at its beginning and end so
+ * scopes can be nested. Queries are kept for several frames and are only read
+ * back once the GPU reports them as available, so timing never stalls the
+ * render loop. Results that are still pending when their frame slot is reused
+ * are dropped, and so are scopes still open when the frame ends, whose end
+ * query was never issued.
+ */
+class GLGpuTimer : public GpuTimer {
+public:
+  GLGpuTimer() {}
+  ~GLGpuTimer();
+  void begin(const char *name) override;
+  void end() override;
+  void collect() override;
+
+private:
+  /**
+   * @brief The queries issued during a single frame.
+   */
+  struct FrameQueries {
+    std::vector<GLuint> queries;     /**< Begin and end query of each scope.*/
+    std::vector<const char *> names; /**< Name of each scope.*/
+    std::vector<uint8_t> ended;      /**< Was the end query of each scope
+                                        issued?*/
+    size_t used{0};                  /**< Scopes issued this frame.*/
+    GLuint last_query{0};            /**< The last query issued.*/
+  };
+  static constexpr size_t frames_in_flight = 4;
+  std::array<FrameQueries, frames_in_flight> frames_{};
+  std::vector<size_t> open_scopes_{}; /**< Stack of scopes not yet ended.*/
+  size_t current_{0};                 /**< The frame being recorded.*/
+};
+} // namespace mare
+
+#endif
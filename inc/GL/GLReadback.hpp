@@ -0,0 +1,80 @@
+#ifndef GLREADBACK
+#define GLREADBACK
+
+// MARE
+#include "Readback.hpp"
+
+// Standard Library
+#include <array>
+#include <vector>
+
+// OpenGL
+#include "GL/glew.h"
+
+namespace mare {
+/**
+ * @brief Asynchronous pixel reads implemented with OpenGL pixel buffer objects
+ * and fences.
+ * @details Each batch is read into its own pixel buffer object with
+ * glReadPixels(), which only queues a copy on the GPU, and is followed by a
+ * fence. A batch is copied to the CPU once its fence has signaled, so reading
+ * never stalls the render loop.
+ */
+class GLPixelReader : public PixelReader {
+public:
+  GLPixelReader() {}
+  ~GLPixelReader();
+  bool read(const std::vector<glm::ivec2> &pixels) override;
+  bool poll(std::vector<float> &depths) override;
+  bool read_ids(Framebuffer *framebuffer,
+                const std::vector<PixelRect> &rects) override;
+  bool poll_ids(std::vector<uint32_t> &ids) override;
+
+private:
+  /**
+   * @brief A batch of pixels being read.
+   */
+  struct Slot {
+    GLuint buffer{0};      /**< The pixel buffer object.*/
+    size_t capacity{0};    /**< The size of the buffer in bytes.*/
+    size_t size{0};        /**< The size of the batch in bytes.*/
+    GLsync fence{nullptr}; /**< Signaled when the copy has finished.*/
+  };
+  static constexpr size_t frames_in_flight = 3;
+  /**
+   * @brief The batches in flight of one kind of read, oldest first.
+   */
+  struct Ring {
+    std::array<Slot, frames_in_flight> slots{}; /**< The batches.*/
+    size_t oldest{0};                           /**< The oldest batch.*/
+    size_t used{0};                             /**< Batches in flight.*/
+  };
+  /**
+   * @brief Start a batch and bind its buffer as the pixel pack buffer.
+   *
+   * @param ring The Ring to start the batch in.
+   * @param size The size of the batch in bytes.
+   * @return The Slot of the batch or nullptr if the Ring is full.
+   */
+  static Slot *begin_read(Ring &ring, size_t size);
+  /**
+   * @brief Unbind the pixel pack buffer and fence the batch.
+   *
+   * @param ring The Ring the batch was started in.
+   * @param slot The Slot returned by begin_read().
+   */
+  static void end_read(Ring &ring, Slot &slot);
+  /**
+   * @brief Remove the oldest batch from a Ring if the GPU has finished it.
+   *
+   * @param ring The Ring to poll.
+   * @return The Slot of the finished batch, valid until the next
+   * begin_read(), or nullptr.
+   */
+  static Slot *poll_ring(Ring &ring);
+  Ring depths_{}; /**< Reads of the default framebuffer's depth.*/
+  Ring ids_{};    /**< Reads of an ID Framebuffer.*/
+};
+} // namespace mare
+
+#endif
@@ -5,8 +5,14 @@
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 // MARE
+#include "GL/GLReadback.hpp"
+#include "GL/GLState.hpp"
 #include "Meshes.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
+// Standard Library
+#include <string>
+#include <unordered_map>
 
 namespace mare {
 namespace opengl {
@@ -103,6 +109,13 @@ public:
    * @see Renderer::api_clear_color_buffer(glm::vec4)
    */
   void api_clear_color_buffer(glm::vec4 color) override;
+  /**
+   * @brief GLRenderer implementation to clear an integer color buffer.
+   *
+   * @param color The value to clear the color buffer to.
+   * @see Renderer::api_clear_color_buffer(glm::uvec4)
+   */
+  void api_clear_color_buffer(glm::uvec4 color) override;
   /**
    * @brief GLRenderer implementation to clear the depth buffer.
    * @details Depth buffer is cleared to 1.0f.
@@ -152,6 +165,15 @@ public:
    * @see Renderer::api_enable_blending(bool)
    */
   void api_enable_blending(bool enable) override;
+  /**
+   * @brief GLRenderer implementation to enable the polygon depth offset.
+   * @param enable true enables the offset, false disables it.
+   * @param factor The offset scaled by the depth slope of each polygon.
+   * @param units The offset in units of the depth buffer resolution.
+   * @see Renderer::api_enable_polygon_offset(bool,float,float)
+   */
+  void api_enable_polygon_offset(bool enable, float factor,
+                                 float units) override;
   /**
    * @brief Raycast from the mouse position into the Camera's view of a Scene or
    * Layer.
@@ -183,6 +205,14 @@ public:
    * @param framebuffer The Framebuffer to set.
    */
   virtual void api_set_framebuffer(Framebuffer *framebuffer) override;
+  /**
+   * @brief Bind a uniform Buffer to a uniform block binding point shared by
+   * every Shader.
+   * @param binding The uniform block binding point.
+   * @param uniform The uniform Buffer to bind.
+   */
+  virtual void api_bind_uniform_buffer(uint32_t binding,
+                                       IBuffer *uniform) override;
 
   /**
    * @brief GLRenderer implemented function to generate a Texture2D from an
@@ -213,10 +243,11 @@ public:
    *
    * @param width The width in pixels or fragments of the Framebuffer.
    * @param height The height in pixels or fragments of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
    * @return Scoped<Framebuffer>
    */
-  virtual Scoped<Framebuffer> api_gen_framebuffer(int width,
-                                                  int height) override;
+  virtual Scoped<Framebuffer>
+  api_gen_framebuffer(int width, int height, TextureType color_type) override;
 
   /**
    * @brief GLRenderer implemented function to generate a Shader from a
@@ -269,9 +300,51 @@ public:
                                       Transform *parent_transform,
                                       unsigned int instance_count,
                                       Buffer<Transform> *models) override;
+  /**
+   * @brief Draw a SimpleMesh whose state has already been bound and uploaded.
+   *
+   * @param mesh The SimpleMesh to draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param instance_count The number of instances to draw, 0 if not
+   * instanced.
+   */
+  virtual void api_draw_simple_mesh(SimpleMesh *mesh, Material *material,
+                                    unsigned int instance_count) override;
+  /**
+   * @brief GLRenderer implemented function to render many draws of a
+   * SimpleMesh's Buffers with glMultiDrawElementsIndirect().
+   *
+   * @param camera The Camera to render from.
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The batched Material to render with.
+   * @param parent_transform The parent Transform to render with.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   * @param models The model Transform of each draw.
+   */
+  virtual void api_render_simple_mesh_indirect(
+      Camera *camera, SimpleMesh *mesh, Material *material,
+      Transform *parent_transform, Buffer<DrawCommand> *commands,
+      unsigned int draw_count, Buffer<Transform> *models) override;
+  /**
+   * @brief Multi-draw a SimpleMesh whose state has already been bound and
+   * uploaded.
+   *
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   */
+  virtual void api_draw_simple_mesh_indirect(SimpleMesh *mesh,
+                                             Material *material,
+                                             Buffer<DrawCommand> *commands,
+                                             unsigned int draw_count) override;
   /**
    * @brief GLRenderer implemented function to bind a SimpleMesh's render state
    * to a Material.
+   * @details SimpleMeshes with the same Buffers and BufferFormats share a
+   * vertex array for each Material. Meshes in the same GeometryHeap pages have
+   * the same Buffers, so they are drawn without changing the vertex array.
    *
    * @param mesh The SimpleMesh whose render state will be bound to the
    * Material.
@@ -325,6 +398,40 @@ public:
 
 private:
   static GLFWwindow *window;
+  static Scoped<GpuTimer> gpu_timer; /**< Timer queries used by the Profiler.*/
+  static Scoped<GLPixelReader>
+      pixel_reader; /**< Pixel buffers used by raycast_async().*/
+  /**
+   * @brief A vertex array and the number of render states using it.
+   */
+  struct SharedVertexArray {
+    GLuint name{0};    /**< The vertex array.*/
+    uint32_t users{0}; /**< The render states using the vertex array.*/
+  };
+  static std::unordered_map<std::string, SharedVertexArray>
+      vertex_arrays; /**< The shared vertex arrays by their key.*/
+  static std::unordered_map<GLuint, std::string>
+      vertex_array_keys; /**< The key of each shared vertex array.*/
+  /**
+   * @brief Get the key of the vertex array a SimpleMesh is bound with for a
+   * Material.
+   * @details The key is made of the program, the names and formats of the
+   * Geometry Buffers and the name of the Index Buffer.
+   *
+   * @param mesh The SimpleMesh.
+   * @param material The Material.
+   * @return The key.
+   */
+  static std::string vertex_array_key(SimpleMesh *mesh, Material *material);
+  /**
+   * @brief Create a vertex array that binds the Buffers of a SimpleMesh to the
+   * inputs of a Material.
+   *
+   * @param mesh The SimpleMesh.
+   * @param material The Material.
+   * @return The vertex array.
+   */
+  static GLuint create_vertex_array(SimpleMesh *mesh, Material *material);
 
   /**
    * @brief A callback executed whenever OpenGL reports an error.
@@ -11,6 +11,7 @@
 
 // MARE
 #include "Buffers.hpp"
+#include "GL/GLState.hpp"
 #include "Shader.hpp"
 
 // External Libraries
@@ -39,7 +40,7 @@ public:
    * unbind and previously bound Shader.
    * @see Shader
    */
-  inline void use() const override { glUseProgram(shader_ID_); }
+  inline void use() const override { GLState::use_program(shader_ID_); }
   /**
    * @brief utility function to decode a OpenGL shader type to a string.
    *
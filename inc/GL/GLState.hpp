@@ -0,0 +1,339 @@
+#ifndef GLSTATE
+#define GLSTATE
+
+// Standard Library
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// OpenGL
+#include "GL/glew.h"
+
+namespace mare {
+/**
+ * @brief A shadow copy of the OpenGL context state that drops redundant state
+ * changes.
+ * @details Every state change made by the OpenGL backend goes through
+ * GLState, which compares it to the last value it set and only calls OpenGL if
+ * the value changed. State that has not been set since the last invalidate()
+ * is unknown and always set. Objects must be forgotten when they are deleted
+ * since OpenGL resets bindings to deleted objects and reuses their names.
+ *
+ * The number of calls issued and skipped is counted and published once per
+ * frame in RendererInfo::state_changes_issued and
+ * RendererInfo::state_changes_skipped.
+ */
+class GLState {
+public:
+  /**
+   * @brief Forget every cached value.
+   * @details Called when the context is created and whenever the state may
+   * have been changed without going through GLState.
+   */
+  static void invalidate();
+  /**
+   * @brief Make a program current with glUseProgram().
+   *
+   * @param program The program name.
+   */
+  static void use_program(GLuint program) {
+    if (changed(program_, program)) {
+      glUseProgram(program);
+    }
+  }
+  /**
+   * @brief Bind a vertex array with glBindVertexArray().
+   *
+   * @param vertex_array The vertex array name.
+   */
+  static void bind_vertex_array(GLuint vertex_array) {
+    if (changed(vertex_array_, vertex_array)) {
+      glBindVertexArray(vertex_array);
+    }
+  }
+  /**
+   * @brief Bind a buffer to a binding point with glBindBuffer().
+   *
+   * @param target The binding point, e.g. GL_PIXEL_PACK_BUFFER.
+   * @param buffer The buffer name.
+   */
+  static void bind_buffer(GLenum target, GLuint buffer) {
+    auto it = buffers_.try_emplace(target, unknown).first;
+    if (changed(it->second, buffer)) {
+      glBindBuffer(target, buffer);
+    }
+  }
+  /**
+   * @brief Bind a buffer to an indexed binding point with glBindBufferBase().
+   *
+   * @param target GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER.
+   * @param index The index of the binding point.
+   * @param buffer The buffer name.
+   */
+  static void bind_buffer_base(GLenum target, GLuint index, GLuint buffer) {
+    if (target != GL_UNIFORM_BUFFER && target != GL_SHADER_STORAGE_BUFFER) {
+      // untracked binding points are always set
+      issued_++;
+      glBindBufferBase(target, index, buffer);
+      return;
+    }
+    std::vector<GLuint> &bindings =
+        target == GL_UNIFORM_BUFFER ? uniform_buffers_ : storage_buffers_;
+    if (index >= bindings.size()) {
+      bindings.resize(index + 1, unknown);
+    }
+    if (changed(bindings[index], buffer)) {
+      glBindBufferBase(target, index, buffer);
+    }
+  }
+  /**
+   * @brief Bind a texture to a texture unit with glBindTextureUnit().
+   *
+   * @param unit The texture unit.
+   * @param texture The texture name.
+   */
+  static void bind_texture_unit(GLuint unit, GLuint texture) {
+    if (unit >= textures_.size()) {
+      textures_.resize(unit + 1, unknown);
+    }
+    if (changed(textures_[unit], texture)) {
+      glBindTextureUnit(unit, texture);
+    }
+  }
+  /**
+   * @brief Bind a framebuffer with glBindFramebuffer().
+   *
+   * @param target GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER.
+   * @param framebuffer The framebuffer name.
+   */
+  static void bind_framebuffer(GLenum target, GLuint framebuffer) {
+    bool draw = target != GL_READ_FRAMEBUFFER;
+    bool read = target != GL_DRAW_FRAMEBUFFER;
+    if ((draw && draw_framebuffer_ != framebuffer) ||
+        (read && read_framebuffer_ != framebuffer)) {
+      issued_++;
+      draw_framebuffer_ = draw ? framebuffer : draw_framebuffer_;
+      read_framebuffer_ = read ? framebuffer : read_framebuffer_;
+      glBindFramebuffer(target, framebuffer);
+    } else {
+      skipped_++;
+    }
+  }
+  /**
+   * @brief Get the framebuffer bound to a target.
+   * @details Only queries OpenGL if the binding is unknown.
+   *
+   * @param target GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER.
+   * @return The framebuffer name.
+   */
+  static GLuint get_framebuffer(GLenum target);
+  /**
+   * @brief Enable or disable a capability with glEnable() or glDisable().
+   *
+   * @param capability The capability, e.g. GL_DEPTH_TEST.
+   * @param enable true to enable the capability.
+   */
+  static void set_capability(GLenum capability, bool enable) {
+    auto it = capabilities_.try_emplace(capability, unknown).first;
+    if (changed(it->second, GLuint(enable))) {
+      if (enable) {
+        glEnable(capability);
+      } else {
+        glDisable(capability);
+      }
+    }
+  }
+  /**
+   * @brief Set the depth comparison with glDepthFunc().
+   *
+   * @param func The comparison function.
+   */
+  static void depth_func(GLenum func) {
+    if (changed(depth_func_, func)) {
+      glDepthFunc(func);
+    }
+  }
+  /**
+   * @brief Enable or disable depth writes with glDepthMask().
+   *
+   * @param mask true to write depth.
+   */
+  static void depth_mask(bool mask) {
+    if (changed(depth_mask_, GLuint(mask))) {
+      glDepthMask(mask ? GL_TRUE : GL_FALSE);
+    }
+  }
+  /**
+   * @brief Set the blend factors with glBlendFunc().
+   *
+   * @param source The source factor.
+   * @param destination The destination factor.
+   */
+  static void blend_func(GLenum source, GLenum destination) {
+    if (changed(blend_func_, {source, destination})) {
+      glBlendFunc(source, destination);
+    }
+  }
+  /**
+   * @brief Set the faces that are culled with glCullFace().
+   *
+   * @param mode The faces to cull.
+   */
+  static void cull_face(GLenum mode) {
+    if (changed(cull_face_, mode)) {
+      glCullFace(mode);
+    }
+  }
+  /**
+   * @brief Set how both faces are rasterized with glPolygonMode().
+   *
+   * @param mode GL_FILL, GL_LINE or GL_POINT.
+   */
+  static void polygon_mode(GLenum mode) {
+    if (changed(polygon_mode_, mode)) {
+      glPolygonMode(GL_FRONT_AND_BACK, mode);
+    }
+  }
+  /**
+   * @brief Set the depth offset of filled polygons with glPolygonOffset().
+   *
+   * @param factor The offset scaled by the depth slope of the polygon.
+   * @param units The offset in units of the depth buffer resolution.
+   */
+  static void polygon_offset(GLfloat factor, GLfloat units) {
+    if (changed(polygon_offset_, {factor, units})) {
+      glPolygonOffset(factor, units);
+    }
+  }
+  /**
+   * @brief Set the primitive restart index with glPrimitiveRestartIndex().
+   *
+   * @param index The index that restarts a primitive.
+   */
+  static void primitive_restart_index(GLuint index) {
+    if (changed(restart_index_, index)) {
+      glPrimitiveRestartIndex(index);
+    }
+  }
+  /**
+   * @brief Set the viewport with glViewport().
+   *
+   * @param x The left edge of the viewport in pixels.
+   * @param y The bottom edge of the viewport in pixels.
+   * @param width The width of the viewport in pixels.
+   * @param height The height of the viewport in pixels.
+   */
+  static void viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (changed(viewport_, {x, y, width, height})) {
+      glViewport(x, y, width, height);
+    }
+  }
+  /**
+   * @brief Forget the bindings of a program that is being deleted.
+   *
+   * @param program The program name.
+   */
+  static void forget_program(GLuint program);
+  /**
+   * @brief Forget the bindings of a vertex array that is being deleted.
+   *
+   * @param vertex_array The vertex array name.
+   */
+  static void forget_vertex_array(GLuint vertex_array);
+  /**
+   * @brief Forget the bindings of a buffer that is being deleted.
+   *
+   * @param buffer The buffer name.
+   */
+  static void forget_buffer(GLuint buffer);
+  /**
+   * @brief Forget the bindings of a texture that is being deleted.
+   *
+   * @param texture The texture name.
+   */
+  static void forget_texture(GLuint texture);
+  /**
+   * @brief Forget the bindings of a framebuffer that is being deleted.
+   *
+   * @param framebuffer The framebuffer name.
+   */
+  static void forget_framebuffer(GLuint framebuffer);
+  /**
+   * @brief Get the number of state changes passed on to OpenGL since the last
+   * reset_counters().
+   *
+   * @return The number of calls issued.
+   */
+  static uint32_t get_issued() { return issued_; }
+  /**
+   * @brief Get the number of redundant state changes dropped since the last
+   * reset_counters().
+   *
+   * @return The number of calls skipped.
+   */
+  static uint32_t get_skipped() { return skipped_; }
+  /**
+   * @brief Reset the issued and skipped counters.
+   */
+  static void reset_counters() {
+    issued_ = 0;
+    skipped_ = 0;
+  }
+
+private:
+  static constexpr GLuint unknown = ~GLuint(0); /**< A value never set.*/
+  /**
+   * @brief Update a cached value and count the change.
+   *
+   * @tparam T The type of the value.
+   * @param cached The cached value.
+   * @param value The new value.
+   * @return true if the value changed and OpenGL must be called.
+   */
+  template <typename T> static bool changed(T &cached, const T &value) {
+    if (cached == value) {
+      skipped_++;
+      return false;
+    }
+    cached = value;
+    issued_++;
+    return true;
+  }
+  /**
+   * @brief Forget every binding of a name in a list of bindings.
+   *
+   * @param bindings The bindings.
+   * @param name The name being deleted.
+   */
+  static void forget(std::vector<GLuint> &bindings, GLuint name);
+  static GLuint program_;          /**< The current program.*/
+  static GLuint vertex_array_;     /**< The bound vertex array.*/
+  static GLuint draw_framebuffer_; /**< The bound draw framebuffer.*/
+  static GLuint read_framebuffer_; /**< The bound read framebuffer.*/
+  static GLuint depth_func_;       /**< The depth comparison.*/
+  static GLuint depth_mask_;       /**< 1 if depth writes are enabled.*/
+  static GLuint cull_face_;        /**< The culled faces.*/
+  static GLuint polygon_mode_;     /**< The polygon rasterization.*/
+  static GLuint restart_index_;    /**< The primitive restart index.*/
+  static std::pair<GLenum, GLenum> blend_func_; /**< The blend factors.*/
+  static std::pair<GLfloat, GLfloat>
+      polygon_offset_;                   /**< The polygon depth offset.*/
+  static std::array<GLint, 4> viewport_; /**< The viewport.*/
+  static std::unordered_map<GLenum, GLuint>
+      buffers_; /**< The buffer bound to each non indexed binding point.*/
+  static std::vector<GLuint>
+      uniform_buffers_; /**< The buffer bound to each uniform buffer index.*/
+  static std::vector<GLuint>
+      storage_buffers_; /**< The buffer bound to each storage buffer index.*/
+  static std::vector<GLuint>
+      textures_; /**< The texture bound to each texture unit.*/
+  static std::unordered_map<GLenum, GLuint>
+      capabilities_; /**< 1 if a capability is enabled, 0 if not.*/
+  static uint32_t issued_;  /**< Calls issued since the last reset.*/
+  static uint32_t skipped_; /**< Calls skipped since the last reset.*/
+};
+} // namespace mare
+
+#endif
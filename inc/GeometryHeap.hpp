@@ -0,0 +1,391 @@
+#ifndef GEOMETRYHEAP
+#define GEOMETRYHEAP
+
+// MARE
+#include "Buffers.hpp"
+#include "Mare.hpp"
+
+// Standard Library
+#include <cassert>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief The usage of a GeometryHeap.
+ * @see GeometryHeap::get_stats()
+ */
+struct GeometryHeapStats {
+  uint32_t pages{0};            /**< Pages allocated from the Rendering API.*/
+  size_t capacity{0};           /**< Size in bytes of all pages.*/
+  size_t used{0};               /**< Bytes in live allocations.*/
+  uint32_t allocations{0};      /**< Live allocations.*/
+  uint32_t free_blocks{0};      /**< Free ranges in all pages.*/
+  size_t largest_free_block{0}; /**< Size in bytes of the largest range.*/
+  uint32_t defragmentations{0}; /**< Calls to GeometryHeap::defragment().*/
+  size_t bytes_moved{0};        /**< Bytes moved by every defragment().*/
+  /**
+   * @brief Get how scattered the free space is.
+   *
+   * @return 0 if the free space is a single range, approaching 1 as it is
+   * split into many small ranges.
+   */
+  float fragmentation() const {
+    size_t free = capacity - used;
+    return free ? 1.0f - float(largest_free_block) / float(free) : 0.0f;
+  }
+};
+
+/**
+ * @brief A few large buffers that static geometry is sub-allocated from.
+ * @details Creating a buffer with the Rendering API for every Mesh costs a
+ * driver allocation per Mesh and a different vertex array for each of them.
+ * A GeometryHeap instead allocates pages of GeometryHeap::get_page_size()
+ * bytes and places Buffers in the free ranges of the pages with a best fit
+ * free list. Freed ranges are merged with their neighbours.
+ *
+ * A Buffer in the heap is a HeapBuffer, a view of a range of a page. name()
+ * is the name of the page and offset() the start of the range, so Meshes in
+ * the same page share a vertex array and are drawn with a base vertex and
+ * first index instead.
+ *
+ * The Rendering API implements the storage of the pages.
+ * @see HeapBuffer
+ * @see Renderer::get_geometry_heap()
+ */
+class GeometryHeap : public std::enable_shared_from_this<GeometryHeap> {
+public:
+  /**
+   * @brief Construct a new GeometryHeap.
+   * @details No page is allocated until the first Buffer is stored.
+   *
+   * @param page_size The size in bytes of each page. Larger Buffers get a page
+   * of their own size.
+   */
+  GeometryHeap(size_t page_size) : page_size_(page_size) {}
+  /**
+   * @brief Destroy the GeometryHeap.
+   * @details The implementations release their pages with destroy_pages().
+   */
+  virtual ~GeometryHeap() {}
+  /**
+   * @brief Copy a Buffer into the heap.
+   * @details The returned Buffer has the same size and BufferFormat as \p
+   * source and is BufferType::STATIC. \p source is not changed.
+   *
+   * @tparam <T> The type of data stored in the Buffer.
+   * @param source The Buffer to copy.
+   * @param alignment The start of the copy is a multiple of \p alignment
+   * bytes. Geometry Buffers are aligned to their stride so the start is a
+   * whole vertex.
+   * @return The copy of \p source in the heap.
+   */
+  template <typename T>
+  Referenced<Buffer<T>> store(Buffer<T> &source, size_t alignment);
+  /**
+   * @brief Check if a Buffer is stored in the heap.
+   *
+   * @param buffer The Buffer.
+   * @return true if \p buffer is a view of one of the pages.
+   */
+  bool contains(const IBuffer &buffer) const;
+  /**
+   * @brief Move the Buffers of each page to the start of the page so the free
+   * space of the page is a single range.
+   * @details Buffers never move to another page, so the vertex arrays of the
+   * Meshes stay valid and only the offsets of the Buffers change. Pages left
+   * without Buffers are released.
+   */
+  void defragment();
+  /**
+   * @brief Get the usage of the heap.
+   *
+   * @return The GeometryHeapStats.
+   */
+  GeometryHeapStats get_stats() const;
+  /**
+   * @brief Get the size of a page.
+   *
+   * @return The size in bytes of a page.
+   */
+  size_t get_page_size() const { return page_size_; }
+
+protected:
+  /**
+   * @brief Allocate a page from the Rendering API.
+   *
+   * @param size The size in bytes of the page.
+   * @return The name of the page.
+   */
+  virtual uint32_t create_page(size_t size) = 0;
+  /**
+   * @brief Release a page to the Rendering API.
+   *
+   * @param name The name of the page.
+   */
+  virtual void destroy_page(uint32_t name) = 0;
+  /**
+   * @brief Write data into a page.
+   *
+   * @param name The name of the page.
+   * @param offset The offset in bytes to write to.
+   * @param data The data to write.
+   * @param size The size in bytes of the data.
+   */
+  virtual void write_page(uint32_t name, size_t offset, const void *data,
+                          size_t size) = 0;
+  /**
+   * @brief Read data from a page.
+   *
+   * @param name The name of the page.
+   * @param offset The offset in bytes to read from.
+   * @param data Allocated memory at least \p size bytes large.
+   * @param size The size in bytes of the data.
+   */
+  virtual void read_page(uint32_t name, size_t offset, void *data,
+                         size_t size) const = 0;
+  /**
+   * @brief Move data to a lower offset within a page.
+   * @details The ranges may overlap.
+   *
+   * @param name The name of the page.
+   * @param from The offset in bytes of the data.
+   * @param to The offset in bytes to move the data to.
+   * @param size The size in bytes of the data.
+   */
+  virtual void move_in_page(uint32_t name, size_t from, size_t to,
+                            size_t size) = 0;
+  /**
+   * @brief Copy a Buffer into a page without reading it back to the client.
+   *
+   * @param source The Buffer to copy.
+   * @param name The name of the page.
+   * @param offset The offset in bytes to copy to.
+   * @param size The size in bytes to copy.
+   * @return false if the Rendering API can not copy between buffers, the
+   * Buffer is then read and written with write_page().
+   */
+  virtual bool copy_to_page(const IBuffer &source, uint32_t name,
+                            size_t offset, size_t size) {
+    return false;
+  }
+  /**
+   * @brief Release every page with destroy_page().
+   * @details Called by the destructor of the implementations.
+   */
+  void destroy_pages();
+
+private:
+  template <typename T> friend class HeapBuffer;
+  /**
+   * @brief A range of a page owned by a HeapBuffer.
+   */
+  struct Allocation {
+    uint32_t page{0};    /**< The index of the page.*/
+    size_t offset{0};    /**< The offset in bytes into the page.*/
+    size_t size{0};      /**< The size in bytes.*/
+    size_t alignment{1}; /**< The offset is a multiple of the alignment.*/
+    bool live{false};    /**< Is the range owned by a HeapBuffer?*/
+  };
+  /**
+   * @brief A buffer allocated from the Rendering API.
+   */
+  struct Page {
+    uint32_t name{0}; /**< The name of the page, 0 if it was released.*/
+    size_t size{0};   /**< The size in bytes of the page.*/
+    std::map<size_t, size_t>
+        free_offsets{}; /**< The size of each free range by its offset.*/
+    std::set<std::pair<size_t, size_t>>
+        free_sizes{}; /**< The size and offset of each free range, ordered
+                         for the best fit.*/
+  };
+  /**
+   * @brief Allocate a range from the free lists, allocating a page if no free
+   * range fits.
+   *
+   * @param size The size in bytes of the range.
+   * @param alignment The offset of the range is a multiple of \p alignment.
+   * @return The handle of the Allocation.
+   */
+  uint32_t allocate(size_t size, size_t alignment);
+  /**
+   * @brief Return a range to the free list of its page.
+   *
+   * @param handle The handle of the Allocation.
+   */
+  void free(uint32_t handle);
+  /**
+   * @brief Find the best fitting free range of a page.
+   *
+   * @param page The page to search.
+   * @param size The size in bytes of the range.
+   * @param alignment The offset of the range is a multiple of \p alignment.
+   * @param offset Set to the aligned offset of the range if one is found.
+   * @return An iterator to the free range or Page::free_sizes.end().
+   */
+  static std::set<std::pair<size_t, size_t>>::iterator
+  best_fit(Page &page, size_t size, size_t alignment, size_t &offset);
+  /**
+   * @brief Insert a free range into a page, merging it with its neighbours.
+   *
+   * @param page The page.
+   * @param offset The offset in bytes of the range.
+   * @param size The size in bytes of the range.
+   */
+  static void insert_free(Page &page, size_t offset, size_t size);
+  /**
+   * @brief Remove a free range from a page.
+   *
+   * @param page The page.
+   * @param offset The offset in bytes of the range.
+   */
+  static void erase_free(Page &page, size_t offset);
+  /**
+   * @brief Round an offset up to a multiple of an alignment.
+   *
+   * @param offset The offset.
+   * @param alignment The alignment, does not have to be a power of 2.
+   * @return The aligned offset.
+   */
+  static size_t align(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+  size_t page_size_;                      /**< The size of a page.*/
+  std::vector<Page> pages_{};             /**< The pages.*/
+  std::vector<Allocation> allocations_{}; /**< The Allocation of a handle.*/
+  std::vector<uint32_t> free_handles_{};  /**< Handles of freed Allocations.*/
+  uint32_t defragmentations_{0};          /**< Calls to defragment().*/
+  size_t bytes_moved_{0};                 /**< Bytes moved by defragment().*/
+};
+
+/**
+ * @brief A Buffer that is a view of a range of a GeometryHeap page.
+ * @details A HeapBuffer is BufferType::STATIC. It can be read and bound like
+ * any other Buffer, name() is the page and offset() the start of the range in
+ * the page. The offset may change when the GeometryHeap is defragmented. The
+ * range is returned to the heap when the HeapBuffer is destroyed.
+ *
+ * @tparam <T> The type of data stored in the Buffer.
+ * @see GeometryHeap::store()
+ */
+template <typename T> class HeapBuffer : public Buffer<T> {
+public:
+  using IBuffer::buffer_ID_;
+  using IBuffer::count_;
+  using IBuffer::size_;
+  using IBuffer::type_;
+  /**
+   * @brief Construct a new HeapBuffer from an Allocation of a GeometryHeap.
+   *
+   * @param heap The GeometryHeap. Kept alive by the HeapBuffer.
+   * @param handle The handle of the Allocation.
+   */
+  HeapBuffer(Referenced<GeometryHeap> heap, uint32_t handle)
+      // The data is written by the GeometryHeap, which a STATIC Buffer
+      // without data would complain about
+      : Buffer<T>(nullptr, heap->allocations_[handle].size,
+                  BufferType::READ_ONLY),
+        heap_(std::move(heap)), handle_(handle) {
+    type_ = BufferType::STATIC;
+    count_ = static_cast<uint32_t>(size_ / sizeof(T));
+    buffer_ID_ = heap_->pages_[heap_->allocations_[handle_].page].name;
+  }
+  /**
+   * @brief Destroy the HeapBuffer and free its range.
+   */
+  ~HeapBuffer() { heap_->free(handle_); }
+  /**
+   * @brief Get the offset of the range in the page.
+   *
+   * @return The offset in bytes into the page named by name().
+   */
+  size_t offset() const override {
+    return heap_->allocations_[handle_].offset;
+  }
+  /**
+   * @brief A HeapBuffer is BufferType::STATIC and can not be flushed.
+   */
+  void flush(T *data, uint32_t offset_index, size_t size_in_bytes) override {
+    assert(type_ != BufferType::STATIC); // Buffer must not be static
+  }
+  /**
+   * @brief A HeapBuffer is BufferType::STATIC and can not be written to.
+   */
+  T &operator[](uint32_t i) override {
+    assert(type_ != BufferType::STATIC); // Buffer must not be static
+    return element_;
+  }
+  /**
+   * @brief Read a single element from the page.
+   *
+   * @param i The index into the Buffer.
+   * @return <T> A copy of the data at the provided index.
+   */
+  T operator[](uint32_t i) const override {
+    T element;
+    read(&element, i, sizeof(T));
+    return element;
+  }
+  /**
+   * @brief Copy data from the page.
+   *
+   * @param data A pointer to allocated memory at least \p size_in_bytes large.
+   * @param offset_index The index into the buffer to start reading from.
+   * @param size_in_bytes The size in bytes of the data to read.
+   */
+  void read(T *data, uint32_t offset_index,
+            size_t size_in_bytes) const override {
+    assert(size_in_bytes + offset_index * sizeof(T) <=
+           size_); // buffer must contain the data to read
+    heap_->read_page(buffer_ID_, offset() + offset_index * sizeof(T), data,
+                     size_in_bytes);
+  }
+  /**
+   * @brief A HeapBuffer is never multibuffered so this does nothing.
+   */
+  void wait_buffer() override {}
+  /**
+   * @brief A HeapBuffer is never multibuffered so this does nothing.
+   */
+  void lock_buffer() override {}
+  /**
+   * @brief A HeapBuffer is BufferType::STATIC and can not be cleared.
+   */
+  void clear(T value) override {
+    assert(type_ != BufferType::STATIC); // Buffer must not be static
+  }
+
+private:
+  Referenced<GeometryHeap> heap_; /**< The GeometryHeap of the range.*/
+  uint32_t handle_;               /**< The handle of the Allocation.*/
+  T element_{}; /**< Returned by the non-const subscript operator, which a
+                   STATIC Buffer does not support.*/
+};
+
+template <typename T>
+Referenced<Buffer<T>> GeometryHeap::store(Buffer<T> &source,
+                                          size_t alignment) {
+  size_t size = source.size();
+  uint32_t handle = allocate(size, alignment);
+  const Allocation &allocation = allocations_[handle];
+  uint32_t name = pages_[allocation.page].name;
+  if (!copy_to_page(source, name, allocation.offset, size)) {
+    std::vector<T> data(size / sizeof(T));
+    source.read(data.data(), 0, size);
+    write_page(name, allocation.offset, data.data(), size);
+  }
+  Referenced<Buffer<T>> buffer =
+      gen_ref<HeapBuffer<T>>(shared_from_this(), handle);
+  if (source.format().stride) {
+    buffer->set_format(source.format());
+  }
+  return buffer;
+}
+
+} // namespace mare
+
+#endif
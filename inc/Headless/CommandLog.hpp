@@ -0,0 +1,127 @@
+#ifndef COMMANDLOG
+#define COMMANDLOG
+
+// MARE
+#include "Mare.hpp"
+
+// Standard Library
+#include <array>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief The type of a Command recorded by the headless Rendering API.
+ */
+enum class CommandType {
+  CLEAR_COLOR = 0,   /**< Clear the color buffer.*/
+  CLEAR_DEPTH,       /**< Clear the depth buffer.*/
+  VIEWPORT,          /**< Resize the viewport.*/
+  SET_STATE,         /**< Enable or disable a render state.*/
+  BIND_FRAMEBUFFER,  /**< Bind a Framebuffer, name 0 is the default.*/
+  USE_SHADER,        /**< Bind a Shader for rendering.*/
+  BIND_RENDER_STATE, /**< Bind the render state of a Mesh.*/
+  UPLOAD_UNIFORM,    /**< Upload a value uniform to a Shader.*/
+  UPLOAD_BUFFER,     /**< Bind a uniform or storage Buffer to a Shader.*/
+  UPLOAD_TEXTURE,    /**< Bind a Texture2D to a Shader.*/
+  DRAW,              /**< Draw a Mesh.*/
+  DRAW_INSTANCED,    /**< Draw instances of a Mesh.*/
+  DRAW_INDIRECT,     /**< Multi-draw a batch of Meshes.*/
+  DISPATCH_COMPUTE,  /**< Dispatch a compute Shader.*/
+  BARRIER,           /**< Place a memory barrier.*/
+  READ_PIXELS,       /**< Read back from the framebuffer.*/
+  BIND_UNIFORM,      /**< Bind a uniform Buffer at a shared binding.*/
+  COUNT              /**< The number of CommandTypes.*/
+};
+
+/**
+ * @brief A single command recorded by the headless Rendering API.
+ * @details The meaning of the fields depends on the CommandType. name is the
+ * name of the object the command operates on, key is a hash of the uniform
+ * name for uploads or the state for SET_STATE, count is the number of vertices
+ * or indices for draws and instances is the number of instances.
+ */
+struct Command {
+  CommandType type; /**< The type of the command.*/
+  uint32_t name;    /**< The name of the object the command operates on.*/
+  uint32_t key;     /**< The hashed uniform name or state.*/
+  uint32_t count;   /**< The number of elements the command operates on.*/
+  uint32_t instances; /**< The number of instances drawn.*/
+};
+
+/**
+ * @brief An in-memory log of the commands issued to the headless Rendering
+ * API.
+ * @details The log keeps its capacity between frames, so recording a frame
+ * does not allocate once the log has grown to the size of a frame. Command
+ * counts are always kept even when recording of the individual commands is
+ * disabled.
+ */
+class CommandLog {
+public:
+  /**
+   * @brief Record a command.
+   *
+   * @param command The command to record.
+   */
+  inline void record(const Command &command) {
+    counts_[static_cast<size_t>(command.type)]++;
+    if (recording_) {
+      commands_.push_back(command);
+    }
+  }
+  /**
+   * @brief Clear the recorded commands and counts.
+   */
+  inline void clear() {
+    commands_.clear();
+    counts_.fill(0);
+  }
+  /**
+   * @brief Enable or disable recording of the individual commands.
+   *
+   * @param recording true to store each command, false to only count them.
+   */
+  inline void set_recording(bool recording) { recording_ = recording; }
+  /**
+   * @brief Get the number of commands of a type recorded since the last
+   * clear().
+   *
+   * @param type The CommandType to count.
+   * @return The number of commands of that type.
+   */
+  inline size_t count(CommandType type) const {
+    return counts_[static_cast<size_t>(type)];
+  }
+  /**
+   * @brief Get the recorded commands.
+   *
+   * @return A const reference to the recorded commands in issue order.
+   */
+  inline const std::vector<Command> &commands() const { return commands_; }
+  /**
+   * @brief Hash a uniform name to store in Command::key.
+   * @details Uses 32-bit FNV-1a so no string has to be copied.
+   *
+   * @param name The null terminated name to hash.
+   * @return The hash of the name.
+   */
+  static uint32_t hash(const char *name) {
+    uint32_t hash = 2166136261u;
+    while (name && *name) {
+      hash ^= static_cast<uint8_t>(*name++);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+private:
+  std::vector<Command> commands_; /**< The recorded commands.*/
+  std::array<size_t, static_cast<size_t>(CommandType::COUNT)>
+      counts_{}; /**< Number of commands of each type.*/
+  bool recording_{true}; /**< Store each command?*/
+};
+
+} // namespace mare
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef HEADLESSBUFFERS
+#define HEADLESSBUFFERS
+
+// MARE
+#include "Buffers.hpp"
+#include "GeometryHeap.hpp"
+#include "Mare.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace mare {
+
+namespace headless {
+/**
+ * @brief Generate a unique name for a headless object.
+ * @details Names start at 1 so that 0 keeps its meaning of "no object" like it
+ * does for the other Rendering APIs.
+ *
+ * @return A new unique name.
+ */
+uint32_t gen_name();
+} // namespace headless
+
+/**
+ * @brief A Buffer stored in host memory for the headless Rendering API.
+ * @details All BufferTypes are backed by a plain `std::vector`, including the
+ * swap chain of multibuffered types, so the same access rules as a GLBuffer
+ * apply but no GPU or driver is required.
+ *
+ * @tparam <T> The type of data stored in the Buffer.
+ * @see Buffer
+ * @see HeadlessRenderer
+ */
+template <typename T> class HostBuffer : public Buffer<T> {
+public:
+  using IBuffer::buffer_ID_;
+  using IBuffer::buffer_index_;
+  using IBuffer::count_;
+  using IBuffer::num_buffers_;
+  using IBuffer::size_;
+  using IBuffer::type_;
+  /**
+   * @brief Construct a new HostBuffer.
+   *
+   * @param data A pointer to the data used to initialize the buffer. Can be
+   * nullptr is BufferType is not BufferType::STATIC.
+   * @param size_in_bytes The size in bytes of the buffer. This is the size of a
+   * single buffer if the BufferType is multibuffered.
+   * @param buffer_type Specifies the access and storage properties of the
+   * Buffer.
+   */
+  HostBuffer(T *data, size_t size_in_bytes,
+             BufferType buffer_type = BufferType::STATIC)
+      : Buffer<T>(data, size_in_bytes, buffer_type),
+        elements_per_buffer_(size_in_bytes / sizeof(T)) {
+    buffer_ID_ = headless::gen_name();
+    storage_.resize(num_buffers_ * elements_per_buffer_);
+    if (data) {
+      for (uint8_t i = 0; i < num_buffers_; i++) {
+        std::copy(data, data + elements_per_buffer_,
+                  storage_.begin() + i * elements_per_buffer_);
+      }
+    }
+  }
+  /**
+   * @brief Destroy the HostBuffer.
+   */
+  ~HostBuffer() {}
+  /**
+   * @brief Flush the Buffer with new data.
+   * @details Only the active buffer in the swap chain is written to.
+   *
+   * @param data A pointer to the data to flush the buffer with.
+   * @param offset_index The index into the buffer where the new data will
+   * start.
+   * @param size_in_bytes The size in bytes of the data to be written.
+   */
+  void flush(T *data, uint32_t offset_index, size_t size_in_bytes) override {
+    assert(type_ != BufferType::STATIC);    // Buffer must not be static
+    assert(type_ != BufferType::READ_ONLY); // Buffer must not be read only
+    assert(size_in_bytes + offset_index * sizeof(T) <=
+           size_); // buffer must have enough space to flush data
+    size_t count = size_in_bytes / sizeof(T);
+    count_ = std::max(static_cast<uint32_t>(count) + offset_index, count_);
+    std::copy(data, data + count,
+              storage_.begin() + buffer_index_ * elements_per_buffer_ +
+                  offset_index);
+  }
+  /**
+   * @brief Provides write access to the active buffer in the swap chain.
+   *
+   * @param i The index into the Buffer.
+   * @return <T>& A reference into the buffer at the provided index.
+   */
+  T &operator[](uint32_t i) override {
+    assert(type_ != BufferType::STATIC);    // Buffer must not be static
+    assert(type_ != BufferType::READ_ONLY); // Buffer must not be read only
+    assert(type_ != BufferType::DYNAMIC);   // Buffer must be mapped
+    return storage_[buffer_index_ * elements_per_buffer_ + i];
+  }
+  /**
+   * @brief Provides read access to the active buffer in the swap chain.
+   *
+   * @param i The index into the Buffer.
+   * @return <T> A copy of the data at the provided index.
+   */
+  T operator[](uint32_t i) const override {
+    assert(type_ != BufferType::DYNAMIC); // Buffer must be mapped
+    return storage_[buffer_index_ * elements_per_buffer_ + i];
+  }
+  /**
+   * @brief Copy data from the active buffer in the swap chain.
+   *
+   * @param data A pointer to allocated memory at least \p size_in_bytes large.
+   * @param offset_index The index into the buffer to start reading from.
+   * @param size_in_bytes The size in bytes of the data to read.
+   */
+  void read(T *data, uint32_t offset_index,
+            size_t size_in_bytes) const override {
+    assert(size_in_bytes + offset_index * sizeof(T) <=
+           size_); // buffer must contain the data to read
+    auto begin =
+        storage_.begin() + buffer_index_ * elements_per_buffer_ + offset_index;
+    std::copy(begin, begin + size_in_bytes / sizeof(T), data);
+  }
+  /**
+   * @brief There is no GPU to synchronize with so this does nothing.
+   */
+  void wait_buffer() override {}
+  /**
+   * @brief There is no GPU to synchronize with so this does nothing.
+   */
+  void lock_buffer() override {}
+  /**
+   * @brief Clear the active buffer in the swap chain to a uniform value.
+   *
+   * @param value The value used to clear the Buffer.
+   */
+  void clear(T value) override {
+    assert(type_ != BufferType::STATIC);    // Buffer must not be static
+    assert(type_ != BufferType::READ_ONLY); // Buffer must not be read only
+    assert(type_ != BufferType::DYNAMIC);   // Buffer must be mapped
+    auto begin = storage_.begin() + buffer_index_ * elements_per_buffer_;
+    std::fill(begin, begin + count_, value);
+  }
+
+private:
+  size_t elements_per_buffer_; /**< Number of elements in a single buffer of
+                                  the swap chain.*/
+  std::vector<T> storage_;     /**< Host storage of the whole swap chain.*/
+};
+
+/**
+ * @brief A Texture2D for the headless Rendering API.
+ * @details Only the properties of the texture are stored, no pixel data is
+ * kept in memory.
+ */
+class HostTexture2D : public Texture2D {
+public:
+  /**
+   * @brief Construct a new HostTexture2D from an image file.
+   * @details Only the image header is read to obtain the size and number of
+   * channels.
+   *
+   * @param filepath The filepath to the image.
+   */
+  HostTexture2D(const char *filepath);
+  /**
+   * @brief Construct a new uninitialized HostTexture2D.
+   *
+   * @param type The TextureType of the texture.
+   * @param width The width in pixels of the texture.
+   * @param height The height in pixels of the texture.
+   */
+  HostTexture2D(TextureType type, int width, int height);
+  /**
+   * @brief Destroy the HostTexture2D.
+   */
+  virtual ~HostTexture2D() {}
+};
+
+/**
+ * @brief A Framebuffer for the headless Rendering API.
+ * @details Contains a HostTexture2D for depth and color with the same formats
+ * as a GLFramebuffer.
+ */
+class HostFramebuffer : public Framebuffer {
+public:
+  /**
+   * @brief Construct a new HostFramebuffer.
+   *
+   * @param width The width in pixels of the Framebuffer.
+   * @param height The height in pixels of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
+   */
+  HostFramebuffer(int width, int height,
+                  TextureType color_type = TextureType::RGBA32F);
+  /**
+   * @brief Destroy the HostFramebuffer.
+   */
+  virtual ~HostFramebuffer() {}
+};
+
+/**
+ * @brief A GeometryHeap for the headless Rendering API.
+ * @details Each page is a `std::vector` of bytes.
+ * @see GeometryHeap
+ */
+class HostGeometryHeap : public GeometryHeap {
+public:
+  /**
+   * @brief Construct a new HostGeometryHeap.
+   *
+   * @param page_size The size in bytes of each page.
+   */
+  HostGeometryHeap(size_t page_size) : GeometryHeap(page_size) {}
+  /**
+   * @brief Destroy the HostGeometryHeap and its pages.
+   */
+  ~HostGeometryHeap() { destroy_pages(); }
+
+protected:
+  uint32_t create_page(size_t size) override;
+  void destroy_page(uint32_t name) override;
+  void write_page(uint32_t name, size_t offset, const void *data,
+                  size_t size) override;
+  void read_page(uint32_t name, size_t offset, void *data,
+                 size_t size) const override;
+  void move_in_page(uint32_t name, size_t from, size_t to,
+                    size_t size) override;
+
+private:
+  std::unordered_map<uint32_t, std::vector<uint8_t>>
+      storage_{}; /**< The bytes of each page by its name.*/
+};
+
+} // namespace mare
+
+#endif
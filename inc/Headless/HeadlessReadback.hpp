@@ -0,0 +1,70 @@
+#ifndef HEADLESSREADBACK
+#define HEADLESSREADBACK
+
+// MARE
+#include "Buffers.hpp"
+#include "Headless/CommandLog.hpp"
+#include "Readback.hpp"
+
+// Standard Library
+#include <deque>
+#include <vector>
+
+namespace mare {
+/**
+ * @brief Asynchronous pixel reads for the headless Rendering API.
+ * @details There is no depth buffer, so every pixel reads the cleared depth of
+ * 1 and every ID reads 0. Each batch is recorded as a READ_PIXELS command and
+ * finishes on the next poll, one frame after it was started like it would on a
+ * GPU.
+ */
+class HeadlessPixelReader : public PixelReader {
+public:
+  /**
+   * @brief Construct a new HeadlessPixelReader.
+   *
+   * @param log The CommandLog to record the reads into.
+   */
+  HeadlessPixelReader(CommandLog &log) : log_(log) {}
+  bool read(const std::vector<glm::ivec2> &pixels) override {
+    log_.record({CommandType::READ_PIXELS, 0, 0,
+                 static_cast<uint32_t>(pixels.size()), 0});
+    batches_.push_back(pixels.size());
+    return true;
+  }
+  bool poll(std::vector<float> &depths) override {
+    if (batches_.empty()) {
+      return false;
+    }
+    depths.assign(batches_.front(), 1.0f);
+    batches_.pop_front();
+    return true;
+  }
+  bool read_ids(Framebuffer *framebuffer,
+                const std::vector<PixelRect> &rects) override {
+    size_t count = 0;
+    for (auto &rect : rects) {
+      count += rect.area();
+    }
+    log_.record({CommandType::READ_PIXELS, framebuffer->name(), 0,
+                 static_cast<uint32_t>(count), 0});
+    id_batches_.push_back(count);
+    return true;
+  }
+  bool poll_ids(std::vector<uint32_t> &ids) override {
+    if (id_batches_.empty()) {
+      return false;
+    }
+    ids.assign(id_batches_.front(), 0);
+    id_batches_.pop_front();
+    return true;
+  }
+
+private:
+  CommandLog &log_;                 /**< The log of the headless Renderer.*/
+  std::deque<size_t> batches_{};    /**< The size of each depth batch.*/
+  std::deque<size_t> id_batches_{}; /**< The size of each ID batch.*/
+};
+} // namespace mare
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef HEADLESSRENDERER
+#define HEADLESSRENDERER
+
+// MARE
+#include "Headless/CommandLog.hpp"
+#include "Headless/HeadlessReadback.hpp"
+#include "Meshes.hpp"
+#include "Renderer.hpp"
+
+// Standard Library
+#include <string>
+
+namespace mare {
+/**
+ * @brief A Rendering API that runs without a window or GPU.
+ * @details Every api_* call is recorded into an in-memory CommandLog instead of
+ * being sent to a driver and Buffers are backed by host memory. The whole
+ * Entity, System, Mesh and Material pipeline runs exactly as it does with the
+ * GLRenderer, so the CPU cost of a frame can be measured on machines without a
+ * GPU. Frames are stepped with a fixed simulated frame time.
+ * @see RendererAPI::Headless
+ * @see CommandLog
+ */
+class HeadlessRenderer : public Renderer {
+public:
+  /**
+   * @brief The headless implementation of the main driver function.
+   * @details Initializes the Renderer and runs frames until end_renderer() is
+   * called or the frame limit is reached.
+   */
+  void run() final;
+  /**
+   * @brief Initialize the headless Renderer. No window is created.
+   */
+  void init_renderer() final;
+  /**
+   * @brief Run the render loop.
+   * @details The CommandLog is cleared at the start of every frame so it
+   * always holds the commands of the last frame.
+   */
+  void start_renderer() final;
+
+  std::string api_get_vendor_string() override;
+  std::string api_get_version_string() override;
+  std::string api_get_renderer_string() override;
+  void api_set_clipboard_string(std::string str) override;
+  std::string api_get_clipboard_string() override;
+  void api_set_window_title(const char *title) override;
+  void api_set_cursor(CursorType type) override;
+  void api_clear_color_buffer(glm::vec4 color) override;
+  void api_clear_color_buffer(glm::uvec4 color) override;
+  void api_clear_depth_buffer() override;
+  void api_resize_viewport(int width, int height) override;
+  void api_wireframe_mode(bool wireframe) override;
+  void api_enable_primative_restart(bool enable, uint32_t index) override;
+  void api_enable_depth_testing(bool enable) override;
+  void api_enable_face_culling(bool enable) override;
+  void api_enable_blending(bool enable) override;
+  void api_enable_polygon_offset(bool enable, float factor,
+                                 float units) override;
+  /**
+   * @brief Unproject the mouse position at the far plane.
+   * @details There is no depth buffer, so the depth is always the cleared
+   * depth of 1.
+   */
+  glm::vec3 api_raycast(Camera *camera) override;
+  /**
+   * @brief Unproject a screen position at the far plane.
+   * @details There is no depth buffer, so the depth is always the cleared
+   * depth of 1.
+   */
+  glm::vec3 api_raycast(Camera *camera, glm::ivec2 screen_coords) override;
+  void api_set_framebuffer(Framebuffer *framebuffer) override;
+  void api_bind_uniform_buffer(uint32_t binding, IBuffer *uniform) override;
+  Scoped<Texture2D> api_gen_texture2D(const char *image_filepath) override;
+  Scoped<Texture2D> api_gen_texture2D(TextureType type, int width,
+                                      int height) override;
+  Scoped<Framebuffer> api_gen_framebuffer(int width, int height,
+                                          TextureType color_type) override;
+  Scoped<Shader> api_gen_shader(const char *directory) override;
+  void api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                              Material *material) override;
+  void api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                              Material *material,
+                              Transform *parent_transform) override;
+  void api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                              Material *material, Transform *parent_transform,
+                              unsigned int instance_count,
+                              Buffer<Transform> *models) override;
+  void api_render_simple_mesh_indirect(Camera *camera, SimpleMesh *mesh,
+                                       Material *material,
+                                       Transform *parent_transform,
+                                       Buffer<DrawCommand> *commands,
+                                       unsigned int draw_count,
+                                       Buffer<Transform> *models) override;
+  void api_draw_simple_mesh(SimpleMesh *mesh, Material *material,
+                            unsigned int instance_count) override;
+  void api_draw_simple_mesh_indirect(SimpleMesh *mesh, Material *material,
+                                     Buffer<DrawCommand> *commands,
+                                     unsigned int draw_count) override;
+  void api_bind_mesh_render_state(SimpleMesh *mesh,
+                                  Material *material) override;
+  void api_destroy_mesh_render_states(SimpleMesh *mesh) override;
+  void api_push_mesh_geometry_buffer(
+      SimpleMesh *mesh, Referenced<Buffer<float>> geometry_buffer) override;
+  void api_set_mesh_index_buffer(
+      SimpleMesh *mesh, Referenced<Buffer<uint32_t>> index_buffer) override;
+  void api_dispatch_compute(uint32_t x, uint32_t y, uint32_t z) override;
+
+  /**
+   * @brief Get the CommandLog holding the commands of the last frame.
+   *
+   * @return The CommandLog.
+   */
+  const CommandLog &get_command_log() const { return log_; }
+  /**
+   * @brief Get the number of frames run so far.
+   *
+   * @return The number of frames.
+   */
+  uint64_t get_frame_count() const { return frame_count_; }
+  /**
+   * @brief Get the wall-clock CPU time of the last frame.
+   *
+   * @return The time in seconds.
+   */
+  double get_last_frame_time() const { return last_frame_time_; }
+  /**
+   * @brief Get the total wall-clock CPU time of all frames run so far.
+   *
+   * @return The time in seconds.
+   */
+  double get_total_frame_time() const { return total_frame_time_; }
+
+protected:
+  /**
+   * @brief Set the number of frames to run before the render loop ends.
+   *
+   * @param frame_limit The number of frames, 0 runs until end_renderer() is
+   * called.
+   */
+  void set_frame_limit(uint64_t frame_limit) { frame_limit_ = frame_limit; }
+  /**
+   * @brief Set the simulated time between frames.
+   *
+   * @param frame_time The time in seconds passed to the Systems every frame.
+   */
+  void set_frame_time(float frame_time) { frame_time_ = frame_time; }
+  /**
+   * @brief Enable or disable recording of the individual commands.
+   * @details When disabled only the counts of each CommandType are kept which
+   * removes the cost of recording from the measured frame time.
+   *
+   * @param recording true to store each command.
+   */
+  void set_command_recording(bool recording) {
+    log_.set_recording(recording);
+  }
+
+private:
+  /**
+   * @brief Record the draw of a SimpleMesh.
+   *
+   * @param mesh The SimpleMesh drawn.
+   * @param material The Material the SimpleMesh is drawn with.
+   * @param instance_count The number of instances drawn, 0 if not instanced.
+   */
+  void record_draw(SimpleMesh *mesh, Material *material,
+                   unsigned int instance_count);
+  CommandLog log_;               /**< The commands of the last frame.*/
+  HeadlessPixelReader pixel_reader_{log_}; /**< Reads for raycast_async().*/
+  std::string clipboard_;        /**< The simulated clipboard.*/
+  uint64_t frame_limit_{0};      /**< Frames to run, 0 == unlimited.*/
+  uint64_t frame_count_{0};      /**< Frames run so far.*/
+  float frame_time_{1.0f / 60.0f}; /**< Simulated time between frames.*/
+  double last_frame_time_{0.0};  /**< CPU time of the last frame.*/
+  double total_frame_time_{0.0}; /**< CPU time of every frame.*/
+};
+} // namespace mare
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef HEADLESSSHADER
+#define HEADLESSSHADER
+
+// MARE
+#include "Buffers.hpp"
+#include "Headless/CommandLog.hpp"
+#include "Shader.hpp"
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+/**
+ * @brief A Shader for the headless Rendering API.
+ * @details Nothing is compiled. Binding the Shader and every upload is recorded
+ * into the CommandLog of the HeadlessRenderer that created it.
+ * @see HeadlessRenderer
+ */
+class HeadlessShader : public Shader {
+public:
+  /**
+   * @brief Construct a new HeadlessShader.
+   *
+   * @param directory The directory of the glsl Shader files. Not read.
+   * @param log The CommandLog to record into.
+   */
+  HeadlessShader(const char *directory, CommandLog *log);
+  ~HeadlessShader() {}
+  void use() const override;
+  void upload_int(const char *name, int value,
+                  bool suppress_warnings = false) override;
+  void upload_float(const char *name, float value,
+                    bool suppress_warnings = false) override;
+  void upload_vec2(const char *name, glm::vec2 value,
+                   bool suppress_warnings = false) override;
+  void upload_vec3(const char *name, glm::vec3 value,
+                   bool suppress_warnings = false) override;
+  void upload_vec4(const char *name, glm::vec4 value,
+                   bool suppress_warnings = false) override;
+  void upload_mat3(const char *name, glm::mat3 value,
+                   bool suppress_warnings = false) override;
+  void upload_mat4(const char *name, glm::mat4 value,
+                   bool suppress_warnings = false) override;
+  void upload_uniform(const char *name, IBuffer *uniform,
+                      bool suppress_warnings = false) override;
+  void upload_storage(const char *name, IBuffer *storage,
+                      bool suppress_warnings = false) override;
+  void upload_texture2D(const char *name, Texture2D *texture2D,
+                        bool suppress_warnings = false) override;
+  void upload_image2D(const char *name, Texture2D *texture2D,
+                      bool suppress_warnings = false) override;
+  void barrier(BarrierType type) override;
+
+private:
+  /**
+   * @brief Record an upload of a value uniform.
+   *
+   * @param name The name of the uniform.
+   * @param count The number of floats or ints uploaded.
+   */
+  void record_uniform(const char *name, uint32_t count);
+  CommandLog *log_; /**< The CommandLog to record into.*/
+};
+} // namespace mare
+
+#endif
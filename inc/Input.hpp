@@ -0,0 +1,428 @@
+#ifndef INPUT
+#define INPUT
+
+// Standard Library
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+/**
+ * @brief The keys of the keyboard.
+ * @details The values are the key codes of the US keyboard layout used by GLFW
+ * so a key code from the windowing library indexes the key state directly.
+ */
+enum class Key : uint16_t {
+  SPACE = 32,
+  APOSTROPHE = 39,
+  COMMA = 44,
+  MINUS = 45,
+  PERIOD = 46,
+  FORWARD_SLASH = 47,
+  ZERO = 48,
+  ONE = 49,
+  TWO = 50,
+  THREE = 51,
+  FOUR = 52,
+  FIVE = 53,
+  SIX = 54,
+  SEVEN = 55,
+  EIGHT = 56,
+  NINE = 57,
+  SEMICOLON = 59,
+  EQUAL = 61,
+  A = 65,
+  B = 66,
+  C = 67,
+  D = 68,
+  E = 69,
+  F = 70,
+  G = 71,
+  H = 72,
+  I = 73,
+  J = 74,
+  K = 75,
+  L = 76,
+  M = 77,
+  N = 78,
+  O = 79,
+  P = 80,
+  Q = 81,
+  R = 82,
+  S = 83,
+  T = 84,
+  U = 85,
+  V = 86,
+  W = 87,
+  X = 88,
+  Y = 89,
+  Z = 90,
+  LEFT_BRACKET = 91,
+  BACKSLASH = 92,
+  RIGHT_BRACKET = 93,
+  GRAVE_ACCENT = 96,
+  ESCAPE = 256,
+  ENTER = 257,
+  TAB = 258,
+  BACKSPACE = 259,
+  INSERT = 260,
+  DELETE = 261,
+  RIGHT = 262,
+  LEFT = 263,
+  DOWN = 264,
+  UP = 265,
+  PAGE_UP = 266,
+  PAGE_DOWN = 267,
+  HOME = 268,
+  END = 269,
+  CAPS_LOCK = 280,
+  SCROLL_LOCK = 281,
+  NUM_LOCK = 282,
+  PRINT_SCREEN = 283,
+  PAUSE = 284,
+  F1 = 290,
+  F2 = 291,
+  F3 = 292,
+  F4 = 293,
+  F5 = 294,
+  F6 = 295,
+  F7 = 296,
+  F8 = 297,
+  F9 = 298,
+  F10 = 299,
+  F11 = 300,
+  F12 = 301,
+  KEY_PAD_0 = 320,
+  KEY_PAD_1 = 321,
+  KEY_PAD_2 = 322,
+  KEY_PAD_3 = 323,
+  KEY_PAD_4 = 324,
+  KEY_PAD_5 = 325,
+  KEY_PAD_6 = 326,
+  KEY_PAD_7 = 327,
+  KEY_PAD_8 = 328,
+  KEY_PAD_9 = 329,
+  KEY_PAD_DECIMAL = 330,
+  KEY_PAD_DIVIDE = 331,
+  KEY_PAD_MULTIPLY = 332,
+  KEY_PAD_SUBTRACT = 333,
+  KEY_PAD_ADD = 334,
+  KEY_PAD_ENTER = 335,
+  KEY_PAD_EQUAL = 336,
+  LEFT_SHIFT = 340,
+  LEFT_CONTROL = 341,
+  LEFT_ALT = 342,
+  LEFT_SUPER = 343,
+  RIGHT_SHIFT = 344,
+  RIGHT_CONTROL = 345,
+  RIGHT_ALT = 346,
+  RIGHT_SUPER = 347,
+  MENU = 348,
+  COUNT = 349 /**< The number of key codes.*/
+};
+
+/**
+ * @brief The buttons of the mouse.
+ */
+enum class MouseButton : uint8_t {
+  LEFT = 0,
+  RIGHT = 1,
+  MIDDLE = 2,
+  COUNT = 8 /**< The number of mouse button codes.*/
+};
+
+/**
+ * @brief The types of raw input events.
+ */
+enum class InputEventType : uint8_t {
+  KEY_PRESS,     /**< A Key was pressed.*/
+  KEY_REPEAT,    /**< A held Key was repeated by the operating system.*/
+  KEY_RELEASE,   /**< A Key was released.*/
+  MOUSE_PRESS,   /**< A MouseButton was pressed.*/
+  MOUSE_RELEASE, /**< A MouseButton was released.*/
+  MOUSE_MOVE,    /**< The mouse was moved.*/
+  MOUSE_WHEEL,   /**< The mouse wheel was scrolled.*/
+  CHAR,          /**< A unicode character was typed.*/
+  RESIZE         /**< The window was resized.*/
+};
+
+/**
+ * @brief The kinds of events an IControlsSystem can listen to.
+ */
+enum class ControlsEvent : uint8_t {
+  KEY,          /**< IControlsSystem::on_key()*/
+  MOUSE_BUTTON, /**< IControlsSystem::on_mouse_button()*/
+  MOUSE_MOVE,   /**< IControlsSystem::on_mouse_move()*/
+  MOUSE_WHEEL,  /**< IControlsSystem::on_mouse_wheel()*/
+  RESIZE,       /**< IControlsSystem::on_resize()*/
+  CHAR,         /**< IControlsSystem::on_char()*/
+  COUNT         /**< The number of kinds of events.*/
+};
+/**
+ * @brief A set of ControlsEvents, one bit per kind of event.
+ */
+using ControlsEvents = std::bitset<static_cast<size_t>(ControlsEvent::COUNT)>;
+
+/**
+ * @brief A single raw input event.
+ */
+struct InputEvent {
+  InputEventType type{InputEventType::KEY_PRESS}; /**< The type of event.*/
+  uint32_t code{0}; /**< The Key, MouseButton or unicode code point.*/
+  glm::ivec2 value{}; /**< The mouse position, scroll direction in y or window
+                         size in pixels.*/
+  /**
+   * @brief Check if the event is the press of a Key.
+   *
+   * @param key The Key.
+   * @return true if this event pressed the Key.
+   */
+  bool pressed(Key key) const {
+    return type == InputEventType::KEY_PRESS &&
+           code == static_cast<uint32_t>(key);
+  }
+  /**
+   * @brief Check if the event is a repeat of a held Key.
+   *
+   * @param key The Key.
+   * @return true if this event repeated the Key.
+   */
+  bool repeated(Key key) const {
+    return type == InputEventType::KEY_REPEAT &&
+           code == static_cast<uint32_t>(key);
+  }
+  /**
+   * @brief Check if the event is the release of a Key.
+   *
+   * @param key The Key.
+   * @return true if this event released the Key.
+   */
+  bool released(Key key) const {
+    return type == InputEventType::KEY_RELEASE &&
+           code == static_cast<uint32_t>(key);
+  }
+  /**
+   * @brief Check if the event is the press of a MouseButton.
+   *
+   * @param button The MouseButton.
+   * @return true if this event pressed the MouseButton.
+   */
+  bool pressed(MouseButton button) const {
+    return type == InputEventType::MOUSE_PRESS &&
+           code == static_cast<uint32_t>(button);
+  }
+  /**
+   * @brief Check if the event is the release of a MouseButton.
+   *
+   * @param button The MouseButton.
+   * @return true if this event released the MouseButton.
+   */
+  bool released(MouseButton button) const {
+    return type == InputEventType::MOUSE_RELEASE &&
+           code == static_cast<uint32_t>(button);
+  }
+};
+
+/**
+ * @brief A fixed size ring buffer of the InputEvents of a single frame.
+ * @details When more events arrive in a frame than the queue can hold the
+ * oldest events are overwritten.
+ */
+class InputEventQueue {
+public:
+  /**
+   * @brief The number of events kept per frame.
+   */
+  static constexpr size_t capacity = 256;
+  /**
+   * @brief Append an event to the queue.
+   *
+   * @param event The InputEvent.
+   */
+  void push(const InputEvent &event) {
+    events_[(head_ + count_) % capacity] = event;
+    if (count_ < capacity) {
+      count_++;
+    } else {
+      head_ = (head_ + 1) % capacity;
+    }
+  }
+  /**
+   * @brief Remove every event from the queue.
+   */
+  void clear() {
+    head_ = 0;
+    count_ = 0;
+  }
+  /**
+   * @brief Get the number of events in the queue.
+   *
+   * @return The number of events.
+   */
+  size_t size() const { return count_; }
+  /**
+   * @brief Check if the queue is empty.
+   *
+   * @return true if there are no events in the queue.
+   */
+  bool empty() const { return count_ == 0; }
+  /**
+   * @brief Get an event from the queue, oldest first.
+   *
+   * @param index The index of the event, must be less than size().
+   * @return The InputEvent.
+   */
+  const InputEvent &operator[](size_t index) const {
+    return events_[(head_ + index) % capacity];
+  }
+  /**
+   * @brief Get the most recent event.
+   *
+   * @return The InputEvent, the queue must not be empty.
+   */
+  const InputEvent &back() const { return (*this)[count_ - 1]; }
+
+private:
+  std::array<InputEvent, capacity> events_{}; /**< The ring buffer.*/
+  size_t head_{0};                            /**< Index of the oldest event.*/
+  size_t count_{0};                           /**< Events in the queue.*/
+};
+
+/**
+ * @brief RendererInput contains the user input and is passed by reference to
+ * the callbacks which decide what to do.
+ * @details The keyboard and mouse buttons are stored as bitsets indexed by
+ * their codes. A snapshot of the bitsets is taken at the start of every frame
+ * before the windowing events are processed; the just pressed and just
+ * released state of every key is the XOR of the current bitset against that
+ * snapshot. Every raw event of the frame is also appended to an
+ * InputEventQueue which can be iterated by any System. Inside a ControlsSystem
+ * callback, event() is the event being handled.
+ */
+struct RendererInput {
+  short mouse_scroll{}; /**< 0 == no scroll, 1 == scroll up, -1 = scroll down*/
+  glm::ivec2 mouse_pos{}; /**< window coordinates of mouse position (in pixels
+                             from top left corner)*/
+  glm::ivec2 mouse_vel{}; /**< window coordinates of mouse velocity (in
+                             pixels/frame from top left corner)*/
+  InputEventQueue events{}; /**< The raw events of the current frame.*/
+
+  /**
+   * @brief Check if a Key is held down.
+   *
+   * @param key The Key.
+   * @return true if the Key is down.
+   */
+  bool pressed(Key key) const { return keys_[index(key)]; }
+  /**
+   * @brief Check if a Key went down since the last frame.
+   *
+   * @param key The Key.
+   * @return true if the Key was up last frame and is down now.
+   */
+  bool just_pressed(Key key) const {
+    size_t i = index(key);
+    return (keys_[i] ^ previous_keys_[i]) && keys_[i];
+  }
+  /**
+   * @brief Check if a Key went up since the last frame.
+   *
+   * @param key The Key.
+   * @return true if the Key was down last frame and is up now.
+   */
+  bool just_released(Key key) const {
+    size_t i = index(key);
+    return (keys_[i] ^ previous_keys_[i]) && !keys_[i];
+  }
+  /**
+   * @brief Check if a MouseButton is held down.
+   *
+   * @param button The MouseButton.
+   * @return true if the MouseButton is down.
+   */
+  bool pressed(MouseButton button) const { return buttons_[index(button)]; }
+  /**
+   * @brief Check if a MouseButton went down since the last frame.
+   *
+   * @param button The MouseButton.
+   * @return true if the MouseButton was up last frame and is down now.
+   */
+  bool just_pressed(MouseButton button) const {
+    size_t i = index(button);
+    return (buttons_[i] ^ previous_buttons_[i]) && buttons_[i];
+  }
+  /**
+   * @brief Check if a MouseButton went up since the last frame.
+   *
+   * @param button The MouseButton.
+   * @return true if the MouseButton was down last frame and is up now.
+   */
+  bool just_released(MouseButton button) const {
+    size_t i = index(button);
+    return (buttons_[i] ^ previous_buttons_[i]) && !buttons_[i];
+  }
+  /**
+   * @brief Get the event currently being handled.
+   * @details Use this in ControlsSystem callbacks to react to exactly the
+   * event that invoked the callback, even if the same key went down and up
+   * within one frame.
+   *
+   * @return The most recent InputEvent.
+   */
+  const InputEvent &event() const {
+    static const InputEvent none{};
+    return events.empty() ? none : events.back();
+  }
+
+  /**
+   * @brief Begin a new frame of input.
+   * @details Called by the Rendering API before the windowing events of a
+   * frame are processed. Snapshots the key state and clears the event queue.
+   */
+  void begin_frame() {
+    previous_keys_ = keys_;
+    previous_buttons_ = buttons_;
+    events.clear();
+  }
+  /**
+   * @brief Record a key event from the Rendering API.
+   *
+   * @param key The Key.
+   * @param type KEY_PRESS, KEY_REPEAT or KEY_RELEASE.
+   */
+  void key_event(Key key, InputEventType type) {
+    keys_[index(key)] = type != InputEventType::KEY_RELEASE;
+    events.push({type, static_cast<uint32_t>(key), mouse_pos});
+  }
+  /**
+   * @brief Record a mouse button event from the Rendering API.
+   *
+   * @param button The MouseButton.
+   * @param type MOUSE_PRESS or MOUSE_RELEASE.
+   */
+  void mouse_button_event(MouseButton button, InputEventType type) {
+    buttons_[index(button)] = type == InputEventType::MOUSE_PRESS;
+    events.push({type, static_cast<uint32_t>(button), mouse_pos});
+  }
+
+private:
+  static size_t index(Key key) { return static_cast<size_t>(key); }
+  static size_t index(MouseButton button) {
+    return static_cast<size_t>(button);
+  }
+  std::bitset<static_cast<size_t>(Key::COUNT)> keys_{}; /**< Keys down.*/
+  std::bitset<static_cast<size_t>(Key::COUNT)>
+      previous_keys_{}; /**< Keys down at the start of the frame.*/
+  std::bitset<static_cast<size_t>(MouseButton::COUNT)>
+      buttons_{}; /**< MouseButtons down.*/
+  std::bitset<static_cast<size_t>(MouseButton::COUNT)>
+      previous_buttons_{}; /**< MouseButtons down at the start of the frame.*/
+};
+
+} // namespace mare
+
+#endif
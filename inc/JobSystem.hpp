@@ -0,0 +1,93 @@
+#ifndef JOBSYSTEM
+#define JOBSYSTEM
+
+// MARE
+#include "Mare.hpp"
+
+// Standard Library
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mare {
+
+/**
+ * @brief A work-stealing thread pool used to run data parallel jobs.
+ * @details Each worker thread owns a queue of tasks. A worker pops tasks from
+ * the back of its own queue and, when it runs dry, steals tasks from the front
+ * of the other queues. The thread that calls parallel_for() also owns a queue
+ * and helps execute tasks until every task has finished, so parallel_for()
+ * acts as a barrier.
+ */
+class JobSystem {
+public:
+  /**
+   * @brief Construct a new JobSystem.
+   *
+   * @param thread_count The number of worker threads to spawn. If 0, one less
+   * than the number of hardware threads is used so the calling thread can also
+   * participate.
+   */
+  explicit JobSystem(unsigned int thread_count = 0);
+  /**
+   * @brief Destroy the JobSystem and join all of the worker threads.
+   */
+  ~JobSystem();
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+  /**
+   * @brief Split the range [0, count) into tasks and execute them on the
+   * thread pool.
+   * @details Blocks until every task has been executed. The job is called with
+   * the half open range [begin, end) of each task.
+   *
+   * @param count The number of items to process.
+   * @param grain_size The maximum number of items per task.
+   * @param job The function executed for each task.
+   */
+  void parallel_for(size_t count, size_t grain_size,
+                    const std::function<void(size_t, size_t)> &job);
+  /**
+   * @brief Get the number of worker threads in the pool.
+   *
+   * @return The number of worker threads, not including the calling thread.
+   */
+  unsigned int thread_count() const {
+    return static_cast<unsigned int>(workers_.size());
+  }
+
+private:
+  /**
+   * @brief A range of items to pass to a job.
+   */
+  struct Task {
+    const std::function<void(size_t, size_t)> *job{nullptr};
+    size_t begin{0};
+    size_t end{0};
+  };
+  /**
+   * @brief A task queue owned by a single thread.
+   */
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+  bool pop_task(size_t queue_index, Task &task);
+  void run_task(const Task &task);
+  void worker_loop(size_t queue_index);
+
+  std::vector<std::thread> workers_; /**< The worker threads.*/
+  std::vector<Scoped<WorkQueue>>
+      queues_; /**< One queue per worker plus one for the calling thread.*/
+  std::atomic<size_t> pending_{0}; /**< Tasks not yet finished.*/
+  std::atomic<bool> stopping_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+};
+
+} // namespace mare
+
+#endif
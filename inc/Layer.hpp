@@ -2,10 +2,17 @@
 #define LAYER
 
 // MARE
+#include "Archetypes.hpp"
 #include "Entities/Camera.hpp"
+#include "EntityPool.hpp"
+#include "SpatialIndex.hpp"
+#include "TransformHierarchy.hpp"
+#include "TypeIndex.hpp"
 
 // Standard Library
 #include <algorithm> // std::swap
+#include <array>
+#include <functional>
 
 namespace mare {
 /**
@@ -24,6 +31,12 @@ namespace mare {
  * Entity stack which can be used to *swap* with the parent Camera using the
  * Layer::swap_camera(Referenced<Camera>) function. This is not done by swaping
  * references but by actually swaping the data in the Cameras.
+ *
+ * Every Entity on the Entity stack is also given an EntityHandle that stays
+ * valid until the Entity is pulled. Entities generated by the Layer are
+ * allocated from a BlockPool. Pulled Entities are removed at the next sync
+ * point by compacting the Entity stack in a single pass, so the remaining
+ * Entities keep their order, which is the order they are rendered in.
  * @see Entity
  * @see System
  * @see Transform
@@ -35,7 +48,10 @@ public:
    *
    * @param type The ProjectionType of the base Camera object
    */
-  Layer(ProjectionType type) : Camera(type) {}
+  Layer(ProjectionType type) : Camera(type) {
+    // the Layer's own Systems were pushed before it was a Layer
+    controls_pending_.push_back(this);
+  }
   /**
    * @brief Virtual destructor of the Layer object.
    */
@@ -74,6 +90,23 @@ public:
    * @see Scene
    */
   virtual void on_exit() = 0;
+  /**
+   * @brief Draw the render packets of the Layer through the render queue.
+   * @details Off by default, so the packets are drawn in the order they are
+   * submitted. When on, the packets submitted while the Layer is rendered are
+   * sorted by state and drawn when the Layer is done.
+   *
+   * @param enable true to sort the render packets of the Layer.
+   * @see RenderQueue
+   * @see RendererInfo::render_queue
+   */
+  void use_render_queue(bool enable) { render_queue_ = enable; }
+  /**
+   * @brief Check if the render packets of the Layer are sorted by state.
+   *
+   * @return true if the Layer uses the render queue.
+   */
+  bool uses_render_queue() const { return render_queue_; }
   /**
    * @brief Swaps the properties of the Layer's parent Camera with the
    * properties of a Referenced Camera.
@@ -127,9 +160,9 @@ public:
    */
   template <typename T, typename... Args>
   Referenced<T> gen_entity(Args... args) {
-    Referenced<T> ent = gen_ref<T>(args...);
+    Referenced<T> ent = gen_pooled<T>(0, args...);
     if (ent) {
-      entities_.push_back(ent);
+      insert_entity(ent);
       return ent;
     }
     return nullptr;
@@ -150,15 +183,117 @@ public:
   template <typename T, typename... Args>
   std::vector<Referenced<T>> gen_entities(uint32_t count, Args... args) {
     std::vector<Referenced<T>> ents{};
+    ents.reserve(count);
+    reserve_entities(count);
     for (uint32_t i = 0; i < count; i++) {
-      Referenced<T> ent = gen_ref<T>(args...);
+      Referenced<T> ent = gen_pooled<T>(count, args...);
       if (ent) {
-        entities_.push_back(ent);
+        insert_entity(ent);
         ents.push_back(ent);
       }
     }
     return ents;
   }
+  /**
+   * @brief Generate an Entity, push it onto the Entity stack and return its
+   * EntityHandle.
+   * @details Unlike gen_entity(), the Layer holds the only reference to the
+   * Entity, so it is deleted as soon as it is destroyed with
+   * destroy_entity(EntityHandle).
+   *
+   * @tparam <T> The type of Entity. <T> must be an Entity.
+   * @tparam <Args> The type of the arguments for the Contructor of the Entity.
+   * @param args The arguments for the Constructor of the Entity.
+   * @return The EntityHandle of the Entity.
+   * @see EntityHandle
+   */
+  template <typename T, typename... Args>
+  EntityHandle spawn_entity(Args... args) {
+    EntityHandle handle = insert_entity(gen_pooled<T>(0, args...));
+    return handle;
+  }
+  /**
+   * @brief Generate multiple Entities, push them onto the Entity stack and
+   * return their EntityHandles.
+   * @details Storage for the Entities, the Entity stack and the EntityHandles
+   * is reserved once up front.
+   *
+   * @tparam <T> The type of Entities to generate. <T> must be a Entity.
+   * @tparam <Args> The type of the arguments for the Contructor of the Entity.
+   * @param count The number of Entities to generate.
+   * @param args The arguments for the Constructor of the Entity.
+   * @return The EntityHandles of the Entities.
+   * @see EntityHandle
+   */
+  template <typename T, typename... Args>
+  std::vector<EntityHandle> spawn_entities(uint32_t count, Args... args) {
+    std::vector<EntityHandle> handles{};
+    handles.reserve(count);
+    reserve_entities(count);
+    for (uint32_t i = 0; i < count; i++) {
+      handles.push_back(insert_entity(gen_pooled<T>(count, args...)));
+    }
+    return handles;
+  }
+  /**
+   * @brief Remove an Entity from the Entity stack using its EntityHandle.
+   * @details The handle is invalidated immediately and the Entity is removed
+   * from the Entity stack at the next sync point.
+   * @see Renderer::sync_structure()
+   *
+   * @param handle The EntityHandle of the Entity.
+   * @return The Referenced Entity that was removed. nullptr if the handle is
+   * no longer valid.
+   * @see EntityHandle
+   */
+  Referenced<Entity> destroy_entity(EntityHandle handle) {
+    if (!handles_.valid(handle)) {
+      return nullptr;
+    }
+    return remove_entity(handles_.position(handle));
+  }
+  /**
+   * @brief Check if an EntityHandle still refers to an Entity on the Entity
+   * stack.
+   *
+   * @param handle The EntityHandle to check.
+   * @return true if the Entity is on the Entity stack.
+   * @see EntityHandle
+   */
+  bool entity_valid(EntityHandle handle) const {
+    return handles_.valid(handle);
+  }
+  /**
+   * @brief Get a pointer to an Entity from its EntityHandle.
+   *
+   * @tparam <T> The type of Entity to get. <T> must be an Entity.
+   * @param handle The EntityHandle of the Entity.
+   * @return A pointer to the Entity. nullptr if the handle is no longer valid
+   * or the Entity is not of type <T>.
+   * @see EntityHandle
+   */
+  template <typename T = Entity> T *get_entity(EntityHandle handle) const {
+    if (!handles_.valid(handle)) {
+      return nullptr;
+    }
+    return dynamic_cast<T *>(entities_[handles_.position(handle)].get());
+  }
+  /**
+   * @brief Get the EntityHandle of an Entity on the Entity stack.
+   *
+   * @param entity A pointer to the Entity.
+   * @return The EntityHandle of the Entity. An invalid EntityHandle if the
+   * Entity is not on the Entity stack.
+   * @see EntityHandle
+   */
+  EntityHandle get_handle(const Entity *entity) const {
+    if (!entity || entity->layer_ != this ||
+        !handles_.valid(entity->handle_) ||
+        entities_[handles_.position(entity->handle_)].get() != entity) {
+      return EntityHandle{};
+    }
+    return entity->handle_;
+  }
   /**
    * @brief Get a pointer to the first Entity of type <T> in the Layer's
    * Entity stack.
@@ -169,12 +304,7 @@ public:
    * @see Entity
    */
   template <typename T> T *get_entity() {
-    for (auto ent_it = entity_begin(); ent_it != entity_end(); ent_it++) {
-      if (auto entity = std::dynamic_pointer_cast<T>(*ent_it)) {
-        return entity.get();
-      }
-    }
-    return nullptr;
+    return entity_index_.first<T>(entities_);
   }
   /**
    * @brief Get a `std::vector` of pointers to all of the Entities of type <T>
@@ -183,17 +313,12 @@ public:
    * @tparam <T> The type of Entity to get. <T> must be an Entity.
    * @return A `std::vector` of pointers to all of the Entities of type <T> in
    * the Entity stack. An empty vector is returned if no Entity of type <T>
-   * exists on the Entity stack.
+   * exists on the Entity stack. The vector is a copy, so the Entity stack may
+   * change while it is iterated.
    * @see Entity
    */
   template <typename T> std::vector<T *> get_entities() {
-    std::vector<T *> entities{};
-    for (auto ent_it = entity_begin(); ent_it != entity_end(); ent_it++) {
-      if (auto entity = std::dynamic_pointer_cast<T>(*ent_it)) {
-        entities.push_back(entity.get());
-      }
-    }
-    return entities;
+    return entity_index_.get<T>(entities_);
   }
   /**
    * @brief Push an existing Referenced Entity onto the Layer's Entity stack.
@@ -201,7 +326,9 @@ public:
    * @param entity A Referenced Entity.
    * @see Entity
    */
-  void push_entity(Referenced<Entity> entity) { entities_.push_back(entity); }
+  void push_entity(Referenced<Entity> entity) {
+    insert_entity(entity);
+  }
   /**
    * @brief Push a `std::vector` of existing Referenced Entities onto the
    * Layer's Entity stack.
@@ -210,8 +337,9 @@ public:
    * @see Entity
    */
   void push_entities(std::vector<Referenced<Entity>> entities) {
+    reserve_entities(entities.size());
     for (size_t i = 0; i < entities.size(); i++) {
-      entities_.push_back(entities[i]);
+      insert_entity(entities[i]);
     }
   }
   /**
@@ -225,16 +353,129 @@ public:
    * @see Entity
    */
   template <typename T> Referenced<T> pull_entity(T *entity) {
-    for (auto ent_it = entity_begin(); ent_it != entity_end(); ent_it++) {
-      if (entity == (*ent_it).get()) {
-        Referenced<T> pulled_entity = std::dynamic_pointer_cast<T>(*ent_it);
-        (*ent_it) = nullptr;
-        entity_pulled = false;
-        return pulled_entity;
-      }
+    EntityHandle handle = get_handle(entity);
+    if (!handles_.valid(handle)) {
+      return nullptr;
     }
-    return nullptr;
+    return std::dynamic_pointer_cast<T>(
+        remove_entity(handles_.position(handle)));
+  }
+  /**
+   * @brief Set the parent of an Entity on the Entity stack.
+   * @details The child's Transform becomes relative to the parent and its
+   * world Transform is kept up to date by the Layer's TransformHierarchy. Both
+   * Entities must be on this Layer's Entity stack. A child is detached from
+   * the hierarchy when it is pulled, and the children of a pulled Entity
+   * become roots.
+   *
+   * @param child The child Entity.
+   * @param parent The parent Entity, nullptr to detach the child from its
+   * parent.
+   * @return true if the parent was set.
+   * @see Entity::get_world_transform()
+   */
+  bool set_parent(Entity *child, Entity *parent) {
+    return hierarchy_.set_parent(child, parent);
+  }
+  /**
+   * @brief Get the Layer's TransformHierarchy.
+   *
+   * @return A reference to the TransformHierarchy.
+   */
+  TransformHierarchy &get_hierarchy() { return hierarchy_; }
+  /**
+   * @brief Get the Layer's SpatialIndex.
+   * @details Every Entity on the Entity stack is tracked by the SpatialIndex,
+   * which is updated once per frame after the TransformHierarchy.
+   *
+   * @return A reference to the SpatialIndex.
+   */
+  SpatialIndex &get_spatial_index() { return spatial_index_; }
+  /**
+   * @brief Generate a component Entity in the Layer's ArchetypeStore.
+   * @details Component Entities are plain component structs stored by value in
+   * contiguous arrays instead of Referenced Entities on the Entity stack. They
+   * have no Systems of their own and are operated on by Systems attached to
+   * the Layer using Layer::each().
+   *
+   * @tparam <Ts> The types of the components.
+   * @param components The initial values of the components.
+   * @return The handle to the component Entity.
+   * @see ArchetypeStore
+   */
+  template <typename... Ts>
+  ComponentEntity gen_component_entity(Ts... components) {
+    return archetypes_.gen_entity<Ts...>(components...);
+  }
+  /**
+   * @brief Generate multiple component Entities with the same components in
+   * the Layer's ArchetypeStore.
+   *
+   * @tparam <Ts> The types of the components.
+   * @param count The number of component Entities to generate.
+   * @param components The initial values of the components.
+   * @return The handles to the component Entities.
+   * @see ArchetypeStore
+   */
+  template <typename... Ts>
+  std::vector<ComponentEntity> gen_component_entities(uint32_t count,
+                                                      Ts... components) {
+    return archetypes_.gen_entities<Ts...>(count, components...);
+  }
+  /**
+   * @brief Remove a component Entity from the Layer's ArchetypeStore.
+   *
+   * @param entity The handle to the component Entity.
+   * @see ArchetypeStore
+   */
+  void pull_component_entity(ComponentEntity entity) {
+    archetypes_.pull_entity(entity);
+  }
+  /**
+   * @brief Get a component of a component Entity.
+   *
+   * @tparam <T> The type of component to get.
+   * @param entity The handle to the component Entity.
+   * @return A pointer to the component. nullptr if the component Entity does
+   * not exist or does not have a component of type <T>. The pointer is
+   * invalidated when component Entities are added or removed.
+   * @see ArchetypeStore
+   */
+  template <typename T> T *get_component(ComponentEntity entity) {
+    return archetypes_.get<T>(entity);
+  }
+  /**
+   * @brief Call a function on every component Entity in the Layer that has
+   * all of the components <Ts>.
+   *
+   * @tparam <Ts> The types of components to query.
+   * @param fn A function taking a reference to each of the components <Ts>.
+   * @see ArchetypeStore
+   */
+  template <typename... Ts, typename F> void each(F &&fn) {
+    archetypes_.each<Ts...>(std::forward<F>(fn));
+  }
+  /**
+   * @brief Call a function on every component Entity in the Layer that has
+   * all of the components <Ts>, also passing its component of type <O> if it
+   * has one.
+   *
+   * @tparam <O> The type of the optional component.
+   * @tparam <Ts> The types of components to query.
+   * @param fn A function taking a reference to each of the components <Ts>
+   * and a pointer to the component <O>, nullptr if it has none.
+   * @see ArchetypeStore
+   */
+  template <typename O, typename... Ts, typename F>
+  void each_optional(F &&fn) {
+    archetypes_.each_optional<O, Ts...>(std::forward<F>(fn));
   }
+  /**
+   * @brief Get the Layer's ArchetypeStore.
+   *
+   * @return A reference to the ArchetypeStore.
+   */
+  ArchetypeStore &get_archetypes() { return archetypes_; }
   /**
    * @brief Get a const iterator pointing to the begining of the Entity stack.
    *
@@ -313,20 +554,210 @@ public:
   std::vector<Referenced<Entity>>::reverse_iterator entity_rend() {
     return entities_.rend();
   }
-  void remove_null_entities() {
-    if (entity_pulled) {
-      entity_pulled = false;
-      entities_.erase(std::remove_if(entity_begin(), entity_end(),
-                                     [](Referenced<Entity> ent) {
-                                       return ent.get() == nullptr;
+  /**
+   * @brief An IControlsSystem on the Layer or one of its Entities.
+   */
+  struct ControlsListener {
+    IControlsSystem *system;  /**< The listening System.*/
+    Entity *entity;           /**< The Entity the System is attached to.*/
+    Referenced<System> owner; /**< Keeps the System alive during dispatch.*/
+    Referenced<Entity> owner_entity; /**< Keeps the Entity alive during
+                                        dispatch, nullptr for the Layer.*/
+  };
+  /**
+   * @brief Get the listeners of a kind of controls event in dispatch order.
+   * @details The Entities from the top of the Entity stack down and then the
+   * Layer itself, each with its System stack in reverse. Only valid until the
+   * next call to update_controls().
+   *
+   * @param event The kind of event.
+   * @return The listeners of the event.
+   * @see IControlsSystem::listens()
+   */
+  const std::vector<ControlsListener> &
+  controls_listeners(ControlsEvent event) const {
+    return controls_listeners_[static_cast<size_t>(event)];
+  }
+  /**
+   * @brief Signal that the IControlsSystems of an Entity on the Entity stack,
+   * or of the Layer itself, changed.
+   * @details The listeners of the Entity are replaced at the next call to
+   * update_controls(). The listeners of the other Entities are left alone.
+   *
+   * @param entity The Entity or the Layer.
+   */
+  void invalidate_controls(Entity *entity) {
+    controls_pending_.push_back(entity);
+  }
+  /**
+   * @brief Replace the listeners of the Entities whose IControlsSystems
+   * changed since the last call.
+   * @details Called by the Renderer before each controls event is dispatched,
+   * so a listener may change the Layer during dispatch. The cost is linear in
+   * the number of listeners and is only paid when something changed.
+   */
+  void update_controls() {
+    if (controls_pending_.empty()) {
+      return;
+    }
+    std::sort(controls_pending_.begin(), controls_pending_.end());
+    controls_pending_.erase(
+        std::unique(controls_pending_.begin(), controls_pending_.end()),
+        controls_pending_.end());
+    for (auto &listeners : controls_listeners_) {
+      listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                     [this](const ControlsListener &listener) {
+                                       return std::binary_search(
+                                           controls_pending_.begin(),
+                                           controls_pending_.end(),
+                                           listener.entity);
                                      }),
-                      entity_end());
+                      listeners.end());
+    }
+    for (Entity *entity : controls_pending_) {
+      int64_t rank = controls_rank(entity);
+      if (rank < -1) {
+        continue;
+      }
+      Referenced<Entity> owner_entity =
+          entity == this ? nullptr : entities_[static_cast<size_t>(rank)];
+      // the listeners are sorted from the top of the Entity stack down
+      std::array<size_t, static_cast<size_t>(ControlsEvent::COUNT)> at{};
+      for (size_t i = 0; i < at.size(); i++) {
+        auto &listeners = controls_listeners_[i];
+        at[i] = std::partition_point(
+                    listeners.begin(), listeners.end(),
+                    [this, rank](const ControlsListener &listener) {
+                      return controls_rank(listener.entity) > rank;
+                    }) -
+                listeners.begin();
+      }
+      const auto &controls_systems = entity->controls_systems();
+      for (auto controls_it = controls_systems.rbegin();
+           controls_it != controls_systems.rend(); controls_it++) {
+        IControlsSystem *system = *controls_it;
+        if (!system) {
+          continue;
+        }
+        // find the Referenced System on the System stack to keep it alive
+        Referenced<System> owner = nullptr;
+        for (auto sys_it = entity->systems_begin();
+             sys_it != entity->systems_end(); sys_it++) {
+          if (sys_it->get() == static_cast<System *>(system)) {
+            owner = *sys_it;
+            break;
+          }
+        }
+        for (size_t i = 0; i < at.size(); i++) {
+          if (system->listens(static_cast<ControlsEvent>(i))) {
+            auto &listeners = controls_listeners_[i];
+            listeners.insert(listeners.begin() + at[i]++,
+                             {system, entity, owner, owner_entity});
+          }
+        }
+      }
+    }
+    controls_pending_.clear();
+  }
+  /**
+   * @brief Remove the Entities pulled this frame from the Entity stack.
+   * @details The remaining Entities keep their order on the stack, which is
+   * the order they are rendered in and the reverse of the order they receive
+   * controls events in. The stack is compacted in a single pass.
+   */
+  void remove_null_entities() {
+    if (pulled_entities_.empty()) {
+      return;
     }
+    std::sort(pulled_entities_.begin(), pulled_entities_.end());
+    size_t next = 0;
+    uint32_t write = 0;
+    for (uint32_t read = 0; read < entities_.size(); read++) {
+      if (next < pulled_entities_.size() && pulled_entities_[next] == read) {
+        while (next < pulled_entities_.size() &&
+               pulled_entities_[next] == read) {
+          next++;
+        }
+        continue;
+      }
+      if (write != read) {
+        entities_[write] = std::move(entities_[read]);
+        entity_handles_[write] = entity_handles_[read];
+        handles_.move(entity_handles_[write], write);
+      }
+      write++;
+    }
+    entities_.resize(write);
+    entity_handles_.resize(write);
+    pulled_entities_.clear();
+    // release the listeners of the pulled Entities
+    update_controls();
   }
 
 private:
+  // -1 for the Layer itself, below -1 if the Entity is not on the stack
+  int64_t controls_rank(Entity *entity) const {
+    if (entity == this) {
+      return -1;
+    }
+    EntityHandle handle = get_handle(entity);
+    if (!handles_.valid(handle)) {
+      return -2;
+    }
+    return static_cast<int64_t>(handles_.position(handle));
+  }
+  EntityHandle insert_entity(Referenced<Entity> entity) {
+    uint32_t position = static_cast<uint32_t>(entities_.size());
+    EntityHandle handle = handles_.insert(position);
+    entity_index_.insert(entity.get());
+    spatial_index_.insert(entity.get());
+    if (entity) {
+      entity->layer_ = this;
+      entity->handle_ = handle;
+      controls_pending_.push_back(entity.get());
+    }
+    entities_.push_back(std::move(entity));
+    entity_handles_.push_back(handle);
+    return handle;
+  }
+  Referenced<Entity> remove_entity(size_t position) {
+    Referenced<Entity> entity = std::move(entities_[position]);
+    handles_.erase(entity_handles_[position]);
+    if (entity) {
+      if (entity->layer_ == this &&
+          entity->handle_ == entity_handles_[position]) {
+        entity->layer_ = nullptr;
+        entity->handle_ = EntityHandle{};
+      }
+      controls_pending_.push_back(entity.get());
+    }
+    entity_index_.remove(entity.get());
+    hierarchy_.remove(entity.get());
+    spatial_index_.remove(entity.get());
+    pulled_entities_.push_back(static_cast<uint32_t>(position));
+    Renderer::invalidate_structure();
+    return entity;
+  }
+  void reserve_entities(size_t count) {
+    entities_.reserve(entities_.size() + count);
+    entity_handles_.reserve(entities_.size() + count);
+  }
   std::vector<Referenced<Entity>> entities_{}; /**< The Entity stack.*/
-  bool entity_pulled = false;
+  std::vector<EntityHandle> entity_handles_{}; /**< The EntityHandle of each
+                                                  Entity on the stack.*/
+  HandleTable handles_{}; /**< Maps EntityHandles to the Entity stack.*/
+  std::vector<uint32_t> pulled_entities_{}; /**< Stack positions pulled this
+                                               frame.*/
+  std::array<std::vector<ControlsListener>,
+             static_cast<size_t>(ControlsEvent::COUNT)>
+      controls_listeners_{}; /**< The listeners of each ControlsEvent.*/
+  std::vector<Entity *> controls_pending_{}; /**< Entities whose listeners
+                                                changed.*/
+  TypeIndex<Entity> entity_index_{}; /**< Typed views of the Entity stack.*/
+  TransformHierarchy hierarchy_{}; /**< Parents of the Entities.*/
+  SpatialIndex spatial_index_{};   /**< BVH of the Entities.*/
+  ArchetypeStore archetypes_{}; /**< The component Entities.*/
+  bool render_queue_{false};    /**< Sort the render packets by state?*/
 };
 } // namespace mare
 
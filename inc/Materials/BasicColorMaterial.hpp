@@ -37,6 +37,21 @@ public:
 protected:
   glm::vec4 m_color;
 };
+
+/**
+ * @brief A BasicColorMaterial that draws every Mesh of a BatchedMesh with a
+ * single multi-draw.
+ * @see BatchedMesh
+ */
+class BatchedBasicColorMaterial : public BasicColorMaterial {
+public:
+  /**
+   * @brief Construct a new Batched Basic Material
+   */
+  BatchedBasicColorMaterial()
+      : Material("./MARE/res/Shaders/BasicColorBatched") {}
+  bool is_batched() const override { return true; }
+};
 } // namespace mare
 
 #endif
\ No newline at end of file
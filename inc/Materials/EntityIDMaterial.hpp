@@ -0,0 +1,39 @@
+#ifndef ENTITYIDMATERIAL
+#define ENTITYIDMATERIAL
+
+// MARE
+#include "Shader.hpp"
+
+namespace mare {
+/**
+ * @brief A Material that writes a single unsigned integer ID into an R32UI
+ * color buffer.
+ * @details Used by the Renderer to draw the Entity ID pass. Only one shader is
+ * ever compiled and is shared between all instances of EntityIDMaterial.
+ * @see Renderer::enable_id_pass()
+ */
+class EntityIDMaterial : public virtual Material {
+public:
+  /**
+   * @brief Construct a new EntityIDMaterial
+   */
+  EntityIDMaterial() : Material("./MARE/res/Shaders/EntityID"), m_id(0) {}
+  virtual ~EntityIDMaterial() {}
+  /**
+   * @brief uploads the ID to the shader when rendered.
+   *
+   */
+  void render() override { upload_int("u_id", int(m_id)); }
+  /**
+   * @brief Set the ID written by the Material.
+   *
+   * @param id The ID to write, 0 is reserved for the background.
+   */
+  inline void set_id(uint32_t id) { m_id = id; }
+
+protected:
+  uint32_t m_id;
+};
+} // namespace mare
+
+#endif
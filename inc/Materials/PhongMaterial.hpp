@@ -101,6 +101,20 @@ private:
   Referenced<Spotlight>
       spotlight; /**< The Spotlight used to render the Phong-style lighting.*/
 };
+
+/**
+ * @brief A PhongMaterial that draws every Mesh of a BatchedMesh with a single
+ * multi-draw.
+ * @see BatchedMesh
+ */
+class BatchedPhongMaterial : public PhongMaterial {
+public:
+  /**
+   * @brief Construct a new Batched Phong Material
+   */
+  BatchedPhongMaterial() : Material("./MARE/res/Shaders/PhongBatched") {}
+  bool is_batched() const override { return true; }
+};
 } // namespace mare
 
 #endif
\ No newline at end of file
@@ -14,6 +14,18 @@ class VertexColorMaterial : public Material {
 public:
   VertexColorMaterial() : Material("./MARE/res/Shaders/VertexColor") {}
 };
+
+/**
+ * @brief A VertexColorMaterial that draws every Mesh of a BatchedMesh with a
+ * single multi-draw.
+ * @see BatchedMesh
+ */
+class BatchedVertexColorMaterial : public Material {
+public:
+  BatchedVertexColorMaterial()
+      : Material("./MARE/res/Shaders/VertexColorBatched") {}
+  bool is_batched() const override { return true; }
+};
 } // namespace mare
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MESHES
 
 // MARE
+#include "Bounds.hpp"
 #include "Buffers.hpp"
 #include "Components/Transform.hpp"
 #include "Entities/Camera.hpp"
@@ -9,12 +10,14 @@
 #include "Shader.hpp"
 
 // Standard Library
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
 // External Libraries
 #include "glm.hpp"
 #include "gtc/matrix_transform.hpp"
+#include "gtc/quaternion.hpp"
 
 namespace mare {
 /**
@@ -56,9 +59,15 @@ enum class DrawMethod {
  * that can be rendered with the Rendering API. There are three kinds of Meshes:
  *  -SimpleMesh
  *  -CompositeMesh
+ *  -LODMesh
  *  -InstancedMesh
  *
  * Each kind of Mesh is implemented by the Rendering API.
+ *
+ * A Mesh knows the Entities whose RenderPack holds it and marks their bounds
+ * dirty in their Layer's SpatialIndex when its own Transform or its bounds
+ * change. Changes made through a Transform pointer or reference to the Mesh
+ * are not seen, call Entity::mark_bounds_dirty() after them.
  * @see Material
  * @see RenderPack
  * @see SimpleMesh
@@ -109,6 +118,155 @@ public:
   virtual void render(Camera *camera, Material *material,
                       Transform *parent_transform, unsigned int instance_count,
                       Buffer<Transform> *models) = 0;
+  /**
+   * @brief Get the axis aligned bounding box of the Mesh.
+   * @details The bounds are in the model space of the Mesh, before its own
+   * Transform is applied. A Mesh with empty bounds is never culled.
+   *
+   * @return The AABB.
+   */
+  virtual const AABB &get_aabb() { return aabb_; }
+  /**
+   * @brief Get the bounding sphere of the Mesh.
+   * @details The bounds are in the model space of the Mesh, before its own
+   * Transform is applied.
+   *
+   * @return The BoundingSphere.
+   */
+  virtual const BoundingSphere &get_bounding_sphere() { return sphere_; }
+  /**
+   * @brief Recompute the bounds of the Mesh from its geometry.
+   */
+  virtual void update_bounds() {}
+  /**
+   * @brief Check if the Mesh may be visible in a Frustum.
+   *
+   * @param frustum The Frustum in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @return true if the bounds of the Mesh intersect the Frustum or the bounds
+   * are empty.
+   */
+  bool intersects(const Frustum &frustum, Transform *parent_transform);
+  /**
+   * @brief Intersect a Ray with the triangles of the Mesh.
+   * @details Only hits closer than \p hit.distance are reported, so the same
+   * RayHit can be passed to several Meshes to find the closest hit. Meshes
+   * without triangles are never hit.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closer hit if one is found. The entity is not
+   * set.
+   * @return true if a closer hit was found.
+   */
+  virtual bool raycast(const Ray &ray, Transform *parent_transform,
+                       RayHit &hit) {
+    return false;
+  }
+  /**
+   * @brief Set the transformation matrix of the Mesh.
+   *
+   * @param transformation_matrix The matrix to set.
+   */
+  void set_transformation_matrix(glm::mat4 transformation_matrix) {
+    Transform::set_transformation_matrix(transformation_matrix);
+    bounds_changed();
+  }
+  /**
+   * @brief Face the Mesh towards a point in space and orient it such that the
+   * horizontal plane is level.
+   *
+   * @param point The point in space to face towards.
+   * @param normal_vector The normal vector for the horizontal plane.
+   */
+  void face_towards(glm::vec3 point, glm::vec3 normal_vector) {
+    Transform::face_towards(point, normal_vector);
+    bounds_changed();
+  }
+  /**
+   * @brief Translate the Mesh by an offsetting 3D vector.
+   *
+   * @param offset The 3D vector to translate by.
+   */
+  void translate(glm::vec3 offset) {
+    Transform::translate(offset);
+    bounds_changed();
+  }
+  /**
+   * @brief Set the position of the Mesh.
+   *
+   * @param position The position to set.
+   */
+  void set_position(glm::vec3 position) {
+    Transform::set_position(position);
+    bounds_changed();
+  }
+  /**
+   * @brief Rotate the Mesh from its current rotation by an angle about an
+   * axis.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void rotate(glm::vec3 axis, float angle) {
+    Transform::rotate(axis, angle);
+    bounds_changed();
+  }
+  /**
+   * @brief Set the rotation of the Mesh.
+   *
+   * @param axis The axis to rotate about.
+   * @param angle The angle to rotate by.
+   */
+  void set_rotation(glm::vec3 axis, float angle) {
+    Transform::set_rotation(axis, angle);
+    bounds_changed();
+  }
+  /**
+   * @brief Set the scale of the Mesh.
+   *
+   * @param scale The scale to set.
+   */
+  void set_scale(glm::vec3 scale) {
+    Transform::set_scale(scale);
+    bounds_changed();
+  }
+
+protected:
+  /**
+   * @brief Mark the bounds of every Entity holding the Mesh dirty.
+   */
+  void bounds_changed();
+  AABB aabb_{};             /**< The cached bounding box.*/
+  BoundingSphere sphere_{}; /**< The cached bounding sphere.*/
+
+private:
+  friend class RenderPack;
+  /**
+   * @brief Register an Entity whose RenderPack holds the Mesh.
+   * @details An Entity holding the Mesh in several Packets is registered once
+   * per Packet.
+   *
+   * @param owner The Entity.
+   */
+  void add_owner(Entity *owner) { owners_.push_back(owner); }
+  /**
+   * @brief Unregister one Packet of an Entity.
+   * @details Searches from the most recently registered Entity, so removing a
+   * Mesh shared by many Entities is linear in the number of Entities.
+   *
+   * @param owner The Entity.
+   */
+  void remove_owner(Entity *owner) {
+    auto found = std::find(owners_.rbegin(), owners_.rend(), owner);
+    if (found != owners_.rend()) {
+      *found = owners_.back();
+      owners_.pop_back();
+    }
+  }
+  std::vector<Entity *> owners_{}; /**< The Entities holding the Mesh.*/
 };
 
 /**
@@ -185,6 +343,49 @@ public:
    * @see Material
    */
   virtual void add_geometry_buffer(Referenced<Buffer<float>> geometry_buffer);
+  /**
+   * @brief Adds a Geometry Buffer to the Mesh and computes the bounds from the
+   * data the Buffer was created with.
+   * @details If the format of the Buffer has a POSITION_2D or POSITION_3D
+   * Attribute and no earlier Geometry Buffer has, the bounds are computed on
+   * the CPU and the positions are kept for raycasting, so the GPU is never
+   * accessed. A Geometry Buffer added without its data leaves the bounds
+   * unchanged.
+   *
+   * @param geometry_buffer The Geometry Buffer to add to the Mesh, with its
+   * format already set.
+   * @param data The floats the Geometry Buffer was created with, one vertex
+   * per stride of the format for every vertex in the Buffer.
+   */
+  void add_geometry_buffer(Referenced<Buffer<float>> geometry_buffer,
+                           const float *data);
+  /**
+   * @brief Recompute the bounds of the Mesh from the positions in its Geometry
+   * Buffers.
+   * @details The positions are read back from the Geometry Buffers, which
+   * waits for the GPU. Call it after adding a Geometry Buffer without its data
+   * or after writing new positions into a Geometry Buffer that is already
+   * attached.
+   */
+  void update_bounds() override;
+  /**
+   * @brief Intersect a Ray with the triangles of the Mesh.
+   * @details The triangles are assembled the first time the Mesh is raycast
+   * and kept on the CPU. They are built from the positions and indices passed
+   * to add_geometry_buffer() and set_index_buffer() with their data, or read
+   * back from the Geometry and Index Buffers, waiting for the GPU, if they
+   * were set without it. The triangles are rebuilt after update_bounds(),
+   * set_index_buffer() and set_draw_method(). Meshes drawn as points or lines
+   * are never hit.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closer hit if one is found.
+   * @return true if a closer hit was found.
+   */
+  bool raycast(const Ray &ray, Transform *parent_transform,
+               RayHit &hit) override;
   /**
    * @brief Get the geometry buffers fo the Mesh.
    *
@@ -201,6 +402,16 @@ public:
    * @param index_buffer The Index Buffer to set.
    */
   virtual void set_index_buffer(Referenced<Buffer<uint32_t>> index_buffer);
+  /**
+   * @brief Set the Index Buffer of the Mesh and keep the indices it was
+   * created with on the CPU for raycasting.
+   *
+   * @param index_buffer The Index Buffer to set.
+   * @param data The indices the Index Buffer was created with, one for every
+   * index in the Buffer.
+   */
+  void set_index_buffer(Referenced<Buffer<uint32_t>> index_buffer,
+                        const uint32_t *data);
   /**
    * @brief Get a Reference to the Index Buffer.
    *
@@ -251,10 +462,21 @@ public:
   /**
    * @brief Get the index of the currently active Buffer in the Geometry Buffer
    * swap chain if the Geometry Buffer is multibuffered.
+   * @details Returned as the first vertex of the active Buffer. If the
+   * Geometry Buffer is in the GeometryHeap, its offset in vertices is added,
+   * so this is the base vertex of a draw.
    *
-   * @return The index of the Buffer in the swap chain. 0 if not multibuffered.
+   * @return The first vertex of the active Buffer. 0 if not multibuffered or
+   * in the GeometryHeap.
    */
   unsigned int get_render_index();
+  /**
+   * @brief Get the first index to draw from the Index Buffer.
+   * @details Non-zero if the Index Buffer is in the GeometryHeap.
+   *
+   * @return The offset in indices of the Index Buffer.
+   */
+  unsigned int get_first_index();
   /**
    * @brief Wait for all Buffer operations submitted before the call to
    * lock_buffers() to complete before proceeding.
@@ -281,9 +503,35 @@ public:
   size_t
       vertex_render_count; /**< The number of vertices in the Geometry Buffer.*/
   size_t index_render_count; /**< The number of indices in the Index Buffer.*/
+  bool use_geometry_heap{true}; /**< Move static Buffers into the
+                                   GeometryHeap when first bound?*/
 
 protected:
+  /**
+   * @brief Read the positions of the Mesh from its Geometry Buffers.
+   *
+   * @return The position of each vertex, empty if no Geometry Buffer has
+   * positions.
+   */
+  std::vector<glm::vec3> read_positions() const;
+  /**
+   * @brief Set the bounds to contain a set of positions.
+   *
+   * @param positions The position of each vertex.
+   */
+  void fit_bounds(const std::vector<glm::vec3> &positions);
+  /**
+   * @brief Assemble the triangles of the Mesh for raycasting.
+   */
+  void update_triangles();
   DrawMethod draw_method_; /**< The DrawMethod of the Mesh.*/
+  std::vector<glm::vec3> positions_{}; /**< The positions on the CPU, empty if
+                                          only on the GPU.*/
+  std::vector<uint32_t> indices_{};    /**< The indices on the CPU, empty if
+                                          only on the GPU.*/
+  std::vector<glm::vec3>
+      triangles_{}; /**< The corners of each triangle, kept for raycasting.*/
+  bool triangles_dirty_{true}; /**< Assemble the triangles again?*/
 };
 
 /**
@@ -348,6 +596,24 @@ public:
    * @brief Delete all Meshes on the Mesh stack.
    */
   void clear();
+  /**
+   * @brief Combine the bounds of every Mesh on the Mesh stack.
+   * @details Called automatically when the Mesh stack changes. Call it after
+   * moving a Mesh on the stack or changing its bounds. The bounding sphere
+   * contains the combined AABB.
+   */
+  void update_bounds() override;
+  /**
+   * @brief Intersect a Ray with every Mesh on the Mesh stack.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closest hit found.
+   * @return true if a closer hit was found.
+   */
+  bool raycast(const Ray &ray, Transform *parent_transform,
+               RayHit &hit) override;
   /**
    * @brief Get the meshes of type <T> in the CompositeMesh.
    *
@@ -367,6 +633,165 @@ protected:
   std::vector<Referenced<Mesh>> meshes_{}; /**< The Mesh stack.*/
 };
 
+/**
+ * @brief A LODMesh draws one of several tessellations of the same geometry
+ * depending on how large it appears on the screen.
+ * @details Each level of detail is a Mesh paired with the smallest screen size
+ * it is drawn at. The screen size is the diameter of the finest level's
+ * bounding sphere as a fraction of the viewport height, computed from the
+ * Camera's projection. A level only changes once the screen size has crossed
+ * a threshold by the hysteresis fraction, so an object resting near a
+ * threshold does not pop between levels. The selected level is kept per
+ * Camera. The level Meshes can be shared, so give each Entity its own LODMesh
+ * to give it its own selection. Inside an InstancedMesh the level is selected
+ * per instance.
+ * @see Mesh
+ * @see InstancedMesh
+ */
+class LODMesh : public Mesh {
+public:
+  /**
+   * @brief Construct a new LODMesh object without any levels.
+   */
+  LODMesh() {}
+  /**
+   * @brief Destroy the LODMesh object
+   */
+  virtual ~LODMesh() {}
+  /**
+   * @brief Render the level selected for the Camera.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material) override;
+  /**
+   * @brief Render the level selected for the Camera.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @param parent_transform The parent Transform Component.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material,
+              Transform *parent_transform) override;
+  /**
+   * @brief Render every instance with the level selected for the parent
+   * Transform.
+   * @details An InstancedMesh of a LODMesh selects a level per instance
+   * instead.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @param parent_transform The parent Transform Component.
+   * @param models The Buffer of transformation matricies to use for instanced.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material, Transform *parent_transform,
+              unsigned int instance_count, Buffer<Transform> *models) override;
+  /**
+   * @brief Add a level of detail.
+   * @details Levels are kept sorted from the finest to the coarsest. The
+   * coarsest level is drawn at any size below its own screen size.
+   *
+   * @param mesh The Mesh of the level.
+   * @param screen_size The smallest screen size the level is drawn at.
+   */
+  void push_level(Referenced<Mesh> mesh, float screen_size);
+  /**
+   * @brief Construct and add a level of detail.
+   *
+   * @tparam <T> The type of Mesh to construct.
+   * @param screen_size The smallest screen size the level is drawn at.
+   * @param args The arguments of the Mesh's constructor.
+   */
+  template <typename T, typename... Args>
+  void push_level(float screen_size, Args... args) {
+    push_level(gen_ref<T>(args...), screen_size);
+  }
+  /**
+   * @brief Remove every level.
+   */
+  void clear();
+  /**
+   * @brief Set the fraction a screen size threshold must be crossed by before
+   * the level changes.
+   *
+   * @param hysteresis The fraction, 0 switches exactly at the thresholds.
+   */
+  void set_hysteresis(float hysteresis) { hysteresis_ = hysteresis; }
+  /**
+   * @brief Get the number of levels.
+   *
+   * @return The number of levels.
+   */
+  size_t get_level_count() const { return levels_.size(); }
+  /**
+   * @brief Get the Mesh of a level.
+   *
+   * @param level The level, 0 is the finest.
+   * @return The Mesh.
+   */
+  Mesh *get_level(size_t level) const { return levels_[level].mesh.get(); }
+  /**
+   * @brief Get the screen size of the finest level.
+   *
+   * @param camera The Camera the level is drawn from.
+   * @param model The matrix from the model space of the finest level to world
+   * space.
+   * @return The diameter of the bounding sphere as a fraction of the viewport
+   * height.
+   */
+  float get_screen_size(Camera *camera, const glm::mat4 &model);
+  /**
+   * @brief Select a level for a screen size.
+   *
+   * @param screen_size The screen size of the finest level.
+   * @param current The level selected last frame.
+   * @return The level to draw.
+   */
+  size_t select_level(float screen_size, size_t current) const;
+  /**
+   * @brief Combine the bounds of every level.
+   */
+  void update_bounds() override;
+  /**
+   * @brief Intersect a Ray with the finest level.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closest hit found.
+   * @return true if a closer hit was found.
+   */
+  bool raycast(const Ray &ray, Transform *parent_transform,
+               RayHit &hit) override;
+
+protected:
+  /**
+   * @brief A level of detail.
+   */
+  struct Level {
+    Referenced<Mesh> mesh; /**< The Mesh drawn at the level.*/
+    float screen_size;     /**< The smallest screen size of the level.*/
+  };
+  /**
+   * @brief Select the level to draw from a Camera and update the Camera's
+   * selection.
+   *
+   * @param camera The Camera the level is drawn from.
+   * @param parent The matrix from the model space of the LODMesh to world
+   * space.
+   * @return The Mesh of the level.
+   */
+  Mesh *select(Camera *camera, const glm::mat4 &parent);
+  std::vector<Level> levels_{}; /**< The levels, finest first.*/
+  std::vector<std::pair<const Camera *, size_t>>
+      selections_{}; /**< The level selected for each Camera.*/
+  float hysteresis_{0.1f}; /**< Fraction to cross a threshold by.*/
+};
+
 /**
  * @brief An InstancedMesh is used to render multiple instanced of the same
  * Mesh.
@@ -434,8 +859,22 @@ public:
    * @param model The Transform to push onto the Transform Buffer.
    */
   void push_instance(Transform model);
+  /**
+   * @brief Compose instance transforms from positions, rotations and scales
+   * and push them onto the Transform Buffer.
+   *
+   * @param positions The position of each instance.
+   * @param rotations The unit rotation quaternion of each instance.
+   * @param scales The scale of each instance.
+   * @param count The number of instances to push.
+   * @see flush_instances(const glm::vec3*, const glm::quat*, const glm::vec3*,
+   * uint32_t, uint32_t)
+   */
+  void push_instances(const glm::vec3 *positions, const glm::quat *rotations,
+                      const glm::vec3 *scales, uint32_t count);
   /**
    * @brief Remove the last instance transform from the Transform Buffer.
+   * @details The bounds are recomputed the next time they are needed.
    */
   void pop_instance();
   /**
@@ -452,9 +891,29 @@ public:
    * @param count The number of Transforms to flush.
    */
   void flush_instances(Transform *models, uint32_t offset, uint32_t count);
+  /**
+   * @brief Compose one or more instance transforms from positions, rotations
+   * and scales and write them at some place in the Transform Buffer.
+   * @details The matrices are composed in batches with batch::compose(), so
+   * the caller never builds a translation, rotation and scale matrix per
+   * instance.
+   *
+   * @param positions The position of each instance.
+   * @param rotations The unit rotation quaternion of each instance.
+   * @param scales The scale of each instance.
+   * @param offset The index into the Buffer to start the insertion. In units of
+   * number of Transforms.
+   * @param count The number of Transforms to flush.
+   * @see batch::compose()
+   */
+  void flush_instances(const glm::vec3 *positions, const glm::quat *rotations,
+                       const glm::vec3 *scales, uint32_t offset,
+                       uint32_t count);
   /**
    * @brief Read an write a Transform to the Transform Buffer using the
    * subscript operator.
+   * @details The bounds are recomputed the next time they are needed, use the
+   * const operator to only read.
    *
    * @param i The index into the Buffer to read or write to.
    * @return A reference to the Transform in the Buffer at the index provided.
@@ -471,7 +930,9 @@ public:
   Transform operator[](unsigned int i) const;
   /**
    * @brief Get a pointer to the Transform Buffer.
-   * @details Used to send the Buffer to a shader when rendering.
+   * @details Used to send the Buffer to a shader when rendering. The Buffer
+   * may be written through the pointer, so the bounds are recomputed the next
+   * time they are needed.
    *
    * @return A pointer to the Transform Buffer.
    */
@@ -498,13 +959,211 @@ public:
    * @param count The instance render count.
    */
   void set_instance_render_count(unsigned int count);
+  /**
+   * @brief Get the bounding box of every rendered instance.
+   * @details Recomputed first if the instances may have changed since the
+   * bounds were last computed.
+   *
+   * @return The combined AABB.
+   */
+  const AABB &get_aabb() override;
+  /**
+   * @brief Get the bounding sphere of every rendered instance.
+   * @details The sphere contains the combined AABB.
+   *
+   * @return The BoundingSphere.
+   */
+  const BoundingSphere &get_bounding_sphere() override;
+  /**
+   * @brief Recompute the bounds of every rendered instance.
+   * @details The bounds grow automatically when instances are pushed or
+   * flushed and are recomputed when the instanced Mesh or instance render
+   * count is set, or after an instance is popped or written through the
+   * subscript operator or get_instance_models(). Replacing the Transform
+   * Buffer clears the bounds so the InstancedMesh is never culled, call it
+   * after replacing the Transform Buffer. The Transform Buffer is read back to
+   * do this.
+   */
+  void update_bounds() override;
+  /**
+   * @brief Intersect a Ray with every rendered instance.
+   * @details Instances whose bounds the Ray misses are skipped without
+   * testing their triangles.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closest hit found.
+   * @return true if a closer hit was found.
+   */
+  bool raycast(const Ray &ray, Transform *parent_transform,
+               RayHit &hit) override;
 
 protected:
+  /**
+   * @brief Grow the bounds to contain a range of instances.
+   *
+   * @param models The instance Transforms.
+   * @param count The number of instances.
+   */
+  void expand_bounds(Transform *models, uint32_t count);
+  /**
+   * @brief Render the instances of a LODMesh grouped by their level.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @param parent_transform The Transform of the InstancedMesh in world space.
+   */
+  void render_levels(Camera *camera, Material *material,
+                     Transform *parent_transform);
+  /**
+   * @brief The level of each instance of a LODMesh seen by a Camera.
+   * @details The levels are reset when the instance count changes or the
+   * Transform Buffer is replaced.
+   */
+  struct LevelInstances {
+    const Camera *camera;        /**< The Camera.*/
+    std::vector<uint8_t> levels; /**< The level of each instance.*/
+    std::vector<std::vector<Transform>>
+        sorted; /**< The instance Transforms of each level on the CPU.*/
+    std::vector<Referenced<Buffer<Transform>>>
+        models; /**< The instance Transforms of each level, uploaded from
+                   sorted with one flush per level and frame.*/
+  };
+  std::vector<LevelInstances>
+      level_instances_{}; /**< The levels seen by each Camera.*/
+  LODMesh *lod_mesh_{nullptr}; /**< The instanced Mesh if it is a LODMesh.*/
   unsigned int instance_count_; /**< The current number of instances.*/
   Referenced<Buffer<Transform>>
       instance_transforms_;    /**< The Transform Buffer.*/
   Referenced<Mesh> mesh_;      /**< The Mesh that is instanced.*/
   unsigned int max_instances_; /**< The maximum number of instances allowed.*/
+  bool bounds_dirty_{false};   /**< Recompute the bounds before using them?*/
+};
+
+/**
+ * @brief A BatchedMesh packs many static SimpleMeshes that share a vertex
+ * format into shared Buffers and draws all of them with a single multi-draw.
+ * @details Each SimpleMesh becomes one draw of the batch. Its geometry is
+ * copied into shared Geometry and Index Buffers when the batch is next
+ * rendered, its Transform is written to a storage Buffer of per draw model
+ * matrices and a DrawCommand records where its indices and vertices start.
+ * Batched Materials index the per draw model matrices with the draw ID, so the
+ * whole batch is one draw call and one model upload. Materials that are not
+ * batched, such as the one drawing a ShadowMap, draw the SimpleMeshes one at a
+ * time instead.
+ *
+ * The SimpleMeshes must keep their geometry after being pushed, call
+ * update_transforms() after changing their Transforms.
+ * @see Material::is_batched()
+ * @see DrawCommand
+ */
+class BatchedMesh : public Mesh {
+public:
+  /**
+   * @brief Construct a new empty BatchedMesh object.
+   */
+  BatchedMesh() {}
+  /**
+   * @brief Destroy the BatchedMesh object.
+   */
+  virtual ~BatchedMesh() {}
+  /**
+   * @brief The implementation of the abstract render method supplied by Mesh.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material) override;
+  /**
+   * @brief The implementation of the abstract render method supplied by Mesh.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @param parent_transform The parent Transform Component.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material,
+              Transform *parent_transform) override;
+  /**
+   * @brief The implementation of the abstract render method supplied by Mesh.
+   * @details Instances of a batch are drawn one SimpleMesh at a time.
+   *
+   * @param camera The Camera to render from.
+   * @param material The Material to render with.
+   * @param parent_transform The parent Transform Component.
+   * @param instance_count The number of instances to render.
+   * @param models The Buffer of transformation matricies to use for instanced.
+   * @see Mesh
+   */
+  void render(Camera *camera, Material *material, Transform *parent_transform,
+              unsigned int instance_count, Buffer<Transform> *models) override;
+  /**
+   * @brief Add a SimpleMesh to the batch.
+   * @details The SimpleMesh must have the same DrawMethod and the same number
+   * and BufferFormats of Geometry Buffers as the first SimpleMesh in the batch
+   * and must not be multibuffered.
+   *
+   * @param mesh The SimpleMesh to add.
+   * @return false if the SimpleMesh can not be batched with the others.
+   */
+  bool push_mesh(Referenced<SimpleMesh> mesh);
+  /**
+   * @brief Remove every SimpleMesh from the batch.
+   */
+  void clear();
+  /**
+   * @brief Write the Transform of every SimpleMesh to the per draw model
+   * matrices.
+   */
+  void update_transforms();
+  /**
+   * @brief Get the number of draws in the batch.
+   *
+   * @return The number of SimpleMeshes in the batch.
+   */
+  size_t get_draw_count() const { return meshes_.size(); }
+  /**
+   * @brief Get the bounding box of every SimpleMesh in the batch.
+   *
+   * @return The combined AABB.
+   */
+  const AABB &get_aabb() override;
+  /**
+   * @brief Get the bounding sphere of every SimpleMesh in the batch.
+   * @details The sphere contains the combined AABB.
+   *
+   * @return The BoundingSphere.
+   */
+  const BoundingSphere &get_bounding_sphere() override;
+  /**
+   * @brief Combine the bounds of every SimpleMesh in the batch.
+   */
+  void update_bounds() override;
+  /**
+   * @brief Intersect a Ray with every SimpleMesh in the batch.
+   *
+   * @param ray The Ray in world space.
+   * @param parent_transform The parent Transform the Mesh is rendered with,
+   * nullptr if there is none.
+   * @param hit Updated with the closest hit found.
+   * @return true if a closer hit was found.
+   */
+  bool raycast(const Ray &ray, Transform *parent_transform,
+               RayHit &hit) override;
+
+private:
+  /**
+   * @brief Copy the geometry of every SimpleMesh into the shared Buffers and
+   * write the DrawCommands.
+   */
+  void build();
+  std::vector<Referenced<SimpleMesh>> meshes_{}; /**< The draws.*/
+  SimpleMesh packed_{};                          /**< Owns the shared Buffers.*/
+  Scoped<Buffer<DrawCommand>> commands_{};       /**< Each draw's command.*/
+  Scoped<Buffer<Transform>> models_{};           /**< Each draw's model.*/
+  bool dirty_{false};                            /**< Rebuild before drawing?*/
 };
 
 } // namespace mare
@@ -38,6 +38,7 @@ public:
     {
       set_index_buffer(index_data);
     }
+    update_bounds();
   }
 };
 
@@ -342,11 +342,26 @@ private:
     return indices.size() / 4;
   }
   void push_char(unsigned int column, unsigned int row, char letter) {
-    std::vector<glm::mat4> transforms{};
     glm::vec3 offset = glm::vec3(0.5f * static_cast<float>(column),
                                  -static_cast<float>(row), 0.0f);
     std::vector<unsigned int> indices = ASCII_font[letter];
-    for (size_t i = 0; i < indices.size() / 4; i++) {
+    size_t strokes = indices.size() / 4;
+    // the instances of the character are composed and pushed in one batch
+    std::vector<glm::vec3> node_positions{};
+    std::vector<glm::vec3> link_positions{};
+    std::vector<glm::quat> link_rotations{};
+    std::vector<glm::vec3> link_scales{};
+    node_positions.reserve(2 * strokes);
+    link_positions.reserve(strokes);
+    link_rotations.reserve(strokes);
+    link_scales.reserve(strokes);
+    glm::vec3 node_scale{1.0f};
+    glm::vec3 node_offset{0.0f};
+    if (thickness == 0.0f || extrusion != 0.0f) {
+      node_scale = glm::vec3(thickness, thickness, extrusion);
+      node_offset = glm::vec3(0.0f, 0.0f, 0.5f * extrusion);
+    }
+    for (size_t i = 0; i < strokes; i++) {
 
       glm::vec3 p1 = {0.5f * grid_points[indices[4 * i]],
                       -grid_points[indices[4 * i + 1]], 0.0f};
@@ -354,44 +369,32 @@ private:
                       -grid_points[indices[4 * i + 3]], 0.0f};
       p1 += offset;
       p2 += offset;
-      glm::vec3 p3 = 0.5f * (p1 + p2);
-      // push node instances
-      if (thickness != 0.0f && extrusion == 0.0f) {
-        nodes->push_instance(Transform(glm::translate(glm::mat4(1.0f), p1)));
-        nodes->push_instance(Transform(glm::translate(glm::mat4(1.0f), p2)));
-      } else {
-        glm::mat4 node1_instance =
-            glm::translate(glm::mat4(1.0f),
-                           p1 - glm::vec3(0.0f, 0.0f, 0.5f * extrusion)) *
-            glm::scale(glm::mat4(1.0f),
-                       glm::vec3(thickness, thickness, extrusion));
-        glm::mat4 node2_instance =
-            glm::translate(glm::mat4(1.0f),
-                           p2 - glm::vec3(0.0f, 0.0f, 0.5f * extrusion)) *
-            glm::scale(glm::mat4(1.0f),
-                       glm::vec3(thickness, thickness, extrusion));
-        nodes->push_instance(Transform(node1_instance));
-        nodes->push_instance(Transform(node2_instance));
-      }
-      // push link instance
+      // node instances
+      node_positions.push_back(p1 - node_offset);
+      node_positions.push_back(p2 - node_offset);
+      // link instance
       float angle = atan2f(p2.y - p1.y, p2.x - p1.x);
       float length = glm::length(p2 - p1);
+      link_positions.push_back(0.5f * (p1 + p2));
+      link_rotations.push_back(
+          glm::angleAxis(angle, glm::vec3(0.0f, 0.0f, 1.0f)));
       if (extrusion == 0.0f) {
-        glm::mat4 link_instance =
-            glm::translate(glm::mat4(1.0f), p3) *
-            glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 0.0f, 1.0f)) *
-            glm::scale(glm::mat4(1.0f), glm::vec3(length, 1.0f, 1.0f));
-        links->push_instance(Transform(link_instance));
+        link_scales.push_back(glm::vec3(length, 1.0f, 1.0f));
       } else {
-        glm::mat4 link_instance =
-            glm::translate(glm::mat4(1.0f), p3) *
-            glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 0.0f, 1.0f)) *
-            glm::scale(glm::mat4(1.0f), glm::vec3(length, thickness, extrusion));
-        links->push_instance(Transform(link_instance));
+        link_scales.push_back(glm::vec3(length, thickness, extrusion));
       }
 
       stroke_count++;
     }
+    std::vector<glm::quat> node_rotations(node_positions.size(),
+                                          glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    std::vector<glm::vec3> node_scales(node_positions.size(), node_scale);
+    nodes->push_instances(node_positions.data(), node_rotations.data(),
+                          node_scales.data(),
+                          static_cast<uint32_t>(node_positions.size()));
+    links->push_instances(link_positions.data(), link_rotations.data(),
+                          link_scales.data(),
+                          static_cast<uint32_t>(link_positions.size()));
   }
   bool push_instances(std::string str) {
     if (max_strokes >= count_strokes(str)) {
@@ -411,6 +414,7 @@ private:
         }
       }
       lines = row + 1;
+      update_bounds();
       return true;
     }
     return false;
@@ -40,7 +40,7 @@ public:
         Renderer::gen_buffer<float>(&verts[0], verts.size() * sizeof(float));
     vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
 
-    add_geometry_buffer(std::move(vertex_buffer));
+    add_geometry_buffer(std::move(vertex_buffer), verts.data());
   }
 };
 } // namespace mare
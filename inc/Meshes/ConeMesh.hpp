@@ -77,7 +77,7 @@ public:
     vb->set_format({{AttributeType::POSITION_3D, "position"},
                     {AttributeType::NORMAL, "normal"}});
 
-    add_geometry_buffer(std::move(vb));
+    add_geometry_buffer(std::move(vb), vertex_data.data());
   }
 };
 } // namespace mare
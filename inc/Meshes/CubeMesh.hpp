@@ -154,8 +154,8 @@ public:
     Scoped<Buffer<unsigned int>> index_buffer = Renderer::gen_buffer<uint32_t>(
         &indices[0], indices.size() * sizeof(uint32_t));
 
-    add_geometry_buffer(std::move(vertex_buffer));
-    set_index_buffer(std::move(index_buffer));
+    add_geometry_buffer(std::move(vertex_buffer), vertex_data.data());
+    set_index_buffer(std::move(index_buffer), indices.data());
   }
 };
 } // namespace mare
@@ -118,8 +118,8 @@ public:
     Referenced<Buffer<unsigned int>> index_buffer = Renderer::gen_buffer<uint32_t>(
         &indices[0], indices.size() * sizeof(uint32_t));
 
-    add_geometry_buffer(vertex_buffer);
-    set_index_buffer(index_buffer);
+    add_geometry_buffer(vertex_buffer, data.data());
+    set_index_buffer(index_buffer, indices.data());
   }
 };
 } // namespace mare
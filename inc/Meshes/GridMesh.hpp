@@ -53,8 +53,8 @@ public:
     Referenced<Buffer<uint32_t>> index_buffer = Renderer::gen_buffer<uint32_t>(
         &indes[0], indes.size() * sizeof(uint32_t), BufferType::READ_WRITE);
 
-    add_geometry_buffer(vertex_buffer);
-    set_index_buffer(index_buffer);
+    add_geometry_buffer(vertex_buffer, verts.data());
+    set_index_buffer(index_buffer, indes.data());
     indes.clear();
   }
   /**
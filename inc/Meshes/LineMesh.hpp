@@ -28,7 +28,7 @@ public:
       Referenced<Buffer<float>> vertex_buffer =
           Renderer::gen_buffer<float>(verts, sizeof(verts));
       vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
-      add_geometry_buffer(vertex_buffer);
+      add_geometry_buffer(vertex_buffer, verts);
     } else {
       float verts[12] = {
           -0.5f, -thickness*0.5f, 0.5f,  -thickness*0.5f, 0.5f,  thickness*0.5f,
@@ -38,7 +38,7 @@ public:
       Referenced<Buffer<float>> vertex_buffer =
           Renderer::gen_buffer<float>(verts, sizeof(verts));
       vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
-      add_geometry_buffer(vertex_buffer);
+      add_geometry_buffer(vertex_buffer, verts);
     }
   }
 };
@@ -41,7 +41,7 @@ public:
         Renderer::gen_buffer<float>(&verts[0], verts.size() * sizeof(float));
     vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
 
-    add_geometry_buffer(vertex_buffer);
+    add_geometry_buffer(vertex_buffer, verts.data());
   }
   /**
    * @brief Construct a new QuadrangleMesh.
@@ -75,7 +75,7 @@ public:
         Renderer::gen_buffer<float>(&verts[0], verts.size() * sizeof(float));
     vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
 
-    add_geometry_buffer(vertex_buffer);
+    add_geometry_buffer(vertex_buffer, verts.data());
   }
   /**
    * @brief Construct a new QuadrangleMesh using a util::Rect.
@@ -103,7 +103,7 @@ public:
         Renderer::gen_buffer<float>(&verts[0], verts.size() * sizeof(float));
     vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"}});
 
-    add_geometry_buffer(vertex_buffer);
+    add_geometry_buffer(vertex_buffer, verts.data());
   }
   /**
    * @brief Construct a new QuadrangleMesh with a color on each vertex
@@ -170,7 +170,7 @@ public:
     vertex_buffer->set_format({{AttributeType::POSITION_2D, "position"},
                                {AttributeType::COLOR, "color"}});
 
-    add_geometry_buffer(vertex_buffer);
+    add_geometry_buffer(vertex_buffer, data.data());
   }
 }; // namespace mare
 } // namespace mare
@@ -95,7 +95,7 @@ public:
     vertex_buffer->set_format({{AttributeType::POSITION_3D, "position"},
                                {AttributeType::NORMAL, "normal"}});
 
-    add_geometry_buffer(std::move(vertex_buffer));
+    add_geometry_buffer(std::move(vertex_buffer), vertex_data.data());
   }
 };
 } // namespace mare
@@ -116,7 +116,7 @@ public:
     vertex_buffer->set_format({{AttributeType::POSITION_3D, "position"},
                                {AttributeType::NORMAL, "normal"}});
 
-    add_geometry_buffer(std::move(vertex_buffer));
+    add_geometry_buffer(std::move(vertex_buffer), data.data());
   }
 
 private:
@@ -232,8 +232,8 @@ public:
     Scoped<Buffer<unsigned int>> index_buffer = Renderer::gen_buffer<uint32_t>(
         &indes[0], indes.size() * sizeof(uint32_t));
 
-    add_geometry_buffer(std::move(vertex_buffer));
-    set_index_buffer(std::move(index_buffer));
+    add_geometry_buffer(std::move(vertex_buffer), data.data());
+    set_index_buffer(std::move(index_buffer), indes.data());
   }
 };
 } // namespace mare
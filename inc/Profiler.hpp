@@ -0,0 +1,223 @@
+#ifndef PROFILER
+#define PROFILER
+
+// MARE
+#include "Mare.hpp"
+
+// Standard Library
+#include <atomic>
+#include <cstdint>
+#include <typeinfo>
+
+namespace mare {
+
+/**
+ * @brief A single timed event recorded by the Profiler.
+ */
+struct ProfileEvent {
+  const char *name{nullptr}; /**< Name of the event. Must outlive the
+                                Profiler, string literals and type names.*/
+  uint64_t start{0};         /**< Start time in nanoseconds.*/
+  uint64_t duration{0};      /**< Duration in nanoseconds.*/
+  uint32_t thread{0};        /**< Id of the thread that recorded the event.*/
+};
+
+/**
+ * @brief An abstract interface to GPU timer queries implemented by the
+ * Rendering API.
+ * @details Scopes are issued in order on the render thread and may be nested.
+ * Results arrive a few frames later and are recorded into the Profiler by
+ * collect().
+ */
+class GpuTimer {
+public:
+  virtual ~GpuTimer() {}
+  /**
+   * @brief Begin a GPU timed scope.
+   *
+   * @param name The name of the scope.
+   */
+  virtual void begin(const char *name) = 0;
+  /**
+   * @brief End the most recently begun GPU timed scope.
+   */
+  virtual void end() = 0;
+  /**
+   * @brief Record every finished GPU scope into the Profiler without waiting
+   * on the GPU. Called once per frame by the Rendering API.
+   */
+  virtual void collect() = 0;
+};
+
+/**
+ * @brief A frame profiler that records timed scopes into a lock-free ring
+ * buffer.
+ * @details Any thread can record events concurrently. When the ring buffer is
+ * full, the oldest events are overwritten. The recorded events can be exported
+ * as Chrome trace-event JSON and viewed in chrome://tracing or Perfetto.
+ *
+ * The Profiler is used through the MARE_PROFILE_SCOPE(name),
+ * MARE_PROFILE_GPU_SCOPE(name) and MARE_PROFILE_TYPE(object) macros which are
+ * compiled out unless MARE_PROFILING is defined.
+ */
+class Profiler {
+public:
+  /**
+   * @brief The number of events kept in the ring buffer.
+   */
+  static constexpr size_t capacity = 1 << 16;
+  /**
+   * @brief The thread id used for events timed on the GPU.
+   */
+  static constexpr uint32_t gpu_thread = 0xFFFF;
+  /**
+   * @brief Get the current time.
+   *
+   * @return The time in nanoseconds since the Profiler started.
+   */
+  static uint64_t now();
+  /**
+   * @brief Get a small id for the calling thread.
+   *
+   * @return The id of the calling thread.
+   */
+  static uint32_t thread_id();
+  /**
+   * @brief Record an event into the ring buffer.
+   *
+   * @param name The name of the event.
+   * @param start The start time in nanoseconds.
+   * @param duration The duration in nanoseconds.
+   * @param thread The id of the thread the event belongs to.
+   */
+  static void record(const char *name, uint64_t start, uint64_t duration,
+                     uint32_t thread);
+  /**
+   * @brief Discard every recorded event.
+   */
+  static void clear();
+  /**
+   * @brief Copy the recorded events out of the ring buffer, oldest first.
+   * @details Should be called while no other thread is recording, for example
+   * between frames.
+   *
+   * @return The recorded events.
+   */
+  static std::vector<ProfileEvent> events();
+  /**
+   * @brief Write the recorded events as Chrome trace-event JSON.
+   *
+   * @param filepath The file to write.
+   * @return true if the file was written.
+   */
+  static bool write_chrome_trace(const char *filepath);
+  /**
+   * @brief Set the GpuTimer used by MARE_PROFILE_GPU_SCOPE(name).
+   * @details Set by the Rendering API. nullptr disables GPU timing.
+   *
+   * @param timer The GpuTimer.
+   */
+  static void set_gpu_timer(GpuTimer *timer) { gpu_timer_ = timer; }
+  /**
+   * @brief Get the GpuTimer used by MARE_PROFILE_GPU_SCOPE(name).
+   *
+   * @return The GpuTimer or nullptr if GPU timing is disabled.
+   */
+  static GpuTimer *get_gpu_timer() { return gpu_timer_; }
+  /**
+   * @brief Enable or disable GPU timer queries.
+   * @details The Rendering API creates its GpuTimer at initialization if this
+   * is enabled.
+   *
+   * @param enable true to enable GPU timer queries.
+   */
+  static void enable_gpu_timing(bool enable) { gpu_timing_ = enable; }
+  /**
+   * @brief Check if GPU timer queries are enabled.
+   *
+   * @return true if GPU timer queries are enabled.
+   */
+  static bool gpu_timing_enabled() { return gpu_timing_; }
+
+private:
+  /**
+   * @brief Get the ring buffer, allocated on first use so it costs nothing
+   * when the Profiler is unused.
+   *
+   * @return A pointer to the first event of the ring buffer.
+   */
+  static ProfileEvent *ring();
+  static std::atomic<uint64_t> write_index_; /**< Total events recorded.*/
+  static GpuTimer *gpu_timer_;               /**< The GPU timer.*/
+  static bool gpu_timing_;                   /**< GPU timing enabled?*/
+};
+
+/**
+ * @brief Records the lifetime of a scope into the Profiler.
+ */
+class ProfileScope {
+public:
+  /**
+   * @brief Begin a timed scope.
+   *
+   * @param name The name of the scope.
+   * @param gpu true to also time the scope on the GPU if GPU timing is
+   * enabled.
+   */
+  ProfileScope(const char *name, bool gpu = false)
+      : name_(name), start_(Profiler::now()),
+        gpu_timer_(gpu ? Profiler::get_gpu_timer() : nullptr) {
+    if (gpu_timer_) {
+      gpu_timer_->begin(name);
+    }
+  }
+  /**
+   * @brief End the timed scope and record it.
+   */
+  ~ProfileScope() {
+    if (gpu_timer_) {
+      gpu_timer_->end();
+    }
+    Profiler::record(name_, start_, Profiler::now() - start_,
+                     Profiler::thread_id());
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  const char *name_;
+  uint64_t start_;
+  GpuTimer *gpu_timer_;
+};
+
+} // namespace mare
+
+#define MARE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MARE_PROFILE_CONCAT(a, b) MARE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef MARE_PROFILING
+/**
+ * @brief Time the enclosing scope on the CPU.
+ */
+#define MARE_PROFILE_SCOPE(name)                                               \
+  ::mare::ProfileScope MARE_PROFILE_CONCAT(mare_profile_scope_, __LINE__)(name)
+/**
+ * @brief Time the enclosing scope on the CPU and, if enabled, on the GPU.
+ */
+#define MARE_PROFILE_GPU_SCOPE(name)                                           \
+  ::mare::ProfileScope MARE_PROFILE_CONCAT(mare_profile_scope_,                \
+                                           __LINE__)(name, true)
+/**
+ * @brief Time the enclosing scope on the CPU named by the concrete type of a
+ * polymorphic object.
+ */
+#define MARE_PROFILE_TYPE(object)                                              \
+  ::mare::ProfileScope MARE_PROFILE_CONCAT(mare_profile_scope_,                \
+                                           __LINE__)(typeid(object).name())
+#else
+#define MARE_PROFILE_SCOPE(name)
+#define MARE_PROFILE_GPU_SCOPE(name)
+#define MARE_PROFILE_TYPE(object)
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef READBACK
+#define READBACK
+
+// Standard Library
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+// forward declarations
+class Entity;
+class Framebuffer;
+class Mesh;
+
+/**
+ * @brief The result of an asynchronous read of the depth buffer under a point
+ * on the screen.
+ * @details The result is filled in by the Renderer one or more frames after it
+ * was requested. Until then ready is false and the other values are undefined.
+ * @see Renderer::raycast_async()
+ */
+struct PixelReadback {
+  glm::ivec2 screen_coords{0}; /**< The screen coordinates that were read.*/
+  float depth{1.0f};           /**< The depth buffer value from 0 to 1.*/
+  glm::vec3 position{0.0f};    /**< The world space position of the depth.*/
+  bool ready{false};           /**< Has the result arrived?*/
+};
+
+/**
+ * @brief A function called when a PixelReadback arrives.
+ */
+using ReadbackCallback = std::function<void(const PixelReadback &)>;
+
+/**
+ * @brief A rectangle of pixels in screen coordinates.
+ */
+struct PixelRect {
+  glm::ivec2 min{0}; /**< The first pixel of the rectangle.*/
+  glm::ivec2 max{0}; /**< One past the last pixel of the rectangle.*/
+  /**
+   * @brief Get the number of pixels in the rectangle.
+   *
+   * @return The number of pixels.
+   */
+  size_t area() const { return size_t(max.x - min.x) * size_t(max.y - min.y); }
+};
+
+/**
+ * @brief A render packet drawn by the Entity ID pass.
+ * @see Renderer::resolve_id()
+ */
+struct PickTarget {
+  Entity *entity{nullptr}; /**< The RenderPack Entity that owns the packet.*/
+  Mesh *mesh{nullptr};     /**< The Mesh of the packet.*/
+  /**
+   * @brief Does the PickTarget refer to a packet?
+   */
+  explicit operator bool() const { return entity != nullptr; }
+};
+
+/**
+ * @brief The result of an asynchronous read of the Entity ID pass.
+ * @details Filled in by the Renderer one or more frames after it was
+ * requested. Until then ready is false and targets is empty.
+ * @see Renderer::pick_async()
+ */
+struct IDReadback {
+  PixelRect rect{};                  /**< The pixels that were read.*/
+  std::vector<PickTarget> targets{}; /**< Each packet seen in rect once.*/
+  bool ready{false};                 /**< Has the result arrived?*/
+};
+
+/**
+ * @brief A function called when an IDReadback arrives.
+ */
+using IDReadbackCallback = std::function<void(const IDReadback &)>;
+
+/**
+ * @brief The interface the Rendering API implements to read pixels back from
+ * the framebuffer without waiting on the GPU.
+ * @details The Renderer collects the pixels requested during a frame into a
+ * batch, starts reading the whole batch once the frame has been rendered and
+ * polls for finished batches once per frame. Batches finish in the order they
+ * were started.
+ */
+class PixelReader {
+public:
+  virtual ~PixelReader() {}
+  /**
+   * @brief Start reading the depth of a batch of pixels from the default
+   * framebuffer.
+   *
+   * @param pixels The screen coordinates of each pixel.
+   * @return false if too many batches are in flight, try again next frame.
+   */
+  virtual bool read(const std::vector<glm::ivec2> &pixels) = 0;
+  /**
+   * @brief Get the depths of the oldest batch if the GPU has finished it.
+   * @details Never waits on the GPU.
+   *
+   * @param depths Set to the depth of each pixel of the batch.
+   * @return true if the oldest batch was finished and \p depths was set.
+   */
+  virtual bool poll(std::vector<float> &depths) = 0;
+  /**
+   * @brief Start reading a batch of rectangles from the R32UI color texture of
+   * a Framebuffer.
+   *
+   * @param framebuffer The Framebuffer to read from.
+   * @param rects The rectangles in screen coordinates.
+   * @return false if too many batches are in flight, try again next frame.
+   */
+  virtual bool read_ids(Framebuffer *framebuffer,
+                        const std::vector<PixelRect> &rects) = 0;
+  /**
+   * @brief Get the values of the oldest batch of rectangles if the GPU has
+   * finished it.
+   * @details Never waits on the GPU.
+   *
+   * @param ids Set to the values of each rectangle in order, row by row from
+   * the bottom row of each rectangle.
+   * @return true if the oldest batch was finished and \p ids was set.
+   */
+  virtual bool poll_ids(std::vector<uint32_t> &ids) = 0;
+};
+
+} // namespace mare
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef RENDERQUEUE
+#define RENDERQUEUE
+
+// MARE
+#include "Buffers.hpp"
+#include "Components/Transform.hpp"
+
+// Standard Library
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mare {
+
+// forward declarations
+class Camera;
+class Material;
+class SimpleMesh;
+
+/**
+ * @brief The fixed function state set through the Renderer.
+ * @see Renderer::get_render_state()
+ */
+struct RenderState {
+  bool depth_testing{false}; /**< Is depth testing enabled?*/
+  bool face_culling{false};  /**< Is face culling enabled?*/
+  bool blending{false};      /**< Is blending enabled?*/
+};
+
+/**
+ * @brief A single draw of a SimpleMesh recorded into a RenderQueue.
+ */
+struct RenderItem {
+  uint64_t key;                  /**< The sort key of the draw.*/
+  RenderState state;             /**< The state the draw was recorded with.*/
+  Camera *camera;                /**< The Camera to render from.*/
+  SimpleMesh *mesh;              /**< The SimpleMesh to draw.*/
+  Material *material;            /**< The Material to draw with.*/
+  Transform parent_transform;    /**< A copy of the parent Transform.*/
+  bool has_parent;               /**< Was the draw given a parent Transform?*/
+  unsigned int instance_count;   /**< The number of instances or draws, 0 if
+                                    not instanced.*/
+  Buffer<Transform> *models;     /**< The instance or draw Transforms.*/
+  Buffer<DrawCommand> *commands; /**< The draws of a multi-draw, nullptr if
+                                    not a multi-draw.*/
+};
+
+/**
+ * @brief Records draws of SimpleMeshes and submits them sorted by the state
+ * they need.
+ * @details Each draw records the RenderState it was pushed with and gets a
+ * 64-bit key. The most significant bits hold the pass and then the order of
+ * the draw:
+ * - Opaque draws come first. Their key packs the shader program, the vertex
+ *   array, the Material and the view depth, so draws that share a program,
+ *   vertex array or Material end up next to each other and that state is only
+ *   bound when it changes. Within them draws are ordered front to back.
+ * - Blended draws come next, ordered back to front.
+ * - Draws without depth testing come last, in the order they were pushed.
+ *
+ * The keys are radix sorted once per submit. The low bits of the keys of
+ * blended draws and draws without depth testing hold the order they were
+ * pushed in, and the sort is stable, so draws with equal keys are always drawn
+ * in the order they were pushed.
+ * @see Renderer::submit()
+ */
+class RenderQueue {
+public:
+  /**
+   * @brief Record a draw.
+   * @details The Meshes, Materials, Camera and instance Buffer must stay alive
+   * until the queue is submitted. The parent Transform and the current
+   * RenderState are copied.
+   *
+   * @param camera The Camera to render from.
+   * @param mesh The SimpleMesh to draw.
+   * @param material The Material to draw with.
+   * @param parent_transform The parent Transform, may be nullptr.
+   * @param instance_count The number of instances or draws, 0 if not
+   * instanced.
+   * @param models The instance or draw Transforms, nullptr if not instanced.
+   * @param commands The draws of a multi-draw, nullptr if not a multi-draw.
+   */
+  void push(Camera *camera, SimpleMesh *mesh, Material *material,
+            Transform *parent_transform, unsigned int instance_count = 0,
+            Buffer<Transform> *models = nullptr,
+            Buffer<DrawCommand> *commands = nullptr);
+  /**
+   * @brief Set the pass of the draws recorded from now on.
+   * @details Passes are drawn in increasing order.
+   *
+   * @param pass The pass from 0 to 15.
+   */
+  void set_pass(uint8_t pass) { pass_ = pass & 0xF; }
+  /**
+   * @brief Sort and draw every recorded draw, then clear the queue.
+   * @details The RenderState of each draw is set before it is drawn and the
+   * RenderState from before the submit is set again afterwards.
+   */
+  void submit();
+  /**
+   * @brief Remove every recorded draw without drawing it.
+   */
+  void clear();
+  /**
+   * @brief Get the number of recorded draws.
+   *
+   * @return The number of draws.
+   */
+  size_t size() const { return items_.size(); }
+  /**
+   * @brief Check if the queue has no draws.
+   *
+   * @return true if the queue is empty.
+   */
+  bool empty() const { return items_.empty(); }
+  /**
+   * @brief Pack the state of an opaque draw into a sort key.
+   *
+   * @param pass The pass, 4 bits.
+   * @param program The shader program name, 12 bits.
+   * @param vertex_array The vertex array name, 16 bits.
+   * @param material The index of the Material in the queue, 14 bits.
+   * @param depth The view depth of the draw.
+   * @return The key.
+   */
+  static uint64_t make_key(uint8_t pass, uint32_t program,
+                           uint32_t vertex_array, uint32_t material,
+                           float depth);
+  /**
+   * @brief Pack a blended draw into a sort key that orders it back to front.
+   *
+   * @param pass The pass, 4 bits.
+   * @param depth The view depth of the draw.
+   * @param sequence The number of draws pushed before it, 26 bits.
+   * @return The key.
+   */
+  static uint64_t make_blended_key(uint8_t pass, float depth,
+                                   uint32_t sequence);
+  /**
+   * @brief Pack a draw without depth testing into a sort key that keeps the
+   * order it was pushed in.
+   *
+   * @param pass The pass, 4 bits.
+   * @param sequence The number of draws pushed before it.
+   * @return The key.
+   */
+  static uint64_t make_ordered_key(uint8_t pass, uint32_t sequence);
+
+private:
+  /**
+   * @brief Radix sort the indices of the draws by their keys into order_.
+   */
+  void sort();
+  std::vector<RenderItem> items_{}; /**< The recorded draws.*/
+  std::vector<uint32_t> order_{};   /**< The draws in sorted order.*/
+  std::vector<uint32_t> scratch_{}; /**< Scratch indices for sorting.*/
+  std::unordered_map<Material *, uint32_t>
+      materials_{}; /**< The index of each Material in the queue.*/
+  uint8_t pass_{0}; /**< The pass of new draws.*/
+};
+
+} // namespace mare
+
+#endif
@@ -2,25 +2,41 @@
 #define RENDERER
 
 // Standard Library
+#include <array>
 #include <bitset>
+#include <deque>
 #include <iostream>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 
 // MARE
+#include "Bounds.hpp"
 #include "Buffers.hpp"
 #include "GL/GLBuffers.hpp"
+#include "GeometryHeap.hpp"
+#include "Headless/HeadlessBuffers.hpp"
+#include "Input.hpp"
+#include "JobSystem.hpp"
 #include "Mare.hpp"
+#include "Readback.hpp"
+#include "RenderQueue.hpp"
 #include "Shader.hpp"
+#include "TypeIndex.hpp"
 
 namespace mare {
 // Forward Declarations
+class Mesh;
 class SimpleMesh;
 class UIElement;
 class Layer;
 class Camera;
 class Scene;
+class Entity;
+class IPhysicsSystem;
+class IControlsSystem;
+class CommandBuffer;
+class EntityIDMaterial;
 
 /**
  * @brief The available cursors for the application to use.
@@ -41,7 +57,8 @@ enum class RendererAPI {
   NONE = 0,   /**< No API selected.*/
   OpenGL_4_5, /**< OpenGL 4.5 API.*/
   DirectX_12, /**< DirectX 12 API (Not supported yet).*/
-  Vulkan      /**< Vulkan API (Not supported yet).*/
+  Vulkan,     /**< Vulkan API (Not supported yet).*/
+  Headless    /**< Windowless API that records commands into host memory.*/
 };
 
 /**
@@ -66,344 +83,31 @@ struct RendererInfo {
       1}; /**< 0000 == off, 0001 == high, 0010 == med, 0100
             == low, 1000 == notification*/
   RendererAPI API{RendererAPI::NONE}; /**< The Rendering API.*/
-};
-
-// This input is passed by reference to the callbacks which decide what to do
-// with it
-/**
- * @brief RendererInput contains the user input and is passed by reference to
- * the callbacks which decide what to do.
- * @details Keyboard and mouse input as well as mouse position and velocity.
- */
-struct RendererInput {
-  short mouse_scroll{}; /**< 0 == no scroll, 1 == scroll up, -1 = scroll down*/
-  glm::ivec2 mouse_pos{}; /**< window coordinates of mouse position (in pixels
-                             from top left corner)*/
-  glm::ivec2 mouse_vel{}; /**< window coordinates of mouse velocity (in
-                             pixels/frame from top left corner)*/
-  // Mouse clicks
-  bool LEFT_MOUSE_PRESSED{false};
-  bool MIDDLE_MOUSE_PRESSED{false};
-  bool RIGHT_MOUSE_PRESSED{false};
-  bool LEFT_MOUSE_JUST_PRESSED{false};
-  bool MIDDLE_MOUSE_JUST_PRESSED{false};
-  bool RIGHT_MOUSE_JUST_PRESSED{false};
-  bool LEFT_MOUSE_JUST_RELEASED{false};
-  bool MIDDLE_MOUSE_JUST_RELEASED{false};
-  bool RIGHT_MOUSE_JUST_RELEASED{false};
-  // Key presses
-  bool SPACE_PRESSED{false};
-  bool SPACE_JUST_PRESSED{false};
-  bool SPACE_JUST_RELEASED{false};
-  bool APOSTROPHE_PRESSED{false};
-  bool APOSTROPHE_JUST_PRESSED{false};
-  bool APOSTROPHE_JUST_RELEASED{false};
-  bool COMMA_PRESSED{false};
-  bool COMMA_JUST_PRESSED{false};
-  bool COMMA_JUST_RELEASED{false};
-  bool MINUS_PRESSED{false};
-  bool MINUS_JUST_PRESSED{false};
-  bool MINUS_JUST_RELEASED{false};
-  bool PERIOD_PRESSED{false};
-  bool PERIOD_JUST_PRESSED{false};
-  bool PERIOD_JUST_RELEASED{false};
-  bool FORWARD_SLASH_PRESSED{false};
-  bool FORWARD_SLASH_JUST_PRESSED{false};
-  bool FORWARD_SLASH_JUST_RELEASED{false};
-  bool ZERO_PRESSED{false};
-  bool ZERO_JUST_PRESSED{false};
-  bool ZERO_JUST_RELEASED{false};
-  bool ONE_PRESSED{false};
-  bool ONE_JUST_PRESSED{false};
-  bool ONE_JUST_RELEASED{false};
-  bool TWO_PRESSED{false};
-  bool TWO_JUST_PRESSED{false};
-  bool TWO_JUST_RELEASED{false};
-  bool THREE_PRESSED{false};
-  bool THREE_JUST_PRESSED{false};
-  bool THREE_JUST_RELEASED{false};
-  bool FOUR_PRESSED{false};
-  bool FOUR_JUST_PRESSED{false};
-  bool FOUR_JUST_RELEASED{false};
-  bool FIVE_PRESSED{false};
-  bool FIVE_JUST_PRESSED{false};
-  bool FIVE_JUST_RELEASED{false};
-  bool SIX_PRESSED{false};
-  bool SIX_JUST_PRESSED{false};
-  bool SIX_JUST_RELEASED{false};
-  bool SEVEN_PRESSED{false};
-  bool SEVEN_JUST_PRESSED{false};
-  bool SEVEN_JUST_RELEASED{false};
-  bool EIGHT_PRESSED{false};
-  bool EIGHT_JUST_PRESSED{false};
-  bool EIGHT_JUST_RELEASED{false};
-  bool NINE_PRESSED{false};
-  bool NINE_JUST_PRESSED{false};
-  bool NINE_JUST_RELEASED{false};
-  bool SEMICOLON_PRESSED{false};
-  bool SEMICOLON_JUST_PRESSED{false};
-  bool SEMICOLON_JUST_RELEASED{false};
-  bool EQUAL_PRESSED{false};
-  bool EQUAL_JUST_PRESSED{false};
-  bool EQUAL_JUST_RELEASED{false};
-  bool A_PRESSED{false};
-  bool A_JUST_PRESSED{false};
-  bool A_JUST_RELEASED{false};
-  bool B_PRESSED{false};
-  bool B_JUST_PRESSED{false};
-  bool B_JUST_RELEASED{false};
-  bool C_PRESSED{false};
-  bool C_JUST_PRESSED{false};
-  bool C_JUST_RELEASED{false};
-  bool D_PRESSED{false};
-  bool D_JUST_PRESSED{false};
-  bool D_JUST_RELEASED{false};
-  bool E_PRESSED{false};
-  bool E_JUST_PRESSED{false};
-  bool E_JUST_RELEASED{false};
-  bool F_PRESSED{false};
-  bool F_JUST_PRESSED{false};
-  bool F_JUST_RELEASED{false};
-  bool G_PRESSED{false};
-  bool G_JUST_PRESSED{false};
-  bool G_JUST_RELEASED{false};
-  bool H_PRESSED{false};
-  bool H_JUST_PRESSED{false};
-  bool H_JUST_RELEASED{false};
-  bool I_PRESSED{false};
-  bool I_JUST_PRESSED{false};
-  bool I_JUST_RELEASED{false};
-  bool J_PRESSED{false};
-  bool J_JUST_PRESSED{false};
-  bool J_JUST_RELEASED{false};
-  bool K_PRESSED{false};
-  bool K_JUST_PRESSED{false};
-  bool K_JUST_RELEASED{false};
-  bool L_PRESSED{false};
-  bool L_JUST_PRESSED{false};
-  bool L_JUST_RELEASED{false};
-  bool M_PRESSED{false};
-  bool M_JUST_PRESSED{false};
-  bool M_JUST_RELEASED{false};
-  bool N_PRESSED{false};
-  bool N_JUST_PRESSED{false};
-  bool N_JUST_RELEASED{false};
-  bool O_PRESSED{false};
-  bool O_JUST_PRESSED{false};
-  bool O_JUST_RELEASED{false};
-  bool P_PRESSED{false};
-  bool P_JUST_PRESSED{false};
-  bool P_JUST_RELEASED{false};
-  bool Q_PRESSED{false};
-  bool Q_JUST_PRESSED{false};
-  bool Q_JUST_RELEASED{false};
-  bool R_PRESSED{false};
-  bool R_JUST_PRESSED{false};
-  bool R_JUST_RELEASED{false};
-  bool S_PRESSED{false};
-  bool S_JUST_PRESSED{false};
-  bool S_JUST_RELEASED{false};
-  bool T_PRESSED{false};
-  bool T_JUST_PRESSED{false};
-  bool T_JUST_RELEASED{false};
-  bool U_PRESSED{false};
-  bool U_JUST_PRESSED{false};
-  bool U_JUST_RELEASED{false};
-  bool V_PRESSED{false};
-  bool V_JUST_PRESSED{false};
-  bool V_JUST_RELEASED{false};
-  bool W_PRESSED{false};
-  bool W_JUST_PRESSED{false};
-  bool W_JUST_RELEASED{false};
-  bool X_PRESSED{false};
-  bool X_JUST_PRESSED{false};
-  bool X_JUST_RELEASED{false};
-  bool Y_PRESSED{false};
-  bool Y_JUST_PRESSED{false};
-  bool Y_JUST_RELEASED{false};
-  bool Z_PRESSED{false};
-  bool Z_JUST_PRESSED{false};
-  bool Z_JUST_RELEASED{false};
-  bool LEFT_BRACKET_PRESSED{false};
-  bool LEFT_BRACKET_JUST_PRESSED{false};
-  bool LEFT_BRACKET_JUST_RELEASED{false};
-  bool RIGHT_BRACKET_PRESSED{false};
-  bool RIGHT_BRACKET_JUST_PRESSED{false};
-  bool RIGHT_BRACKET_JUST_RELEASED{false};
-  bool GRAVE_ACCENT_PRESSED{false};
-  bool GRAVE_ACCENT_JUST_PRESSED{false};
-  bool GRAVE_ACCENT_JUST_RELEASED{false};
-  bool ESCAPE_PRESSED{false};
-  bool ESCAPE_JUST_PRESSED{false};
-  bool ESCAPE_JUST_RELEASED{false};
-  bool ENTER_PRESSED{false};
-  bool ENTER_JUST_PRESSED{false};
-  bool ENTER_JUST_RELEASED{false};
-  bool TAB_PRESSED{false};
-  bool TAB_JUST_PRESSED{false};
-  bool TAB_JUST_RELEASED{false};
-  bool BACKSPACE_PRESSED{false};
-  bool BACKSPACE_JUST_PRESSED{false};
-  bool BACKSPACE_JUST_RELEASED{false};
-  bool INSERT_PRESSED{false};
-  bool INSERT_JUST_PRESSED{false};
-  bool INSERT_JUST_RELEASED{false};
-  bool DELETE_PRESSED{false};
-  bool DELETE_JUST_PRESSED{false};
-  bool DELETE_JUST_RELEASED{false};
-  bool RIGHT_PRESSED{false};
-  bool RIGHT_JUST_PRESSED{false};
-  bool RIGHT_JUST_RELEASED{false};
-  bool LEFT_PRESSED{false};
-  bool LEFT_JUST_PRESSED{false};
-  bool LEFT_JUST_RELEASED{false};
-  bool UP_PRESSED{false};
-  bool UP_JUST_PRESSED{false};
-  bool UP_JUST_RELEASED{false};
-  bool DOWN_PRESSED{false};
-  bool DOWN_JUST_PRESSED{false};
-  bool DOWN_JUST_RELEASED{false};
-  bool PAGE_UP_PRESSED{false};
-  bool PAGE_UP_JUST_PRESSED{false};
-  bool PAGE_UP_JUST_RELEASED{false};
-  bool PAGE_DOWN_PRESSED{false};
-  bool PAGE_DOWN_JUST_PRESSED{false};
-  bool PAGE_DOWN_JUST_RELEASED{false};
-  bool HOME_PRESSED{false};
-  bool HOME_JUST_PRESSED{false};
-  bool HOME_JUST_RELEASED{false};
-  bool END_PRESSED{false};
-  bool END_JUST_PRESSED{false};
-  bool END_JUST_RELEASED{false};
-  bool CAPS_LOCK_PRESSED{false};
-  bool CAPS_LOCK_JUST_PRESSED{false};
-  bool CAPS_LOCK_JUST_RELEASED{false};
-  bool SCROLL_LOCK_PRESSED{false};
-  bool SCROLL_LOCK_JUST_PRESSED{false};
-  bool SCROLL_LOCK_JUST_RELEASED{false};
-  bool NUM_LOCK_PRESSED{false};
-  bool NUM_LOCK_JUST_PRESSED{false};
-  bool NUM_LOCK_JUST_RELEASED{false};
-  bool PRINT_SCREEN_PRESSED{false};
-  bool PRINT_SCREEN_JUST_PRESSED{false};
-  bool PRINT_SCREEN_JUST_RELEASED{false};
-  bool PAUSE_PRESSED{false};
-  bool PAUSE_JUST_PRESSED{false};
-  bool PAUSE_JUST_RELEASED{false};
-  bool F1_PRESSED{false};
-  bool F1_JUST_PRESSED{false};
-  bool F1_JUST_RELEASED{false};
-  bool F2_PRESSED{false};
-  bool F2_JUST_PRESSED{false};
-  bool F2_JUST_RELEASED{false};
-  bool F3_PRESSED{false};
-  bool F3_JUST_PRESSED{false};
-  bool F3_JUST_RELEASED{false};
-  bool F4_PRESSED{false};
-  bool F4_JUST_PRESSED{false};
-  bool F4_JUST_RELEASED{false};
-  bool F5_PRESSED{false};
-  bool F5_JUST_PRESSED{false};
-  bool F5_JUST_RELEASED{false};
-  bool F6_PRESSED{false};
-  bool F6_JUST_PRESSED{false};
-  bool F6_JUST_RELEASED{false};
-  bool F7_PRESSED{false};
-  bool F7_JUST_PRESSED{false};
-  bool F7_JUST_RELEASED{false};
-  bool F8_PRESSED{false};
-  bool F8_JUST_PRESSED{false};
-  bool F8_JUST_RELEASED{false};
-  bool F9_PRESSED{false};
-  bool F9_JUST_PRESSED{false};
-  bool F9_JUST_RELEASED{false};
-  bool F10_PRESSED{false};
-  bool F10_JUST_PRESSED{false};
-  bool F10_JUST_RELEASED{false};
-  bool F11_PRESSED{false};
-  bool F11_JUST_PRESSED{false};
-  bool F11_JUST_RELEASED{false};
-  bool F12_PRESSED{false};
-  bool F12_JUST_PRESSED{false};
-  bool F12_JUST_RELEASED{false};
-  bool KEY_PAD_0_PRESSED{false};
-  bool KEY_PAD_0_JUST_PRESSED{false};
-  bool KEY_PAD_0_JUST_RELEASED{false};
-  bool KEY_PAD_1_PRESSED{false};
-  bool KEY_PAD_1_JUST_PRESSED{false};
-  bool KEY_PAD_1_JUST_RELEASED{false};
-  bool KEY_PAD_2_PRESSED{false};
-  bool KEY_PAD_2_JUST_PRESSED{false};
-  bool KEY_PAD_2_JUST_RELEASED{false};
-  bool KEY_PAD_3_PRESSED{false};
-  bool KEY_PAD_3_JUST_PRESSED{false};
-  bool KEY_PAD_3_JUST_RELEASED{false};
-  bool KEY_PAD_4_PRESSED{false};
-  bool KEY_PAD_4_JUST_PRESSED{false};
-  bool KEY_PAD_4_JUST_RELEASED{false};
-  bool KEY_PAD_5_PRESSED{false};
-  bool KEY_PAD_5_JUST_PRESSED{false};
-  bool KEY_PAD_5_JUST_RELEASED{false};
-  bool KEY_PAD_6_PRESSED{false};
-  bool KEY_PAD_6_JUST_PRESSED{false};
-  bool KEY_PAD_6_JUST_RELEASED{false};
-  bool KEY_PAD_7_PRESSED{false};
-  bool KEY_PAD_7_JUST_PRESSED{false};
-  bool KEY_PAD_7_JUST_RELEASED{false};
-  bool KEY_PAD_8_PRESSED{false};
-  bool KEY_PAD_8_JUST_PRESSED{false};
-  bool KEY_PAD_8_JUST_RELEASED{false};
-  bool KEY_PAD_9_PRESSED{false};
-  bool KEY_PAD_9_JUST_PRESSED{false};
-  bool KEY_PAD_9_JUST_RELEASED{false};
-  bool KEY_PAD_DECIMAL_PRESSED{false};
-  bool KEY_PAD_DECIMAL_JUST_PRESSED{false};
-  bool KEY_PAD_DECIMAL_JUST_RELEASED{false};
-  bool KEY_PAD_DIVIDE_PRESSED{false};
-  bool KEY_PAD_DIVIDE_JUST_PRESSED{false};
-  bool KEY_PAD_DIVIDE_JUST_RELEASED{false};
-  bool KEY_PAD_MULTIPLY_PRESSED{false};
-  bool KEY_PAD_MULTIPLY_JUST_PRESSED{false};
-  bool KEY_PAD_MULTIPLY_JUST_RELEASED{false};
-  bool KEY_PAD_SUBTRACT_PRESSED{false};
-  bool KEY_PAD_SUBTRACT_JUST_PRESSED{false};
-  bool KEY_PAD_SUBTRACT_JUST_RELEASED{false};
-  bool KEY_PAD_ADD_PRESSED{false};
-  bool KEY_PAD_ADD_JUST_PRESSED{false};
-  bool KEY_PAD_ADD_JUST_RELEASED{false};
-  bool KEY_PAD_ENTER_PRESSED{false};
-  bool KEY_PAD_ENTER_JUST_PRESSED{false};
-  bool KEY_PAD_ENTER_JUST_RELEASED{false};
-  bool KEY_PAD_EQUAL_PRESSED{false};
-  bool KEY_PAD_EQUAL_JUST_PRESSED{false};
-  bool KEY_PAD_EQUAL_JUST_RELEASED{false};
-  bool LEFT_SHIFT_PRESSED{false};
-  bool LEFT_SHIFT_JUST_PRESSED{false};
-  bool LEFT_SHIFT_JUST_RELEASED{false};
-  bool LEFT_CONTROL_PRESSED{false};
-  bool LEFT_CONTROL_JUST_PRESSED{false};
-  bool LEFT_CONTROL_JUST_RELEASED{false};
-  bool LEFT_ALT_PRESSED{false};
-  bool LEFT_ALT_JUST_PRESSED{false};
-  bool LEFT_ALT_JUST_RELEASED{false};
-  bool LEFT_SUPER_PRESSED{false};
-  bool LEFT_SUPER_JUST_PRESSED{false};
-  bool LEFT_SUPER_JUST_RELEASED{false};
-  bool RIGHT_SHIFT_PRESSED{false};
-  bool RIGHT_SHIFT_JUST_PRESSED{false};
-  bool RIGHT_SHIFT_JUST_RELEASED{false};
-  bool RIGHT_CONTROL_PRESSED{false};
-  bool RIGHT_CONTROL_JUST_PRESSED{false};
-  bool RIGHT_CONTROL_JUST_RELEASED{false};
-  bool RIGHT_ALT_PRESSED{false};
-  bool RIGHT_ALT_JUST_PRESSED{false};
-  bool RIGHT_ALT_JUST_RELEASED{false};
-  bool RIGHT_SUPER_PRESSED{false};
-  bool RIGHT_SUPER_JUST_PRESSED{false};
-  bool RIGHT_SUPER_JUST_RELEASED{false};
-  bool MENU_PRESSED{false};
-  bool MENU_JUST_PRESSED{false};
-  bool MENU_JUST_RELEASED{false};
+  unsigned int physics_threads{0}; /**< Worker threads used by the physics
+                                      phase, 0 == hardware threads - 1*/
+  size_t physics_grain_size{64}; /**< Physics updates per job system task*/
+  float fixed_timestep{0.0f}; /**< Physics step in seconds, 0 == step once per
+                                 frame with the frame time*/
+  unsigned int max_physics_steps{8}; /**< Maximum fixed physics steps per
+                                        frame, leftover time is dropped*/
+  float interpolation_alpha{1.0f}; /**< Fraction of a fixed step left over
+                                      after the physics phase, used to
+                                      interpolate rendering between steps*/
+  bool frustum_culling{true}; /**< Skip render packets outside the Camera's
+                                 frustum?*/
+  uint32_t packets_drawn{0};  /**< Render packets drawn in the last frame*/
+  uint32_t packets_culled{0}; /**< Render packets culled in the last frame*/
+  bool id_pass{false}; /**< Render the Entity ID pass every frame?*/
+  bool render_queue{true}; /**< Allow Layers that opt in with
+                              Layer::use_render_queue() to sort their render
+                              packets by state?*/
+  uint32_t state_changes_issued{0};  /**< Render state changes passed on to
+                                        the Rendering API in the last frame*/
+  uint32_t state_changes_skipped{0}; /**< Redundant render state changes
+                                        dropped in the last frame*/
+  size_t geometry_heap_page_size{
+      size_t(32) << 20}; /**< Size in bytes of each GeometryHeap page, 0 ==
+                            static Geometry Buffers keep their own buffer*/
 };
 
 /**
@@ -550,6 +254,15 @@ public:
    * @param color The color to clear the color buffer to.
    */
   virtual void api_clear_color_buffer(glm::vec4 color) = 0;
+  /**
+   * @brief Interface for clearing an integer color buffer implemented by the
+   * Rendering API.
+   * @details Clear the integer color buffer of the framebuffer to a single
+   * value.
+   *
+   * @param color The value to clear the color buffer to.
+   */
+  virtual void api_clear_color_buffer(glm::uvec4 color) = 0;
   /**
    * @brief Interface for clearing the depth buffer implemented by the Rendering
    * API.
@@ -602,6 +315,17 @@ public:
    * @param enable true enables blending and false disables blending.
    */
   virtual void api_enable_blending(bool enable) = 0;
+  /**
+   * @brief Enable or disable the depth offset of filled polygons, implemented
+   * by the Rendering API.
+   * @details Used by depth only passes such as shadow maps to push depth
+   * values away from the light and avoid self shadowing.
+   * @param enable true enables the offset and false disables it.
+   * @param factor The offset scaled by the depth slope of each polygon.
+   * @param units The offset in units of the depth buffer resolution.
+   */
+  virtual void api_enable_polygon_offset(bool enable, float factor,
+                                         float units) = 0;
   /**
    * @brief Raycast from the mouse position into the Camera's view of a Scene or
    * Layer. Implemented by the Rendering API.
@@ -635,6 +359,15 @@ public:
    * Framebuffer is set.
    */
   virtual void api_set_framebuffer(Framebuffer *framebuffer) = 0;
+  /**
+   * @brief Bind a uniform Buffer to a uniform block binding point shared by
+   * every Shader. Implemented by the Rendering API.
+   *
+   * @param binding The uniform block binding point.
+   * @param uniform The uniform Buffer to bind.
+   */
+  virtual void api_bind_uniform_buffer(uint32_t binding,
+                                       IBuffer *uniform) = 0;
   /**
    * @brief Dispatch a compute operation. Implemented by the Rendering API.
    * @details A ComputeProgram must be bound in order to run the ComputeProgram.
@@ -688,6 +421,49 @@ public:
                                       Transform *parent_transform,
                                       unsigned int instance_count,
                                       Buffer<Transform> *models) = 0;
+  /**
+   * @brief API implemented function to render many draws of a SimpleMesh's
+   * Buffers with a single multi-draw.
+   *
+   * @param camera The Camera to render from.
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The batched Material to render with.
+   * @param parent_transform The parent Transform to render with.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   * @param models The model Transform of each draw.
+   * @see BatchedMesh
+   */
+  virtual void api_render_simple_mesh_indirect(
+      Camera *camera, SimpleMesh *mesh, Material *material,
+      Transform *parent_transform, Buffer<DrawCommand> *commands,
+      unsigned int draw_count, Buffer<Transform> *models) = 0;
+  /**
+   * @brief API implemented function to draw a SimpleMesh whose state has
+   * already been bound and uploaded.
+   * @details Used by the RenderQueue, which binds only the state that changed
+   * between draws.
+   *
+   * @param mesh The SimpleMesh to draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param instance_count The number of instances to draw, 0 if not
+   * instanced.
+   */
+  virtual void api_draw_simple_mesh(SimpleMesh *mesh, Material *material,
+                                    unsigned int instance_count) = 0;
+  /**
+   * @brief API implemented function to multi-draw a SimpleMesh whose state has
+   * already been bound and uploaded.
+   *
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   */
+  virtual void api_draw_simple_mesh_indirect(SimpleMesh *mesh,
+                                             Material *material,
+                                             Buffer<DrawCommand> *commands,
+                                             unsigned int draw_count) = 0;
   /**
    * @brief API implemented function to bind a SimpleMesh's render state to a
    * Material.
@@ -751,9 +527,11 @@ public:
    *
    * @param width The width in pixels or fragments of the Framebuffer.
    * @param height The height in pixels or fragments of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
    * @return Scoped<Framebuffer>
    */
-  virtual Scoped<Framebuffer> api_gen_framebuffer(int width, int height) = 0;
+  virtual Scoped<Framebuffer> api_gen_framebuffer(int width, int height,
+                                                  TextureType color_type) = 0;
   /**
    * @brief API implemented function to generate a Shader from a directory.
    * @details The directory must contain the glsl files that the shader program
@@ -831,6 +609,15 @@ public:
   static void clear_color_buffer(glm::vec4 color) {
     API->api_clear_color_buffer(color);
   }
+  /**
+   * @brief Static access to Renderer::api_clear_color_buffer(glm::uvec4).
+   *
+   * @param color The value to clear the integer color buffer to.
+   * @see Renderer::api_clear_color_buffer(glm::uvec4)
+   */
+  static void clear_color_buffer(glm::uvec4 color) {
+    API->api_clear_color_buffer(color);
+  }
   /**
    * @brief Static access to Renderer::api_clear_depth_buffer().
    * @see Renderer::api_clear_depth_buffer()
@@ -874,6 +661,7 @@ public:
    * @see Renderer::api_enable_depth_testing(bool)
    */
   static void enable_depth_testing(bool enable) {
+    render_state_.depth_testing = enable;
     API->api_enable_depth_testing(enable);
   }
   /**
@@ -883,6 +671,7 @@ public:
    * @see Renderer::api_enable_face_culling(bool)
    */
   static void enable_face_culling(bool enable) {
+    render_state_.face_culling = enable;
     API->api_enable_face_culling(enable);
   }
   /**
@@ -891,7 +680,30 @@ public:
    * @param enable true enables blending, false disables blending.
    * @see Renderer::api_enable_blending(bool)
    */
-  static void enable_blending(bool enable) { API->api_enable_blending(enable); }
+  static void enable_blending(bool enable) {
+    render_state_.blending = enable;
+    API->api_enable_blending(enable);
+  }
+  /**
+   * @brief Static access to
+   * Renderer::api_enable_polygon_offset(bool,float,float).
+   *
+   * @param enable true enables the polygon offset, false disables it.
+   * @param factor The offset scaled by the depth slope of each polygon.
+   * @param units The offset in units of the depth buffer resolution.
+   * @see Renderer::api_enable_polygon_offset(bool,float,float)
+   */
+  static void enable_polygon_offset(bool enable, float factor = 0.0f,
+                                    float units = 0.0f) {
+    API->api_enable_polygon_offset(enable, factor, units);
+  }
+  /**
+   * @brief Get the state last set with enable_depth_testing(),
+   * enable_face_culling() and enable_blending().
+   *
+   * @return The RenderState.
+   */
+  static const RenderState &get_render_state() { return render_state_; }
   /**
    * @brief Static access to Renderer::api_raycast(Camera*).
    *
@@ -913,6 +725,156 @@ public:
   static glm::vec3 raycast(Camera *camera, glm::ivec2 screen_coords) {
     return API->api_raycast(camera, screen_coords);
   }
+  /**
+   * @brief Read the depth buffer under a point on the screen without waiting
+   * for the GPU.
+   * @details The depth is read after the current frame has been rendered and
+   * arrives one or more frames later, when the returned PixelReadback becomes
+   * ready and the callback is called. Requests for the same point in the same
+   * frame share a single read.
+   *
+   * @param camera The Camera used to unproject the depth into world space.
+   * @param screen_coords The screen coordinates to read.
+   * @param callback Called once the result arrives, may be nullptr.
+   * @return The result, to be polled until ready.
+   * @see Renderer::raycast(Camera*, glm::ivec2)
+   */
+  static Referenced<const PixelReadback>
+  raycast_async(Camera *camera, glm::ivec2 screen_coords,
+                ReadbackCallback callback = nullptr);
+  /**
+   * @brief Read the depth buffer under the cursor without waiting for the GPU.
+   *
+   * @param camera The Camera used to unproject the depth into world space.
+   * @param callback Called once the result arrives, may be nullptr.
+   * @return The result, to be polled until ready.
+   * @see Renderer::raycast_async(Camera*, glm::ivec2, ReadbackCallback)
+   */
+  static Referenced<const PixelReadback>
+  raycast_async(Camera *camera, ReadbackCallback callback = nullptr) {
+    return raycast_async(camera, input.mouse_pos, callback);
+  }
+  /**
+   * @brief Get the Ray from a Camera through a point on the screen.
+   * @details The Ray starts on the near clip plane and ends on the far clip
+   * plane.
+   *
+   * @param camera The Camera to cast the Ray from.
+   * @param screen_coords The screen coordinates of the Ray.
+   * @return The Ray in world space.
+   */
+  static Ray get_ray(Camera *camera, glm::ivec2 screen_coords);
+  /**
+   * @brief Get the Ray from a Camera through the cursor.
+   *
+   * @param camera The Camera to cast the Ray from.
+   * @return The Ray in world space.
+   */
+  static Ray get_cursor_ray(Camera *camera) {
+    return get_ray(camera, input.mouse_pos);
+  }
+  /**
+   * @brief Find the closest triangle of a Layer's render packets hit by a Ray.
+   * @details Candidate Entities are found with the Layer's SpatialIndex and
+   * only the render packets of RenderPack Entities are tested. The Layer's
+   * TransformHierarchy and SpatialIndex are updated first, so Entities moved
+   * or given new Packets since the last frame are found. Unlike
+   * raycast() this runs on the CPU. It never waits for the GPU as long as each
+   * SimpleMesh was given its positions and indices on the CPU, as the
+   * built-in Meshes are. The first pick that tests any other SimpleMesh reads
+   * its triangles back from the GPU once. Entities with empty bounds are not
+   * in the SpatialIndex and are never hit.
+   *
+   * @param layer The Layer to search.
+   * @param ray The Ray in world space.
+   * @return The closest hit, which converts to false if nothing was hit.
+   * @see SpatialIndex
+   * @see Mesh::raycast()
+   */
+  static RayHit pick(Layer *layer, const Ray &ray);
+  /**
+   * @brief Find the closest triangle of a Layer's render packets under a point
+   * on the screen.
+   * @details The Layer's Camera casts the Ray.
+   *
+   * @param layer The Layer to search.
+   * @param screen_coords The screen coordinates to pick at.
+   * @return The closest hit, which converts to false if nothing was hit.
+   */
+  static RayHit pick(Layer *layer, glm::ivec2 screen_coords);
+  /**
+   * @brief Find the closest triangle of a Layer's render packets under the
+   * cursor.
+   * @details The Layer's Camera casts the Ray.
+   *
+   * @param layer The Layer to search.
+   * @return The closest hit, which converts to false if nothing was hit.
+   */
+  static RayHit pick(Layer *layer) { return pick(layer, input.mouse_pos); }
+  /**
+   * @brief Enable or disable the Entity ID pass.
+   * @details While enabled, every render packet of the RenderPack Entities in
+   * the Scene and its Layers is drawn a second time after the frame into an
+   * R32UI Framebuffer with a unique 32-bit ID per packet. pick_async() reads
+   * these IDs back. Each Layer is drawn over the previous ones with its own
+   * Camera and depth. Packets drawn by a BatchPacketRenderer have no Entity
+   * and are not drawn.
+   *
+   * @param enable true to render the pass every frame.
+   */
+  static void enable_id_pass(bool enable);
+  /**
+   * @brief Resolve an ID written by the last Entity ID pass.
+   *
+   * @param id The ID read from the ID Framebuffer.
+   * @return The packet with the ID, which converts to false if the ID is the
+   * background or the Entities of the pass have since been pulled.
+   */
+  static PickTarget resolve_id(uint32_t id);
+  /**
+   * @brief Read the Entity ID pass under a point on the screen without waiting
+   * for the GPU.
+   * @details The ID is read after the current frame has been rendered and
+   * resolved against the packets of that frame. The ID pass must be enabled.
+   * If Entities are pulled before the result arrives the result is empty.
+   *
+   * @param screen_coords The screen coordinates to read.
+   * @param callback Called once the result arrives, may be nullptr.
+   * @return The result, to be polled until ready.
+   * @see Renderer::enable_id_pass()
+   */
+  static Referenced<const IDReadback>
+  pick_async(glm::ivec2 screen_coords, IDReadbackCallback callback = nullptr) {
+    return pick_async(screen_coords, screen_coords + glm::ivec2(1), callback);
+  }
+  /**
+   * @brief Read every packet of the Entity ID pass in a rectangle on the
+   * screen without waiting for the GPU.
+   * @details Used for marquee selection. The whole rectangle is read in a
+   * single copy and each packet seen is reported once. The rectangle is
+   * clipped to the window.
+   *
+   * @param min The first corner of the rectangle in screen coordinates.
+   * @param max The opposite corner of the rectangle, exclusive.
+   * @param callback Called once the result arrives, may be nullptr.
+   * @return The result, to be polled until ready.
+   * @see Renderer::pick_async(glm::ivec2, IDReadbackCallback)
+   */
+  static Referenced<const IDReadback>
+  pick_async(glm::ivec2 min, glm::ivec2 max,
+             IDReadbackCallback callback = nullptr);
+  /**
+   * @brief Read the Entity ID pass under the cursor without waiting for the
+   * GPU.
+   *
+   * @param callback Called once the result arrives, may be nullptr.
+   * @return The result, to be polled until ready.
+   * @see Renderer::pick_async(glm::ivec2, IDReadbackCallback)
+   */
+  static Referenced<const IDReadback>
+  pick_async(IDReadbackCallback callback = nullptr) {
+    return pick_async(input.mouse_pos, callback);
+  }
   /**
    * @brief Static access to Renderer::api_set_framebuffer(Framebuffer*).
    *
@@ -922,6 +884,16 @@ public:
   static void set_framebuffer(Framebuffer *framebuffer) {
     API->api_set_framebuffer(framebuffer);
   }
+  /**
+   * @brief Bind the camera_properties of a Camera for every Material.
+   * @details The camera_properties Buffer of the Camera is written the first
+   * time the Camera renders in a frame and bound at Shader::camera_binding.
+   * Binding the Camera that is already bound is free.
+   *
+   * @param camera The Camera to bind.
+   * @see Material::upload_camera(Camera*, bool)
+   */
+  static void bind_camera(Camera *camera);
   /**
    * @brief Static access to Renderer::api_dispatch_compute(uint32_t, uint32_t,
    * uint32_t).
@@ -945,6 +917,10 @@ public:
    */
   static void render_simple_mesh(Camera *camera, SimpleMesh *mesh,
                                  Material *material) {
+    if (queue_recording_) {
+      queue_.push(camera, mesh, material, nullptr);
+      return;
+    }
     API->api_render_simple_mesh(camera, mesh, material);
   }
   /**
@@ -961,6 +937,10 @@ public:
   static void render_simple_mesh(Camera *camera, SimpleMesh *mesh,
                                  Material *material,
                                  Transform *parent_transform) {
+    if (queue_recording_) {
+      queue_.push(camera, mesh, material, parent_transform);
+      return;
+    }
     API->api_render_simple_mesh(camera, mesh, material, parent_transform);
   }
   /**
@@ -982,9 +962,75 @@ public:
                                  Transform *parent_transform,
                                  unsigned int instance_count,
                                  Buffer<Transform> *models) {
+    if (queue_recording_) {
+      queue_.push(camera, mesh, material, parent_transform, instance_count,
+                  models);
+      return;
+    }
     API->api_render_simple_mesh(camera, mesh, material, parent_transform,
                                 instance_count, models);
   }
+  /**
+   * @brief Static access to Renderer::api_draw_simple_mesh(SimpleMesh*,
+   * Material*, unsigned int).
+   *
+   * @param mesh The SimpleMesh to draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param instance_count The number of instances to draw, 0 if not
+   * instanced.
+   * @see Renderer::api_draw_simple_mesh(SimpleMesh*, Material*, unsigned int)
+   */
+  static void draw_simple_mesh(SimpleMesh *mesh, Material *material,
+                               unsigned int instance_count) {
+    API->api_draw_simple_mesh(mesh, material, instance_count);
+  }
+  /**
+   * @brief Static access to Renderer::api_render_simple_mesh_indirect(Camera*,
+   * SimpleMesh*, Material*, Transform*, Buffer<DrawCommand>*, unsigned int,
+   * Buffer<Transform>*).
+   *
+   * @param camera The Camera to render from.
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The batched Material to render with.
+   * @param parent_transform The parent Transform to render with.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   * @param models The model Transform of each draw.
+   * @see Renderer::api_render_simple_mesh_indirect(Camera*, SimpleMesh*,
+   * Material*, Transform*, Buffer<DrawCommand>*, unsigned int,
+   * Buffer<Transform>*)
+   */
+  static void render_simple_mesh_indirect(Camera *camera, SimpleMesh *mesh,
+                                          Material *material,
+                                          Transform *parent_transform,
+                                          Buffer<DrawCommand> *commands,
+                                          unsigned int draw_count,
+                                          Buffer<Transform> *models) {
+    if (queue_recording_) {
+      queue_.push(camera, mesh, material, parent_transform, draw_count, models,
+                  commands);
+      return;
+    }
+    API->api_render_simple_mesh_indirect(camera, mesh, material,
+                                         parent_transform, commands,
+                                         draw_count, models);
+  }
+  /**
+   * @brief Static access to Renderer::api_draw_simple_mesh_indirect(
+   * SimpleMesh*, Material*, Buffer<DrawCommand>*, unsigned int).
+   *
+   * @param mesh The SimpleMesh whose Buffers hold the geometry of every draw.
+   * @param material The Material the SimpleMesh is bound to.
+   * @param commands The DrawCommand of each draw.
+   * @param draw_count The number of draws.
+   * @see Renderer::api_draw_simple_mesh_indirect(SimpleMesh*, Material*,
+   * Buffer<DrawCommand>*, unsigned int)
+   */
+  static void draw_simple_mesh_indirect(SimpleMesh *mesh, Material *material,
+                                        Buffer<DrawCommand> *commands,
+                                        unsigned int draw_count) {
+    API->api_draw_simple_mesh_indirect(mesh, material, commands, draw_count);
+  }
   /**
    * @brief Static access to Renderer::api_bind_mesh_render_state(SimpleMesh*,
    * Material*).
@@ -1011,6 +1057,10 @@ public:
    * @brief Static access to
    * Renderer::push_mesh_geometry_buffer(SimpleMesh*,Referenced<Buffer<float>>).
    *
+   * @details A base vertex offsets every Geometry Buffer of a SimpleMesh, so
+   * a Geometry Buffer in the GeometryHeap is copied back out of it when a
+   * second Geometry Buffer is pushed.
+   *
    * @param mesh The SimpleMesh to push the Geometry Buffer to.
    * @param geometry_buffer The Geometry Buffer to push.
    * @see
@@ -1018,9 +1068,7 @@ public:
    */
   static void
   push_mesh_geometry_buffer(SimpleMesh *mesh,
-                            Referenced<Buffer<float>> geometry_buffer) {
-    API->api_push_mesh_geometry_buffer(mesh, geometry_buffer);
-  }
+                            Referenced<Buffer<float>> geometry_buffer);
   /**
    * @brief Static access to Renderer::set_mesh_index_buffer(SimpleMesh*,
    * Referenced<Buffer<uint32_t>>)
@@ -1034,6 +1082,24 @@ public:
                                     Referenced<Buffer<uint32_t>> index_buffer) {
     API->api_set_mesh_index_buffer(mesh, index_buffer);
   }
+  /**
+   * @brief Move the static Buffers of a SimpleMesh into the GeometryHeap.
+   * @details Called by SimpleMesh::bind() before the first render state of the
+   * SimpleMesh is created. The Geometry Buffer is only moved if it is the only
+   * Geometry Buffer of the SimpleMesh. Buffers that are not
+   * BufferType::STATIC are never moved.
+   *
+   * @param mesh The SimpleMesh.
+   */
+  static void store_mesh_geometry(SimpleMesh *mesh);
+  /**
+   * @brief Get the GeometryHeap of the Rendering API.
+   * @details The GeometryHeap is created on first use.
+   *
+   * @return The GeometryHeap or nullptr if
+   * RendererInfo::geometry_heap_page_size is 0.
+   */
+  static GeometryHeap *get_geometry_heap();
   /**
    * @brief Static access to Renderer::gen_texture2D(const char*).
    *
@@ -1058,15 +1124,18 @@ public:
     return API->api_gen_texture2D(type, width, height);
   }
   /**
-   * @brief Static access to Renderer::gen_framebuffer(int, int)
+   * @brief Static access to Renderer::gen_framebuffer(int, int, TextureType)
    *
    * @param width Width of the Framebuffer.
    * @param height Height of the Framebuffer.
+   * @param color_type The TextureType of the color texture.
    * @return Scoped Framebuffer
-   * @see Renderer::gen_framebuffer(int, int)
+   * @see Renderer::gen_framebuffer(int, int, TextureType)
    */
-  static Scoped<Framebuffer> gen_framebuffer(int width, int height) {
-    return API->api_gen_framebuffer(width, height);
+  static Scoped<Framebuffer>
+  gen_framebuffer(int width, int height,
+                  TextureType color_type = TextureType::RGBA32F) {
+    return API->api_gen_framebuffer(width, height, color_type);
   }
   /**
    * @brief Static access to Renderer::gen_shader(const char*).
@@ -1099,6 +1168,9 @@ public:
     case RendererAPI::OpenGL_4_5:
       return std::make_unique<GLBuffer<T>>(data, size_in_bytes, buffer_type);
       break;
+    case RendererAPI::Headless:
+      return std::make_unique<HostBuffer<T>>(data, size_in_bytes, buffer_type);
+      break;
     default:
       return nullptr;
     }
@@ -1120,6 +1192,7 @@ public:
     // generate scene reference of type T and cast to base type
     Referenced<T> scn = gen_ref<T>(args...);
     scenes_.push_back(scn);
+    scene_index_.insert(scenes_.back().get());
     return scn;
   }
   /**
@@ -1144,6 +1217,7 @@ public:
       // if T is a scene push the scene onto the stack
       if (scn) {
         scenes_.push_back(scn);
+        scene_index_.insert(scenes_.back().get());
         scenes.push_back(scn);
       }
     }
@@ -1159,12 +1233,7 @@ public:
    * @see Scene
    */
   template <typename T> static T *get_scene() {
-    for (auto scn_it = scene_begin(); scn_it != scene_end(); scn_it++) {
-      if (auto scene = std::dynamic_pointer_cast<T>(*scn_it)) {
-        return scene.get();
-      }
-    }
-    return nullptr;
+    return scene_index_.first<T>(scenes_);
   }
   /**
    * @brief Get a `std::vector` of pointers to all of the Scenes of type <T> in
@@ -1173,17 +1242,12 @@ public:
    * @tparam <T> The type of Scene to get. <T> must be a Scene.
    * @return A `std::vector` of pointers to all of the Scenes of type <T> in
    * the Scene stack. An empty vector is returned if no Scene of type <T>
-   * exists on the Scene stack.
+   * exists on the Scene stack. The vector is a copy, so the Scene stack may
+   * change while it is iterated.
    * @see Scene
    */
   template <typename T> static std::vector<T *> get_scenes() {
-    std::vector<T *> scenes{};
-    for (auto scn_it = scene_begin(); scn_it != scene_end(); scn_it++) {
-      if (auto scene = std::dynamic_pointer_cast<T>(*scn_it)) {
-        scenes.push_back(scene.get());
-      }
-    }
-    return scenes;
+    return scene_index_.get<T>(scenes_);
   }
   /**
    * @brief Push an existing Referenced Scene onto the Renderer's Scene stack.
@@ -1193,8 +1257,10 @@ public:
    */
   template <typename T> static void push_scene(Referenced<T> scene) {
     Referenced<Scene> scn = std::dynamic_pointer_cast<Scene>(scene);
-    if (scn)
+    if (scn) {
       scenes_.push_back(scn);
+      scene_index_.insert(scn.get());
+    }
   }
   /**
    * @brief Push a `std::vector` of existing Referenced Scenes onto the
@@ -1207,8 +1273,10 @@ public:
   static void push_scenes(std::vector<Referenced<T>> scenes) {
     for (size_t i = 0; i < scenes.size(); i++) {
       Referenced<Scene> scn = std::dynamic_pointer_cast<Scene>(scenes[i]);
-      if (scn)
+      if (scn) {
         scenes_.push_back(scn);
+        scene_index_.insert(scn.get());
+      }
     }
   }
 
@@ -1251,6 +1319,14 @@ public:
     return scenes_.rend();
   }
 
+  /**
+   * @brief Get the job system used by the Renderer.
+   * @details The job system is created on first use with
+   * RendererInfo::physics_threads worker threads.
+   *
+   * @return The job system.
+   */
+  static JobSystem *get_job_system();
   /**
    * @brief Set the Renderer API.
    * @details This sets the static Renderer::API variable. The Renderer API
@@ -1259,8 +1335,176 @@ public:
    * @param renderer The Renderer API to set.
    */
   static void set_renderer(Renderer *renderer) { API = renderer; }
+  /**
+   * @brief Signal that the IControlsSystems of an Entity changed.
+   * @details Called when an IControlsSystem is pushed onto or pulled from the
+   * System stack of an Entity. Only the listeners of that Entity are replaced,
+   * in the Layer that holds it and, if the Entity is a Layer, in itself.
+   *
+   * @param entity The Entity.
+   * @see Layer::invalidate_controls()
+   */
+  static void invalidate_controls(Entity *entity);
+  /**
+   * @brief Get the CommandBuffer used to defer structural changes to the
+   * active Scene until the next sync point.
+   *
+   * @return The CommandBuffer.
+   * @see CommandBuffer
+   */
+  static CommandBuffer &commands();
+  /**
+   * @brief Signal that a System, Entity or Layer was pulled.
+   * @details The pulled entries are removed at the next sync point. Frames in
+   * which nothing was pulled skip the removal pass entirely.
+   */
+  static void invalidate_structure() { structure_dirty_ = true; }
+  /**
+   * @brief Test a render packet against the view frustum of a Camera and count
+   * it as drawn or culled.
+   * @details Used by the RenderSystems that draw render packets. Always
+   * returns false when RendererInfo::frustum_culling is off. The counts are
+   * reset at the start of every frame.
+   *
+   * @param camera The Camera the packet is rendered from.
+   * @param mesh The Mesh of the packet.
+   * @param parent_transform The parent Transform the Mesh is rendered with.
+   * @return true if the packet is outside the frustum and should be skipped.
+   * @see RendererInfo::packets_drawn
+   * @see RendererInfo::packets_culled
+   */
+  static bool cull_packet(Camera *camera, Mesh *mesh,
+                          Transform *parent_transform);
+  /**
+   * @brief Render a Mesh through the render queue.
+   * @details If the Layer being rendered uses the render queue, the draws of
+   * the Mesh are recorded and drawn sorted by state with the other draws of
+   * the Layer when the queue is flushed. Otherwise, or when
+   * RendererInfo::render_queue is off, the Mesh is rendered immediately. Used
+   * by the RenderSystems that draw render packets.
+   *
+   * @param camera The Camera to render from.
+   * @param mesh The Mesh to render.
+   * @param material The Material to render with.
+   * @param parent_transform The parent Transform, may be nullptr.
+   * @param pass The pass of the draws from 0 to 15, lower passes are drawn
+   * first.
+   * @see RenderQueue
+   */
+  static void submit(Camera *camera, Mesh *mesh, Material *material,
+                     Transform *parent_transform = nullptr, uint8_t pass = 0);
+  /**
+   * @brief Sort and draw every draw recorded with submit().
+   * @details Called by render_frame() after the Entities of the Scene and
+   * after the Entities of each Layer. RenderSystems that change render state
+   * must flush the queue before doing so.
+   */
+  static void flush_render_queue();
 
 protected:
+  /**
+   * @brief Dispatch an input event to the controls listeners of the active
+   * Scene.
+   * @details Only the IControlsSystems that listen to the event are called.
+   * Listeners are called in priority order: the Layers from the top of the
+   * Layer stack down, each Layer's Entities before the Layer's own Systems,
+   * then the Scene's Entities and finally the Scene's own Systems, every stack
+   * in reverse. Dispatch stops at the first listener that handles the event.
+   * Changes to the Scene made by a listener take effect from the next event.
+   *
+   * @param event The kind of event.
+   * @param character The character of a ControlsEvent::CHAR event.
+   * @return true if a listener handled the event.
+   * @see IControlsSystem
+   */
+  static bool dispatch_controls(ControlsEvent event, char character = 0);
+  /**
+   * @brief The sync point for structural changes to the active Scene.
+   * @details Applies the recorded commands() and then removes the Layers,
+   * Entities and Systems pulled since the last sync point. Does nothing if
+   * nothing was recorded or pulled.
+   */
+  static void sync_structure();
+  /**
+   * @brief Run one frame of the active Scene.
+   * @details Calls sync_structure(), runs the physics phase with
+   * step_physics() and then calls every render System on the Scene, its
+   * Entities, its Layers and their Entities in order. Called once per frame by
+   * the render loop of the implemented Rendering API.
+   *
+   * @param delta_time The amount of time in seconds since the last frame.
+   */
+  static void render_frame(float delta_time);
+  /**
+   * @brief Run the physics phase of a frame on the active Scene.
+   * @details Every IPhysicsSystem attached to the Scene, its Entities, its
+   * Layers and their Entities is updated. Systems that are thread safe are
+   * updated on the job system first and this function waits for all of them
+   * to finish before updating the remaining Systems serially in Scene order.
+   * Called by the implemented Rendering API before the render phase.
+   *
+   * @param delta_time The amount of time in seconds to step the physics.
+   * @see IPhysicsSystem::is_thread_safe()
+   */
+  static void update_physics(float delta_time);
+  /**
+   * @brief Advance the physics of the active Scene by the frame time.
+   * @details If RendererInfo::fixed_timestep is 0, update_physics() is called
+   * once with the frame time and RendererInfo::interpolation_alpha is 1.
+   * Otherwise the frame time is added to an accumulator and update_physics()
+   * is called with the fixed timestep until less than one step remains, at
+   * most RendererInfo::max_physics_steps times. The remaining fraction of a
+   * step is stored in RendererInfo::interpolation_alpha for the render phase,
+   * which draws every Rigidbody at its position interpolated between the last
+   * two steps.
+   *
+   * @param frame_time The amount of time in seconds since the last frame.
+   */
+  static void step_physics(float frame_time);
+  /**
+   * @brief Store the position of every Rigidbody of the active Scene as its
+   * previous position before a fixed physics step.
+   */
+  static void store_previous_positions();
+  /**
+   * @brief Set or clear the interpolated render Transform of every Rigidbody
+   * Entity of the active Scene.
+   *
+   * @param interpolate true to draw each Rigidbody at its position
+   * interpolated by RendererInfo::interpolation_alpha, false to draw it at its
+   * own position.
+   * @see Entity::set_render_transform()
+   */
+  static void interpolate_rigidbodies(bool interpolate);
+  /**
+   * @brief Start reading the pixels requested with raycast_async() and
+   * pick_async() since the last flush.
+   * @details Called by the implemented Rendering API once the frame has been
+   * rendered. If the PixelReader has too many reads in flight the requests
+   * are kept for the next frame.
+   *
+   * @param reader The PixelReader of the Rendering API.
+   */
+  static void flush_readbacks(PixelReader *reader);
+  /**
+   * @brief Deliver the results of every finished read.
+   * @details Called once per frame by the implemented Rendering API.
+   *
+   * @param reader The PixelReader of the Rendering API.
+   */
+  static void collect_readbacks(PixelReader *reader);
+  /**
+   * @brief Drop every pending and in flight read without delivering them.
+   * @details Called by the implemented Rendering API before its PixelReader is
+   * destroyed. Also releases the Entity ID pass resources.
+   */
+  static void clear_readbacks();
+  /**
+   * @brief Draw the Entity ID pass of the active Scene.
+   * @see Renderer::enable_id_pass()
+   */
+  static void render_id_pass();
+
   // static variables for renderer
   static RendererInfo
       info; /**< The RendererInfo for the implemented Renderer.*/
@@ -1270,6 +1514,99 @@ protected:
                            the render loop has been signaled to end.*/
   static Renderer *API; /**< The implemented Rendering API.*/
   static std::vector<Referenced<Scene>> scenes_; /**< The Scene stack.*/
+  static TypeIndex<Scene> scene_index_; /**< Typed views of the Scene stack.*/
+  static Scoped<JobSystem> jobs_; /**< The job system.*/
+  static double physics_accumulator_; /**< Unsimulated time in seconds.*/
+  static uint64_t frame_; /**< The number of frames rendered.*/
+  static Referenced<GeometryHeap>
+      geometry_heap_; /**< Static geometry of every Mesh, released when the
+                         render loop ends.*/
+  static std::vector<std::pair<IPhysicsSystem *, Entity *>>
+      parallel_physics_; /**< Thread safe physics updates for the frame.*/
+  static std::vector<std::pair<IPhysicsSystem *, Entity *>>
+      serial_physics_; /**< Serial physics updates for the frame.*/
+
+private:
+  /**
+   * @brief Dispatch an input event to the controls listeners of a Layer.
+   *
+   * @param layer The Layer.
+   * @param event The kind of event.
+   * @param character The character of a ControlsEvent::CHAR event.
+   * @return true if a listener handled the event.
+   */
+  static bool dispatch_controls(Layer *layer, ControlsEvent event,
+                                char character);
+  /**
+   * @brief A request for a PixelReadback.
+   */
+  struct ReadbackRequest {
+    Referenced<PixelReadback> result;  /**< The result to fill in.*/
+    glm::mat4 inverse_view_projection; /**< Unprojects the depth.*/
+    glm::vec2 device_coords;           /**< The normalized device coords.*/
+    ReadbackCallback callback;         /**< Called when the result arrives.*/
+  };
+  /**
+   * @brief The requests for a single pixel.
+   */
+  struct PixelRequests {
+    glm::ivec2 screen_coords;              /**< The pixel to read.*/
+    std::vector<ReadbackRequest> requests; /**< The requests for it.*/
+  };
+  static std::vector<PixelRequests>
+      readback_requests_; /**< Pixels requested since the last flush.*/
+  static std::deque<std::vector<PixelRequests>>
+      readbacks_in_flight_; /**< Flushed batches, oldest first.*/
+  static std::vector<glm::ivec2>
+      readback_pixels_; /**< Scratch list of the pixels of a batch.*/
+  static std::vector<float>
+      readback_depths_; /**< Scratch list of the depths of a batch.*/
+  /**
+   * @brief A request for an IDReadback.
+   */
+  struct IDRequest {
+    Referenced<IDReadback> result; /**< The result to fill in.*/
+    IDReadbackCallback callback;   /**< Called when the result arrives.*/
+  };
+  /**
+   * @brief The IDRequests read from the ID pass of one frame.
+   */
+  struct IDBatch {
+    uint64_t frame;                  /**< The ID pass that was read.*/
+    std::vector<IDRequest> requests; /**< The requests, in read order.*/
+  };
+  static constexpr size_t id_tables = 4; /**< Frames of IDs kept.*/
+  static std::array<std::vector<PickTarget>, id_tables>
+      id_tables_; /**< The packets of the last ID passes, indexed by ID - 1.*/
+  static uint64_t id_frame_;       /**< The number of ID passes drawn.*/
+  static uint64_t id_valid_frame_; /**< The first ID pass without pulled
+                                      Entities.*/
+  static Scoped<Framebuffer> id_framebuffer_; /**< The ID pass target.*/
+  static glm::ivec2 id_framebuffer_size_;     /**< The size of the target.*/
+  static Scoped<EntityIDMaterial> id_material_; /**< Draws the ID pass.*/
+  static std::vector<IDRequest>
+      id_requests_; /**< Rectangles requested since the last flush.*/
+  static std::deque<IDBatch> ids_in_flight_; /**< Flushed batches.*/
+  static std::vector<PixelRect>
+      id_rects_; /**< Scratch list of the rectangles of a batch.*/
+  static std::vector<uint32_t>
+      id_values_; /**< Scratch list of the IDs of a batch.*/
+  /**
+   * @brief Get the packets of an ID pass if they are still valid.
+   *
+   * @param frame The ID pass.
+   * @return The packets indexed by ID - 1 or nullptr.
+   */
+  static const std::vector<PickTarget> *get_id_table(uint64_t frame);
+  static RenderQueue queue_;    /**< The draws of the current Layer.*/
+  static bool queue_recording_; /**< Push draws to queue_ instead of drawing
+                                   them?*/
+  static bool queue_enabled_;   /**< Does the Layer being rendered use the
+                                   render queue?*/
+  static RenderState render_state_; /**< The state set through the
+                                       Renderer.*/
+  static bool structure_dirty_; /**< Anything pulled since the last sync
+                                   point?*/
 };
 
 /**
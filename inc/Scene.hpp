@@ -54,6 +54,7 @@ public:
     // generate layer reference of type T and cast to base type
     Referenced<T> layr = gen_ref<T>(args...);
     layers_.push_back(layr);
+    layer_index_.insert(layr.get());
     return layr;
   }
   /**
@@ -76,6 +77,7 @@ public:
       // generate layer reference of type T and cast to base type
       Referenced<T> layr = gen_ref<T>(args...);
       layers_.push_back(layr);
+      layer_index_.insert(layr.get());
       layers.push_back(layr);
     }
     return layers;
@@ -90,12 +92,7 @@ public:
    * @see Layer
    */
   template <typename T> T *get_layer() {
-    for (auto layr_it = layer_begin(); layr_it != layer_end(); layr_it++) {
-      if (auto layer = std::dynamic_pointer_cast<T>(*layr_it)) {
-        return layer.get();
-      }
-    }
-    return nullptr;
+    return layer_index_.first<T>(layers_);
   }
   /**
    * @brief Get a `std::vector` of pointers to all of the Layers of type <T> in
@@ -104,17 +101,12 @@ public:
    * @tparam <T> The type of Layer to get. <T> must be a Layer.
    * @return A `std::vector` of pointers to all of the Layers of type <T> in
    * the Layer stack. An empty vector is returned if no Layer of type <T>
-   * exists on the Layer stack.
+   * exists on the Layer stack. The vector is a copy, so the Layer stack may
+   * change while it is iterated.
    * @see Layer
    */
   template <typename T> std::vector<T *> get_layers() {
-    std::vector<T *> layers{};
-    for (auto layr_it = layer_begin(); layr_it != layer_end(); layr_it++) {
-      if (auto layer = std::dynamic_pointer_cast<T>(*layr_it)) {
-        layers.push_back(layer.get());
-      }
-    }
-    return layers;
+    return layer_index_.get<T>(layers_);
   }
   /**
    * @brief Push an existing Referenced Layer onto the Renderer's Layer stack.
@@ -124,8 +116,10 @@ public:
    */
   template <typename T> void push_layer(Referenced<T> layer) {
     Referenced<Layer> layr = std::dynamic_pointer_cast<Layer>(layer);
-    if (layr)
+    if (layr) {
       layers_.push_back(layr);
+      layer_index_.insert(layr.get());
+    }
   }
   /**
    * @brief Push a `std::vector` of existing Referenced Layers onto the
@@ -137,8 +131,10 @@ public:
   template <typename T> void push_layers(std::vector<Referenced<T>> layers) {
     for (size_t i = 0; i < layers.size(); i++) {
       Referenced<Layer> layr = std::dynamic_pointer_cast<Layer>(layers[i]);
-      if (layr)
+      if (layr) {
         layers_.push_back(layr);
+        layer_index_.insert(layr.get());
+      }
     }
   }
   /**
@@ -153,8 +149,11 @@ public:
   template <typename T> Referenced<T> pull_layer(Layer *layer) {
     for (auto layr_it = layer_begin(); layr_it != layer_end(); layr_it++) {
       if (layer == (*layr_it).get()) {
-        Referenced<T> pulled_layer =
-            std::dynamic_pointer_cast<T>(*layr_it)(*layr_it) = nullptr;
+        Referenced<T> pulled_layer = std::dynamic_pointer_cast<T>(*layr_it);
+        (*layr_it) = nullptr;
+        layer_pulled = true;
+        layer_index_.remove(layer);
+        Renderer::invalidate_structure();
         return pulled_layer;
       }
     }
@@ -250,6 +249,7 @@ public:
 private:
   std::vector<Referenced<Layer>> layers_{}; /**< The Layer stack.*/
   bool layer_pulled = false;
+  TypeIndex<Layer> layer_index_{}; /**< Typed views of the Layer stack.*/
 };
 } // namespace mare
 
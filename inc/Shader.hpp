@@ -201,6 +201,10 @@ public:
    */
   virtual void barrier(BarrierType type) = 0;
 
+  static constexpr uint32_t camera_binding =
+      0; /**< The uniform block binding of the "camera_properties" block. Other
+            uniform blocks are bound after it.*/
+
 protected:
   uint32_t shader_ID_; /**< The unique ID for the Shader assigned by the
                           implemented Rendering API.*/
@@ -470,15 +474,27 @@ public:
    * @brief Virtual destructor of the Material object
    */
   virtual ~Material() {}
+  /**
+   * @brief Can the Material draw a BatchedMesh with a single multi-draw?
+   * @details Batched Materials read the model matrix of each draw from the
+   * "model_instances" storage block indexed by the draw ID instead of the
+   * instance ID.
+   *
+   * @return true if the Material's shader indexes its models by draw ID.
+   * @see BatchedMesh
+   */
+  virtual bool is_batched() const { return false; }
   /**
    * @brief Upload a Camera to the Material. The Material must be bound first.
-   * @details The Material's glsl shader must have two uniform mat4 objects
-   * named "projection" and "view".
+   * @details The Material's glsl shader reads the Camera from the std140
+   * uniform block "camera_properties" bound at Shader::camera_binding. The
+   * block is shared by every Material and only written once per frame.
    *
    * @param camera The Camera to upload.
-   * @param suppress_warnings true enables reporting of warnings from the Engine
-   * regarding the existence of the Camera uniforms.
+   * @param suppress_warnings Unused, the block is bound whether or not the
+   * shader reads it.
    * @see Camera
+   * @see camera_properties
    */
   void upload_camera(Camera *camera, bool suppress_warnings = false);
   /**
@@ -0,0 +1,173 @@
+#ifndef SPATIALINDEX
+#define SPATIALINDEX
+
+// MARE
+#include "BVH.hpp"
+#include "Bounds.hpp"
+#include "Entity.hpp"
+
+// Standard Library
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+/**
+ * @brief The Entities of a Layer sorted into a BVH by their world space
+ * bounding boxes.
+ * @details Every Entity on the Layer's Entity stack is tracked, and the ones
+ * with bounds are leaves of the BVH. update() runs once per frame after the
+ * TransformHierarchy and moves the leaves of the Entities whose world
+ * Transform changed since the last update. Transforms are compared against
+ * the copy stored at the last update the same way the TransformHierarchy
+ * detects changes. Bounds that change without a Transform changing are
+ * picked up after calling mark_dirty(), which RenderPacks and their Meshes do
+ * through Entity::mark_bounds_dirty() when Packets are pushed or pulled and
+ * when a Mesh is moved or its instances or sub-Meshes change.
+ *
+ * Queries return every Entity whose fat AABB overlaps the query, which is a
+ * superset of the Entities whose exact bounds do.
+ * @see BVH
+ * @see Entity::get_bounds()
+ */
+class SpatialIndex {
+public:
+  /**
+   * @brief Start tracking an Entity.
+   * @details The Entity is added to the BVH on the next update().
+   *
+   * @param entity The Entity.
+   */
+  void insert(Entity *entity);
+  /**
+   * @brief Stop tracking an Entity and remove it from the BVH.
+   *
+   * @param entity The Entity.
+   */
+  void remove(Entity *entity);
+  /**
+   * @brief Recompute the bounds of an Entity on the next update().
+   *
+   * @param entity The Entity whose bounds changed.
+   */
+  void mark_dirty(Entity *entity);
+  /**
+   * @brief Move the BVH leaves of the Entities that changed since the last
+   * update.
+   * @details Called once per frame by the Renderer after the TransformHierarchy
+   * is updated.
+   */
+  void update();
+  /**
+   * @brief Update the index and rebuild the BVH with the surface area
+   * heuristic.
+   * @details Gives a better tree than incremental insertion, call it after
+   * loading static content.
+   */
+  void build();
+  /**
+   * @brief Get the BVH of the index.
+   *
+   * @return The BVH.
+   */
+  const BVH &get_bvh() const { return bvh_; }
+  /**
+   * @brief Find every Entity that may overlap a box.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param box The box in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F> void query(const AABB &box, F callback) const {
+    bvh_.query(box, callback);
+  }
+  /**
+   * @brief Find every Entity that may overlap a sphere.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param sphere The sphere in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F>
+  void query(const BoundingSphere &sphere, F callback) const {
+    bvh_.query(sphere, callback);
+  }
+  /**
+   * @brief Find every Entity that may be inside a Frustum.
+   *
+   * @tparam <F> bool(Entity *), return false to stop the query.
+   * @param frustum The Frustum in world space.
+   * @param callback Called for each Entity found.
+   */
+  template <typename F> void query(const Frustum &frustum, F callback) const {
+    bvh_.query(frustum, callback);
+  }
+  /**
+   * @brief Find the Entities that may be hit by a ray.
+   *
+   * @tparam <F> float(Entity *, float distance), returns the new length of the
+   * ray.
+   * @param origin The origin of the ray in world space.
+   * @param direction The direction of the ray.
+   * @param max_distance The length of the ray in units of \p direction.
+   * @param callback Called for each Entity found.
+   * @see BVH::raycast()
+   */
+  template <typename F>
+  void raycast(glm::vec3 origin, glm::vec3 direction, float max_distance,
+               F callback) const {
+    bvh_.raycast(origin, direction, max_distance, callback);
+  }
+  /**
+   * @brief Get every Entity that may overlap a box.
+   *
+   * @param box The box in world space.
+   * @return The Entities.
+   */
+  std::vector<Entity *> query(const AABB &box) const {
+    return collect(box);
+  }
+  /**
+   * @brief Get every Entity that may overlap a sphere.
+   *
+   * @param sphere The sphere in world space.
+   * @return The Entities.
+   */
+  std::vector<Entity *> query(const BoundingSphere &sphere) const {
+    return collect(sphere);
+  }
+  /**
+   * @brief Get every Entity that may be inside a Frustum.
+   *
+   * @param frustum The Frustum in world space.
+   * @return The Entities.
+   */
+  std::vector<Entity *> query(const Frustum &frustum) const {
+    return collect(frustum);
+  }
+
+private:
+  template <typename T> std::vector<Entity *> collect(const T &shape) const {
+    std::vector<Entity *> entities{};
+    bvh_.query(shape, [&entities](Entity *entity) {
+      entities.push_back(entity);
+      return true;
+    });
+    return entities;
+  }
+  std::vector<Entity *> entities_{}; /**< The tracked Entities.*/
+  std::vector<int32_t> proxies_{};   /**< The BVH leaf of each Entity.*/
+  std::vector<glm::mat4> worlds_{};  /**< The world matrix at the last update.*/
+  std::vector<uint8_t> dirty_{};     /**< Entities to update regardless.*/
+  std::unordered_map<Entity *, size_t>
+      positions_{}; /**< The position of each tracked Entity.*/
+  BVH bvh_{};       /**< The tree of the Entities with bounds.*/
+};
+
+} // namespace mare
+
+#endif
@@ -39,6 +39,19 @@ public:
    * @param entity A pointer to the Entity this System is attached to.
    */
   virtual void update(float dt, Entity *entity) = 0;
+  /**
+   * @brief Opt in to the parallel physics phase.
+   * @details A thread safe System may have update(float, Entity*) called from
+   * a worker thread concurrently with other thread safe Systems. It must only
+   * write to the Entity it is attached to and must not call into the Rendering
+   * API. Typed lookups such as get_system() and get_entities() are safe, they
+   * do not build caches during the parallel phase. Systems that are not thread
+   * safe are updated serially, in order, after every thread safe System has
+   * finished.
+   *
+   * @return true if the System can be updated from a worker thread.
+   */
+  virtual bool is_thread_safe() const { return false; }
 };
 
 /**
@@ -261,11 +274,103 @@ public:
   virtual bool on_char(char character, Entity *entity) {
     return false;
   }
+  /**
+   * @brief Check if the System listens to a kind of event.
+   * @details A System generated or pushed onto a System stack as its own type
+   * <T> listens to the events whose callbacks <T> overrides. A System pushed
+   * as a type-erased Referenced<System> listens to every event.
+   *
+   * @param event The kind of event.
+   * @return true if the System is dispatched to for the event.
+   * @see Entity::gen_system()
+   */
+  bool listens(ControlsEvent event) const {
+    return listening_[static_cast<size_t>(event)];
+  }
+  /**
+   * @brief Set the kinds of events the System listens to.
+   *
+   * @param events One bit per ControlsEvent.
+   */
+  void listen_to(ControlsEvents events) { listening_ = events; }
+  /**
+   * @brief Get the kinds of events whose callbacks a System type overrides.
+   *
+   * @tparam <T> A type that derives from IControlsSystem.
+   * @return One bit per ControlsEvent, set if <T> overrides the callback.
+   */
+  template <class T> static ControlsEvents overridden_events() {
+    return overridden_by<IControlsSystem, T>();
+  }
+
+protected:
+  /**
+   * @brief Get the kinds of events whose callbacks of a base class a System
+   * type overrides.
+   * @details A callback of <T> that is not accessible is assumed to be
+   * overridden.
+   *
+   * @tparam <Base> The class that declares the callbacks.
+   * @tparam <T> A type that derives from <Base>.
+   * @return One bit per ControlsEvent, set if <T> overrides the callback.
+   */
+  template <class Base, class T> static ControlsEvents overridden_by() {
+    ControlsEvents events{};
+    for_each_event([&events](auto tag) {
+      events[static_cast<size_t>(tag.value)] = !std::is_same<
+          decltype(callback_owner<Base, T>(tag, 0)), Base *>::value;
+    });
+    return events;
+  }
+
+private:
+  template <ControlsEvent E>
+  using event_tag = std::integral_constant<ControlsEvent, E>;
+  template <class F> static void for_each_event(F &&f) {
+    f(event_tag<ControlsEvent::KEY>{});
+    f(event_tag<ControlsEvent::MOUSE_BUTTON>{});
+    f(event_tag<ControlsEvent::MOUSE_MOVE>{});
+    f(event_tag<ControlsEvent::MOUSE_WHEEL>{});
+    f(event_tag<ControlsEvent::RESIZE>{});
+    f(event_tag<ControlsEvent::CHAR>{});
+  }
+  // the class that declares the callback of <T>, or <T> if it is not
+  // accessible
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::KEY>, int)
+      -> decltype(Base::handler_owner(&T::on_key));
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::MOUSE_BUTTON>, int)
+      -> decltype(Base::handler_owner(&T::on_mouse_button));
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::MOUSE_MOVE>, int)
+      -> decltype(Base::handler_owner(&T::on_mouse_move));
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::MOUSE_WHEEL>, int)
+      -> decltype(Base::handler_owner(&T::on_mouse_wheel));
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::RESIZE>, int)
+      -> decltype(Base::handler_owner(&T::on_resize));
+  template <class Base, class T>
+  static auto callback_owner(event_tag<ControlsEvent::CHAR>, int)
+      -> decltype(Base::handler_owner(&T::on_char));
+  template <class Base, class T, class Tag>
+  static T *callback_owner(Tag, long);
+  // the class that declares the callback a member pointer points to
+  template <class C>
+  static C *handler_owner(bool (C::*)(const RendererInput &, Entity *));
+  template <class C> static C *handler_owner(bool (C::*)(char, Entity *));
+  ControlsEvents listening_{
+      ControlsEvents{}.set()}; /**< Events this System listens to.*/
 };
 /**
  * @brief A template base class used to implement a ControlsSystem which
  * operates on one or more specific Components or Entities.
  *
+ * @details The Entity the System is attached to is cast to each of <Ts> with
+ * dynamic_cast every time a callback is forwarded, since <Ts> may be sibling
+ * Components of the Entity.
+ *
  * @tparam <Ts> The types of Components or Entities that the ControlsSystem will
  * operate on.
  */
@@ -437,6 +542,23 @@ public:
   virtual bool on_char(char character, Entity *entity) final {
     return on_char(character, dynamic_cast<Ts *>(entity)...);
   }
+  /**
+   * @brief Get the kinds of events whose templated callbacks a System type
+   * overrides.
+   *
+   * @tparam <T> A type that derives from ControlsSystem<Ts...>.
+   * @return One bit per ControlsEvent, set if <T> overrides the callback.
+   */
+  template <class T> static ControlsEvents overridden_events() {
+    return overridden_by<ControlsSystem, T>();
+  }
+
+private:
+  friend class IControlsSystem;
+  // the class that declares the templated callback a member pointer points to
+  template <class C>
+  static C *handler_owner(bool (C::*)(const RendererInput &, Ts *...));
+  template <class C> static C *handler_owner(bool (C::*)(char, Ts *...));
 };
 
 } // namespace mare
@@ -3,50 +3,51 @@
 
 // MARE
 #include "Components/Rigidbody.hpp"
-#include "Components/Transform.hpp"
+#include "Entities/Camera.hpp"
 #include "Mare.hpp"
 #include "Systems.hpp"
 
 namespace mare {
 
 /**
- * @brief A ControlsSystem that operates on Transform and Rigidbody Components.
- * @details The FlyControls System will allow the user to change the view of on
- * Entity by using the mouse movements to look around and the W,A,S,and D keys
- * to move the Entity. Any Entity that uses this System must inherit from the
- * Transform and Rigidbody Components.
+ * @brief A ControlsSystem that operates on a Camera with a Rigidbody Component.
+ * @details The FlyControls System will allow the user to change the view of a
+ * Camera by using the mouse movements to look around and the W,A,S,and D keys
+ * to move the Camera. Any Entity that uses this System must be a Camera and
+ * inherit from the Rigidbody Component. The Camera's pose is kept as a
+ * TRSTransform, so looking around never decomposes the Camera's matrix.
  *
  */
-class FlyControls : public ControlsSystem<Transform, Rigidbody> {
+class FlyControls : public ControlsSystem<Camera, Rigidbody> {
   float speed = 1.0f;
-  bool on_key(const RendererInput &input, Transform *transform,
+  bool on_key(const RendererInput &input, Camera *camera,
               Rigidbody *rigidbody) override {
     if (rigidbody) {
-      if (input.LEFT_SHIFT_PRESSED) {
+      if (input.pressed(Key::LEFT_SHIFT)) {
         speed = 2.5f;
       } else {
         speed = 1.0f;
       }
       float x = 0.0f;
       float y = 0.0f;
-      if (input.W_PRESSED) {
+      if (input.pressed(Key::W)) {
         y += 1.0f;
       }
-      if (input.S_PRESSED) {
+      if (input.pressed(Key::S)) {
         y -= 1.0f;
       }
-      if (input.D_PRESSED) {
+      if (input.pressed(Key::D)) {
         x += 1.0f;
       }
-      if (input.A_PRESSED) {
+      if (input.pressed(Key::A)) {
         x -= 1.0f;
       }
       if (x || y) {
         x /= sqrtf(x * x + y * y);
         y /= sqrtf(x * x + y * y);
       }
-      glm::vec3 dir = transform->get_forward_vector();
-      glm::vec3 up = transform->get_up_vector();
+      glm::vec3 dir = camera->get_forward_vector();
+      glm::vec3 up = camera->get_up_vector();
       glm::vec3 right = glm::normalize(glm::cross(dir, up));
       glm::vec3 velocity = (dir * y + right * x) * speed;
       rigidbody->linear_velocity = velocity;
@@ -54,12 +55,12 @@ class FlyControls : public ControlsSystem<Transform, Rigidbody> {
     // pass though to next callback
     return false;
   }
-  bool on_mouse_move(const RendererInput &input, Transform *transform,
+  bool on_mouse_move(const RendererInput &input, Camera *camera,
                      Rigidbody *rigidbody) override {
     float sensitivity = 300.0f;
     float dtheta = float(input.mouse_vel.y) / sensitivity;
     float dphi = -float(input.mouse_vel.x) / sensitivity;
-    glm::vec3 dir = transform->get_forward_vector();
+    glm::vec3 dir = camera->get_forward_vector();
 
     float theta = acosf(dir.z);
     float phi = atan2f(dir.y, dir.x);
@@ -70,18 +71,18 @@ class FlyControls : public ControlsSystem<Transform, Rigidbody> {
     dir = glm::vec3(sinf(theta) * cosf(phi), sinf(theta) * sinf(phi),
                     cosf(theta));
 
-    transform->face_towards(dir, {0.0f, 0.0f, 1.0f});
+    camera->face_towards(dir, {0.0f, 0.0f, 1.0f});
     return false;
   }
-  bool on_mouse_button(const RendererInput &input, Transform *transform,
+  bool on_mouse_button(const RendererInput &input, Camera *camera,
                        Rigidbody *rigidbody) override {
     return false;
   }
-  bool on_mouse_wheel(const RendererInput &input, Transform *transform,
+  bool on_mouse_wheel(const RendererInput &input, Camera *camera,
                       Rigidbody *rigidbody) override {
     return false;
   }
-  bool on_resize(const RendererInput &input, Transform *transform,
+  bool on_resize(const RendererInput &input, Camera *camera,
                  Rigidbody *rigidbody) override {
     return false;
   }
@@ -12,11 +12,11 @@
 namespace mare {
 
 /**
- * @brief A ControlsSystem that operates on a Transform Component
- * @details The OrbitControls System will allow to user to control an Entity by
+ * @brief A ControlsSystem that operates on a Camera.
+ * @details The OrbitControls System will allow to user to control a Camera by
  * orbiting around a point when the user clicks and drags with the left mouse
- * button. Any Entity that uses this System must inherit from a Transform
- * Component.
+ * button. The Camera's pose is kept as a TRSTransform, so orbiting reads the
+ * forward and up vectors from its rotation instead of decomposing its matrix.
  *
  * Using this system will orient the Camera/Entity such that the horizontal
  * plane is x-y.
@@ -34,8 +34,9 @@ public:
   bool pan_mode = false;
   bool left_click_disabled = false;
   bool on_mouse_move(const RendererInput &input, Camera *transform) override {
-    if ((!left_click_disabled && pan_mode && input.LEFT_MOUSE_PRESSED) ||
-        (input.MIDDLE_MOUSE_PRESSED && !pan_mode)) {
+    if ((!left_click_disabled && pan_mode &&
+         input.pressed(MouseButton::LEFT)) ||
+        (input.pressed(MouseButton::MIDDLE) && !pan_mode)) {
       glm::vec3 dir = transform->get_forward_vector();
       glm::vec3 pos = transform->get_position();
       glm::vec3 center = pos + dir * distance_to_center;
@@ -56,8 +57,8 @@ public:
       transform->translate(-0.5f * distance_to_center *
                            translational_sensitivity *
                            glm::rotateZ(direction, angle));
-    } else if ((pan_mode && input.MIDDLE_MOUSE_PRESSED) ||
-               (!left_click_disabled && input.LEFT_MOUSE_PRESSED)) {
+    } else if ((pan_mode && input.pressed(MouseButton::MIDDLE)) ||
+               (!left_click_disabled && input.pressed(MouseButton::LEFT))) {
       // orbit around center and adjust inclination
 
       float dtheta = -orbit_sensitivity *
@@ -111,7 +112,7 @@ public:
     return false;
   }
   bool on_key(const RendererInput &input, Camera *transform) override {
-    if (input.P_JUST_PRESSED) {
+    if (input.event().pressed(Key::P)) {
       if (transform->get_type() == ProjectionType::ORTHOGRAPHIC) {
         transform->set_type(ProjectionType::PERSPECTIVE);
         is_2D = false;
@@ -3,6 +3,8 @@
 
 // MARE
 #include "Components/Rigidbody.hpp"
+#include "Layer.hpp"
+#include "Renderer.hpp"
 #include "Systems.hpp"
 
 // External Libraries
@@ -23,12 +25,37 @@ namespace mare {
  */
 class EulerMethod : public PhysicsSystem<Rigidbody> {
 public:
+  /**
+   * @brief EulerMethod only writes to the Rigidbody it is attached to so it can
+   * run on the parallel physics phase.
+   */
+  bool is_thread_safe() const override { return true; }
   void update(float dt, Rigidbody *rb) override {
     // euler method to calculate velocity and position
     rb->linear_velocity += rb->force * dt;
     rb->translate(rb->linear_velocity * dt);
   }
 };
+
+/**
+ * @brief A PhysicsSystem that integrates every component Entity of a Layer
+ * with a Transform and a RigidbodyState.
+ * @details BatchEulerMethod is attached to a Layer or Scene once and uses the
+ * same integration as EulerMethod, iterating the Layer's contiguous component
+ * arrays and splitting them across the Renderer's JobSystem.
+ * @see ArchetypeStore
+ */
+class BatchEulerMethod : public PhysicsSystem<Layer> {
+public:
+  void update(float dt, Layer *layer) override {
+    layer->get_archetypes().parallel_each<Transform, RigidbodyState>(
+        *Renderer::get_job_system(), Renderer::get_info().physics_grain_size,
+        [dt](Transform &transform, RigidbodyState &rb) {
+          rb.linear_velocity += rb.force * dt;
+          transform.translate(rb.linear_velocity * dt);
+        });
+  }
+};
 } // namespace mare
 
 #endif
\ No newline at end of file
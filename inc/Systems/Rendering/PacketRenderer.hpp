@@ -3,6 +3,8 @@
 
 // MARE
 #include "Components/RenderPack.hpp"
+#include "Components/Rigidbody.hpp"
+#include "Layer.hpp"
 #include "Mare.hpp"
 #include "Renderer.hpp"
 #include "Systems.hpp"
@@ -23,9 +25,52 @@ public:
          pack_it++) {
       auto mesh = (*pack_it).first;
       auto material = (*pack_it).second;
-      mesh->render(camera, material.get(), rp);
+      if (Renderer::cull_packet(camera, mesh.get(),
+                                rp->get_world_transform())) {
+        continue;
+      }
+      Renderer::submit(camera, mesh.get(), material.get(),
+                       rp->get_world_transform());
     }
   }
 };
+
+/**
+ * @brief A RenderSystem that renders every component Entity of a Layer with a
+ * Transform and a MeshPacket.
+ * @details BatchPacketRenderer is attached to a Layer or Scene once and draws
+ * the MeshPackets stored in the Layer's ArchetypeStore from the Layer's Camera.
+ * Component Entities with a RigidbodyState are drawn at their position
+ * interpolated between the last two fixed physics steps.
+ * @see MeshPacket
+ * @see ArchetypeStore
+ */
+class BatchPacketRenderer : public RenderSystem<Layer> {
+public:
+  void render(float dt, Camera *camera, Layer *layer) override {
+    float alpha = Renderer::get_info().interpolation_alpha;
+    layer->each_optional<RigidbodyState, Transform, MeshPacket>(
+        [camera, alpha](Transform &transform, MeshPacket &packet,
+                        RigidbodyState *rb) {
+          if (!packet.mesh || !packet.material) {
+            return;
+          }
+          // bodies are drawn between their last two fixed physics steps
+          Transform drawn = transform;
+          if (rb && rb->previous_stored && alpha < 1.0f) {
+            glm::mat4 matrix = transform.get_transformation_matrix();
+            matrix[3] = glm::vec4(
+                glm::mix(rb->previous_position, transform.get_position(),
+                         alpha),
+                1.0f);
+            drawn.set_transformation_matrix(matrix);
+          }
+          if (!Renderer::cull_packet(camera, packet.mesh.get(), &drawn)) {
+            Renderer::submit(camera, packet.mesh.get(), packet.material.get(),
+                             &drawn);
+          }
+        });
+  }
+};
 } // namespace mare
 #endif
\ No newline at end of file
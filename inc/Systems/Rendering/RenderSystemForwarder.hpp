@@ -10,11 +10,13 @@ public:
   RenderSystemForwarder(Entity *forward_entity, Entity *parent = nullptr)
       : forward_entity_(forward_entity), parent_(parent) {}
   void render(float dt, Camera *camera, Entity *entity) override {
-    auto render_systems = forward_entity_->get_systems<IRenderSystem>();
-    for (auto &system : render_systems) {
+    for (auto system : forward_entity_->render_systems()) {
+      if (!system) {
+        continue;
+      }
       if (parent_) {
         forward_entity_->set_transformation_matrix(
-            parent_->get_transformation_matrix());
+            parent_->get_world_transform()->get_transformation_matrix());
       }
       system->render(dt, camera, forward_entity_);
     }
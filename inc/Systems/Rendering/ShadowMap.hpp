@@ -15,9 +15,6 @@
 // External Libraries
 #include "glm.hpp"
 
-// OpenGL
-#include "GL/glew.h"
-
 namespace mare {
 /**
  * @brief A RenderSystem that operates on a Scene.
@@ -51,30 +48,35 @@ public:
     // Clear depth buffer
     Renderer::clear_depth_buffer();
 
-    glViewport(0, 0, oversample_ * Renderer::get_info().window_width,
-               oversample_ * Renderer::get_info().window_height);
-    glEnable(GL_POLYGON_OFFSET_FILL);
-    glPolygonOffset(4.0f, 4.0f);
+    // the viewport follows the window, so remember its size to restore it
+    int width = Renderer::get_info().window_width;
+    int height = Renderer::get_info().window_height;
+    Renderer::resize_viewport(oversample_ * width, oversample_ * height);
+    Renderer::enable_polygon_offset(true, 4.0f, 4.0f);
     // Get entities with a shadow component
-    auto shadable_entities = scene->get_entities<Shadow>();
+    const auto &shadable_entities = scene->get_entities<Shadow>();
     // render all meshes from the perspective of the light with a basic material
     // to record depth into the depth buffer
+    Camera *light_camera = std::dynamic_pointer_cast<Camera>(spotlight).get();
     for (auto ent : shadable_entities) {
       for (auto pack_it = ent->packets_begin(); pack_it != ent->packets_end();
            pack_it++) {
         auto mesh = (*pack_it).first;
-        mesh->render(std::dynamic_pointer_cast<Camera>(spotlight).get(),
-                     material.get(), ent);
+        // Casters outside the light's frustum cannot shadow anything it sees
+        if (Renderer::cull_packet(light_camera, mesh.get(),
+                                  ent->get_world_transform())) {
+          continue;
+        }
+        mesh->render(light_camera, material.get(), ent->get_world_transform());
       }
       // set shadow properties
       ent->light_view = spotlight;
       ent->depth_buffer = depth_buffer;
     }
     // return to default framebuffer
-    glDisable(GL_POLYGON_OFFSET_FILL);
+    Renderer::enable_polygon_offset(false);
     Renderer::set_framebuffer(nullptr);
-    glViewport(0, 0, Renderer::get_info().window_width,
-               Renderer::get_info().window_height);
+    Renderer::resize_viewport(width, height);
     // Render entities normally with a shader that draws shadows...
   }
   Referenced<Framebuffer> depth_buffer;
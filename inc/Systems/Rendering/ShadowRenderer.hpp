@@ -27,6 +27,10 @@ public:
            pack_it++) {
         auto mesh = (*pack_it).first;
         auto material = (*pack_it).second;
+        if (Renderer::cull_packet(camera, mesh.get(),
+                                  sc->get_world_transform())) {
+          continue;
+        }
         material->bind();
         glm::mat4 shadow_matrix = sc->scale_bias_matrix *
                                   sc->light_view->get_projection() *
@@ -35,7 +39,7 @@ public:
         material->upload_texture2D("depth_texture",
                                    sc->depth_buffer->depth_texture());
 
-        mesh->render(camera, material.get(), sc);
+        mesh->render(camera, material.get(), sc->get_world_transform());
       }
     }
   }
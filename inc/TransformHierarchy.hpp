@@ -0,0 +1,85 @@
+#ifndef TRANSFORMHIERARCHY
+#define TRANSFORMHIERARCHY
+
+// MARE
+#include "Entity.hpp"
+
+// Standard Library
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// External Libraries
+#include "glm.hpp"
+
+namespace mare {
+
+/**
+ * @brief Parent-child relationships between the Entities of a Layer and their
+ * cached world Transforms.
+ * @details Only Entities that have a parent or children are part of the
+ * hierarchy. They are kept in flat arrays sorted in breadth first order so
+ * every parent comes before its children, and update() computes all of the
+ * world Transforms in a single linear pass. A world Transform is recomputed
+ * only when the Entity's own Transform changed since the last update or the
+ * world Transform of its parent was recomputed in the same pass. The breadth
+ * first order is rebuilt only when the hierarchy itself changes. The dirty
+ * children are composed with their parents in a single batch::multiply_parents
+ * call.
+ * @see Entity::get_world_transform()
+ */
+class TransformHierarchy {
+public:
+  /**
+   * @brief Set the parent of an Entity.
+   * @details The world Transform of the child is available immediately and is
+   * kept up to date by update(). Setting a parent that would create a cycle is
+   * ignored.
+   *
+   * @param child The child Entity.
+   * @param parent The parent Entity, nullptr to detach the child from its
+   * parent.
+   * @return true if the parent was set.
+   */
+  bool set_parent(Entity *child, Entity *parent);
+  /**
+   * @brief Remove an Entity from the hierarchy.
+   * @details The Entity is detached from its parent and its children become
+   * roots, keeping their own Transforms. Called when an Entity is pulled from
+   * its Layer.
+   *
+   * @param entity The Entity to remove.
+   */
+  void remove(Entity *entity);
+  /**
+   * @brief Update the world Transform of every Entity in the hierarchy.
+   * @details Called once per frame by the Renderer after the physics phase.
+   */
+  void update();
+  /**
+   * @brief Get the number of Entities in the hierarchy.
+   *
+   * @return The number of Entities.
+   */
+  size_t size() const { return members_.size(); }
+
+private:
+  void insert(Entity *entity);
+  void release(Entity *entity);
+  void sort();
+  std::unordered_map<Entity *, uint32_t>
+      members_{}; /**< Every Entity in the hierarchy and its child count.*/
+  std::vector<Entity *> order_{}; /**< Members in breadth first order.*/
+  std::vector<int32_t> parents_{}; /**< Index in order_ of each parent, -1
+                                      for roots.*/
+  std::vector<glm::mat4> locals_{}; /**< Transforms seen by the last update.*/
+  std::vector<glm::mat4> worlds_{}; /**< Cached world matrices.*/
+  std::vector<uint8_t> dirty_{};    /**< World matrix recomputed this pass?*/
+  std::vector<uint32_t>
+      dirty_children_{}; /**< Children recomputed this pass in order.*/
+  bool sorted_{true}; /**< Is order_ up to date with members_?*/
+};
+
+} // namespace mare
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef TYPEINDEX
+#define TYPEINDEX
+
+// MARE
+#include "Mare.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace mare {
+
+/**
+ * @brief A unique id for each type, assigned on first use.
+ */
+using TypeID = uint32_t;
+
+namespace type_index {
+/**
+ * @brief Get the next unused TypeID.
+ *
+ * @return The TypeID.
+ */
+inline TypeID next_type_id() {
+  static std::atomic<TypeID> next_id{0};
+  return next_id++;
+}
+/**
+ * @brief The flag that makes every TypeIndex read only.
+ *
+ * @return A reference to the flag.
+ */
+inline std::atomic<bool> &read_only_flag() {
+  static std::atomic<bool> read_only{false};
+  return read_only;
+}
+/**
+ * @brief Makes every TypeIndex read only for the lifetime of the scope.
+ * @details Used around phases that look up typed views from several threads.
+ * A lookup of a type whose list is not cached scans the stack instead of
+ * building the cache.
+ */
+class ReadOnlyScope {
+public:
+  ReadOnlyScope() { read_only_flag() = true; }
+  ~ReadOnlyScope() { read_only_flag() = false; }
+  ReadOnlyScope(const ReadOnlyScope &) = delete;
+  ReadOnlyScope &operator=(const ReadOnlyScope &) = delete;
+};
+} // namespace type_index
+
+/**
+ * @brief Get the TypeID of a type.
+ * @details TypeIDs are small consecutive integers so they can be used to index
+ * arrays directly.
+ *
+ * @tparam <T> The type.
+ * @return The TypeID of <T>.
+ */
+template <typename T> TypeID type_id() {
+  static const TypeID id = type_index::next_type_id();
+  return id;
+}
+
+/**
+ * @brief A cache of typed views into a stack of Referenced objects.
+ * @details The first lookup of a type <T> collects every object on the stack
+ * that is a <T> and caches the list, indexed by the TypeID of <T>. Objects
+ * pushed onto or pulled from the stack afterwards are added to or removed from
+ * only the cached lists of the types they derive from, so lookups stay O(1).
+ *
+ * Lookups return copies, so the stack may change while a result is iterated.
+ * Building the cache on the first lookup of a type is not thread safe. While a
+ * type_index::ReadOnlyScope is alive, lookups never write to the cache and may
+ * be made from several threads.
+ *
+ * @tparam <Base> The type of object on the stack.
+ */
+template <typename Base> class TypeIndex {
+public:
+  /**
+   * @brief Get every object of type <T> on a stack in stack order.
+   *
+   * @tparam <T> The type of object to get.
+   * @param stack The stack the TypeIndex belongs to.
+   * @return A copy of the list of objects of type <T>.
+   */
+  template <typename T>
+  std::vector<T *> get(const std::vector<Referenced<Base>> &stack) {
+    if (const Entry<T> *entry = find<T>(stack)) {
+      return entry->objects;
+    }
+    std::vector<T *> objects{};
+    for (const auto &object : stack) {
+      if (T *typed = dynamic_cast<T *>(object.get())) {
+        objects.push_back(typed);
+      }
+    }
+    return objects;
+  }
+  /**
+   * @brief Get the first object of type <T> on a stack without copying the
+   * list.
+   *
+   * @tparam <T> The type of object to get.
+   * @param stack The stack the TypeIndex belongs to.
+   * @return The first object of type <T> or nullptr if there is none.
+   */
+  template <typename T>
+  T *first(const std::vector<Referenced<Base>> &stack) {
+    if (const Entry<T> *entry = find<T>(stack)) {
+      return entry->objects.empty() ? nullptr : entry->objects.front();
+    }
+    for (const auto &object : stack) {
+      if (T *typed = dynamic_cast<T *>(object.get())) {
+        return typed;
+      }
+    }
+    return nullptr;
+  }
+  /**
+   * @brief Register an object pushed onto the stack with every cached type.
+   *
+   * @param object The object that was pushed.
+   */
+  void insert(Base *object) {
+    if (!object) {
+      return;
+    }
+    for (auto &entry : entries_) {
+      if (entry && !entry->stale) {
+        entry->insert(object);
+      }
+    }
+  }
+  /**
+   * @brief Remove an object pulled from the stack from the cached lists of the
+   * types it derives from.
+   * @details The other lists are left alone.
+   *
+   * @param object The object that was pulled.
+   */
+  void remove(Base *object) {
+    if (!object) {
+      return;
+    }
+    for (auto &entry : entries_) {
+      if (entry && !entry->stale) {
+        entry->remove(object);
+      }
+    }
+  }
+  /**
+   * @brief Mark every cached list stale after the stack was cleared.
+   */
+  void invalidate() {
+    for (auto &entry : entries_) {
+      if (entry) {
+        entry->stale = true;
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief The cached list of a single type.
+   */
+  struct IEntry {
+    virtual ~IEntry() {}
+    virtual void insert(Base *object) = 0;
+    virtual void remove(Base *object) = 0;
+    bool stale{true}; /**< Rebuild the list on the next lookup?*/
+  };
+  template <typename T> struct Entry : public IEntry {
+    void insert(Base *object) override {
+      if (T *typed = dynamic_cast<T *>(object)) {
+        objects.push_back(typed);
+      }
+    }
+    void remove(Base *object) override {
+      if (T *typed = dynamic_cast<T *>(object)) {
+        auto it = std::find(objects.begin(), objects.end(), typed);
+        if (it != objects.end()) {
+          objects.erase(it);
+        }
+      }
+    }
+    std::vector<T *> objects{}; /**< Every object of type <T>.*/
+  };
+  /**
+   * @brief Get the up to date cached list of type <T>, building it unless the
+   * TypeIndex is read only.
+   *
+   * @return The entry or nullptr if it is not cached and cannot be built.
+   */
+  template <typename T>
+  const Entry<T> *find(const std::vector<Referenced<Base>> &stack) {
+    TypeID id = type_id<T>();
+    bool read_only = type_index::read_only_flag();
+    if (id >= entries_.size()) {
+      if (read_only) {
+        return nullptr;
+      }
+      entries_.resize(id + 1);
+    }
+    if (!entries_[id]) {
+      if (read_only) {
+        return nullptr;
+      }
+      entries_[id] = gen_scoped<Entry<T>>();
+    }
+    Entry<T> *entry = static_cast<Entry<T> *>(entries_[id].get());
+    if (entry->stale) {
+      if (read_only) {
+        return nullptr;
+      }
+      entry->objects.clear();
+      for (const auto &object : stack) {
+        entry->insert(object.get());
+      }
+      entry->stale = false;
+    }
+    return entry;
+  }
+  std::vector<Scoped<IEntry>> entries_{}; /**< Indexed by TypeID.*/
+};
+
+} // namespace mare
+
+#endif
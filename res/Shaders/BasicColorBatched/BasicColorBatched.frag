@@ -0,0 +1,9 @@
+#version 450
+
+out vec4 color;
+uniform vec4 u_color;
+
+void main()
+{
+    color = u_color;
+}
\ No newline at end of file
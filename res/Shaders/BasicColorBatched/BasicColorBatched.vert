@@ -0,0 +1,26 @@
+#version 450
+#extension GL_ARB_shader_draw_parameters : require
+
+in vec4 position;
+uniform mat4 model;
+
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
+
+// the model matrix of each draw in the batch
+layout(std430, binding = 0) buffer model_instances
+{
+    mat4 models[];
+};
+
+void main()
+{
+    gl_Position = camera.view_projection * model * models[gl_DrawIDARB] * position;
+}
@@ -0,0 +1,9 @@
+#version 450
+
+out uint id;
+uniform int u_id;
+
+void main()
+{
+    id = uint(u_id);
+}
\ No newline at end of file
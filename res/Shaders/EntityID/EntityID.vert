@@ -0,0 +1,31 @@
+#version 450
+
+in vec4 position;
+uniform mat4 model;
+
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
+
+layout(std430, binding = 0) buffer model_instances
+{
+    mat4 models[];
+};
+
+void main()
+{
+    if(models.length() == 0)
+    {
+        gl_Position = camera.view_projection * model * position;
+    }
+    else
+    {
+        gl_Position = camera.view_projection * model * models[gl_InstanceID] * position;
+    }
+}
\ No newline at end of file
@@ -8,11 +8,18 @@ in vec4 P;
 in vec3 N;
 in vec2 vs_tex_coord;
 
-// Matrices
-layout(location = 4) uniform mat4 view;
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
 
 // Material properties
-layout(binding = 0) uniform material_properties
+layout(binding = 1) uniform material_properties
 {
     vec4 ambient;
     vec4 diffuse;
@@ -21,7 +28,7 @@ layout(binding = 0) uniform material_properties
 } material;
 
 // Light properties
-layout(binding = 1) uniform light_properties
+layout(binding = 2) uniform light_properties
 {
     vec4 ambient;
     vec4 diffuse;
@@ -45,12 +52,12 @@ in vec4 shadow_coord;
 void main(void)
 {
     vec3 n = normalize(N);
-    vec3 v = normalize(vec3(inverse(view)*vec4(0.0,0.0,0.0,1.0) - P));
+    vec3 v = normalize(vec3(camera.position - P));
     vec3 l = light_position - vec3(P);
     float light_distance = length(l);
     l = l/light_distance;
     float attenuation = 1.0 / (constant_attenuation + linear_attenuation*light_distance + quadratic_attenuation*light_distance*light_distance);
-    vec3 eye_direction = vec3(inverse(view)*P);
+    vec3 eye_direction = vec3(camera.inverse_view*P);
     vec3 half_vector = normalize(l + eye_direction );
     
     float a = dot(n, l) * 0.5 + 0.5;
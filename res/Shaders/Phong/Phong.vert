@@ -3,12 +3,20 @@
 layout(location = 0) in vec4 position;
 layout(location = 1) in vec3 normal;
 layout(location = 2) in vec3 texcoords;
-layout(location = 3) uniform mat4 projection;
-layout(location = 4) uniform mat4 view;
 layout(location = 5) uniform mat4 model;
 layout(location = 6) uniform mat3 normal_matrix;
 layout(location = 7) uniform mat4 shadow_matrix;
 
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
+
 layout(std430, binding = 0) buffer model_instances
 {
     mat4 models[];
@@ -26,15 +34,15 @@ void main()
     if(models.length() == 0) // not instanced
     {
         N = normalize(normal_matrix * normal);
-        P = view * model * position;
+        P = camera.view * model * position;
         shadow_coord = shadow_matrix * model * position;
-        gl_Position = projection * P;
+        gl_Position = camera.projection * P;
     }
     else // instanced
     {
         N = normalize(mat3(transpose(inverse(model * models[gl_InstanceID]))) * normal);
-        P = view * model * models[gl_InstanceID] * position;
+        P = camera.view * model * models[gl_InstanceID] * position;
         shadow_coord = shadow_matrix * model * models[gl_InstanceID] * position;
-        gl_Position = projection * P;
+        gl_Position = camera.projection * P;
     }
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#version 450
+#extension GL_ARB_shader_draw_parameters : require
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec3 texcoords;
+layout(location = 5) uniform mat4 model;
+layout(location = 7) uniform mat4 shadow_matrix;
+
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
+
+// the model matrix of each draw in the batch
+layout(std430, binding = 0) buffer model_instances
+{
+    mat4 models[];
+};
+
+out vec4 P;
+out vec3 N;
+out vec2 vs_tex_coord;
+
+out vec4 shadow_coord;
+
+void main()
+{
+    mat4 draw_model = model * models[gl_DrawIDARB];
+    vs_tex_coord = texcoords.xy;
+    N = normalize(mat3(transpose(inverse(draw_model))) * normal);
+    P = camera.view * draw_model * position;
+    shadow_coord = shadow_matrix * draw_model * position;
+    gl_Position = camera.projection * P;
+}
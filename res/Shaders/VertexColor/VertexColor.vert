@@ -3,8 +3,16 @@
 in vec4 position;
 in vec4 color;
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
 
 layout(std430, binding = 0) buffer model_instances
 {
@@ -17,11 +25,11 @@ void main()
 {
     if(models.length() == 0) // not instanced
     {
-        gl_Position = projection*view*model*position;
+        gl_Position = camera.view_projection * model * position;
     }
     else // instanced
     {
-        gl_Position = projection * view * model * models[gl_InstanceID] * position;
+        gl_Position = camera.view_projection * model * models[gl_InstanceID] * position;
     }
     vert_color = color;
 }
\ No newline at end of file
@@ -0,0 +1,9 @@
+#version 450
+
+in vec4 vert_color;
+out vec4 color;
+
+void main()
+{
+    color = vert_color;
+}
\ No newline at end of file
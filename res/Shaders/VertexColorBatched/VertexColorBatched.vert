@@ -0,0 +1,30 @@
+#version 450
+#extension GL_ARB_shader_draw_parameters : require
+
+in vec4 position;
+in vec4 color;
+uniform mat4 model;
+
+// Camera properties shared by every shader
+layout(std140, binding = 0) uniform camera_properties
+{
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    mat4 inverse_view;
+    vec4 position;
+} camera;
+
+// the model matrix of each draw in the batch
+layout(std430, binding = 0) buffer model_instances
+{
+    mat4 models[];
+};
+
+out vec4 vert_color;
+
+void main()
+{
+    gl_Position = camera.view_projection * model * models[gl_DrawIDARB] * position;
+    vert_color = color;
+}
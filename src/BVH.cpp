@@ -0,0 +1,315 @@
+// MARE
+#include "BVH.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace mare {
+
+namespace {
+AABB merge(const AABB &a, const AABB &b) {
+  AABB box = a;
+  box.expand(b);
+  return box;
+}
+} // namespace
+
+int32_t BVH::insert(Entity *entity, const AABB &box) {
+  int32_t leaf = allocate_node();
+  Node &node = nodes_[leaf];
+  node.box = {box.min - glm::vec3(margin_), box.max + glm::vec3(margin_)};
+  node.entity = entity;
+  node.height = 0;
+  insert_leaf(leaf);
+  leaf_count_++;
+  return leaf;
+}
+
+void BVH::remove(int32_t proxy) {
+  remove_leaf(proxy);
+  free_node(proxy);
+  leaf_count_--;
+}
+
+bool BVH::move(int32_t proxy, const AABB &box) {
+  if (nodes_[proxy].box.contains(box)) {
+    return false;
+  }
+  remove_leaf(proxy);
+  nodes_[proxy].box = {box.min - glm::vec3(margin_),
+                       box.max + glm::vec3(margin_)};
+  insert_leaf(proxy);
+  return true;
+}
+
+void BVH::clear() {
+  nodes_.clear();
+  root_ = null_node;
+  free_list_ = null_node;
+  leaf_count_ = 0;
+}
+
+int32_t BVH::allocate_node() {
+  if (free_list_ == null_node) {
+    nodes_.emplace_back();
+    return static_cast<int32_t>(nodes_.size() - 1);
+  }
+  int32_t node = free_list_;
+  free_list_ = nodes_[node].parent;
+  nodes_[node] = Node{};
+  return node;
+}
+
+void BVH::free_node(int32_t node) {
+  nodes_[node] = Node{};
+  nodes_[node].parent = free_list_;
+  free_list_ = node;
+}
+
+void BVH::insert_leaf(int32_t leaf) {
+  if (root_ == null_node) {
+    root_ = leaf;
+    nodes_[leaf].parent = null_node;
+    return;
+  }
+  // descend towards the sibling that increases the surface area of the tree
+  // the least
+  const AABB box = nodes_[leaf].box;
+  int32_t sibling = root_;
+  while (!nodes_[sibling].is_leaf()) {
+    const Node &node = nodes_[sibling];
+    float area = node.box.area();
+    float combined_area = merge(node.box, box).area();
+    // cost of making a new parent for this node and the leaf
+    float cost = 2.0f * combined_area;
+    // minimum cost of pushing the leaf further down the tree
+    float inheritance_cost = 2.0f * (combined_area - area);
+    auto descend_cost = [&](int32_t child) {
+      const AABB &child_box = nodes_[child].box;
+      float merged = merge(child_box, box).area();
+      return nodes_[child].is_leaf()
+                 ? merged + inheritance_cost
+                 : merged - child_box.area() + inheritance_cost;
+    };
+    float left_cost = descend_cost(node.left);
+    float right_cost = descend_cost(node.right);
+    if (cost < left_cost && cost < right_cost) {
+      break;
+    }
+    sibling = left_cost < right_cost ? node.left : node.right;
+  }
+
+  int32_t old_parent = nodes_[sibling].parent;
+  int32_t new_parent = allocate_node();
+  Node &parent = nodes_[new_parent];
+  parent.parent = old_parent;
+  parent.box = merge(box, nodes_[sibling].box);
+  parent.height = nodes_[sibling].height + 1;
+  parent.left = sibling;
+  parent.right = leaf;
+  nodes_[sibling].parent = new_parent;
+  nodes_[leaf].parent = new_parent;
+  if (old_parent == null_node) {
+    root_ = new_parent;
+  } else if (nodes_[old_parent].left == sibling) {
+    nodes_[old_parent].left = new_parent;
+  } else {
+    nodes_[old_parent].right = new_parent;
+  }
+  refit(nodes_[leaf].parent);
+}
+
+void BVH::remove_leaf(int32_t leaf) {
+  if (leaf == root_) {
+    root_ = null_node;
+    return;
+  }
+  int32_t parent = nodes_[leaf].parent;
+  int32_t grand_parent = nodes_[parent].parent;
+  int32_t sibling =
+      nodes_[parent].left == leaf ? nodes_[parent].right : nodes_[parent].left;
+  nodes_[sibling].parent = grand_parent;
+  if (grand_parent == null_node) {
+    root_ = sibling;
+  } else {
+    if (nodes_[grand_parent].left == parent) {
+      nodes_[grand_parent].left = sibling;
+    } else {
+      nodes_[grand_parent].right = sibling;
+    }
+    refit(grand_parent);
+  }
+  free_node(parent);
+  nodes_[leaf].parent = null_node;
+}
+
+void BVH::refit(int32_t node) {
+  while (node != null_node) {
+    node = balance(node);
+    Node &current = nodes_[node];
+    const Node &left = nodes_[current.left];
+    const Node &right = nodes_[current.right];
+    current.height = 1 + std::max(left.height, right.height);
+    current.box = merge(left.box, right.box);
+    node = current.parent;
+  }
+}
+
+int32_t BVH::balance(int32_t a) {
+  Node &A = nodes_[a];
+  if (A.is_leaf() || A.height < 2) {
+    return a;
+  }
+  int32_t b = A.left;
+  int32_t c = A.right;
+  int32_t balance = nodes_[c].height - nodes_[b].height;
+  if (std::abs(balance) < 2) {
+    return a;
+  }
+  // rotate the taller child up to replace a
+  bool rotate_right = balance > 0;
+  int32_t up = rotate_right ? c : b;
+  int32_t other = rotate_right ? b : c;
+  Node &U = nodes_[up];
+  int32_t f = U.left;
+  int32_t g = U.right;
+
+  U.left = a;
+  U.parent = A.parent;
+  A.parent = up;
+  if (U.parent == null_node) {
+    root_ = up;
+  } else if (nodes_[U.parent].left == a) {
+    nodes_[U.parent].left = up;
+  } else {
+    nodes_[U.parent].right = up;
+  }
+  // keep the taller grandchild under up and give the other one to a
+  int32_t keep = nodes_[f].height > nodes_[g].height ? f : g;
+  int32_t give = keep == f ? g : f;
+  U.right = keep;
+  if (rotate_right) {
+    A.right = give;
+  } else {
+    A.left = give;
+  }
+  nodes_[give].parent = a;
+  A.box = merge(nodes_[other].box, nodes_[give].box);
+  A.height = 1 + std::max(nodes_[other].height, nodes_[give].height);
+  U.box = merge(A.box, nodes_[keep].box);
+  U.height = 1 + std::max(A.height, nodes_[keep].height);
+  return up;
+}
+
+void BVH::build() {
+  if (leaf_count_ < 2) {
+    return;
+  }
+  // collect the leaves and free every internal node
+  std::vector<int32_t> leaves{};
+  leaves.reserve(leaf_count_);
+  for (int32_t i = 0; i < static_cast<int32_t>(nodes_.size()); i++) {
+    Node &node = nodes_[i];
+    if (node.height < 0) {
+      continue;
+    }
+    if (node.is_leaf()) {
+      node.parent = null_node;
+      leaves.push_back(i);
+    } else {
+      free_node(i);
+    }
+  }
+  root_ = build_range(leaves.data(), static_cast<int32_t>(leaves.size()));
+  nodes_[root_].parent = null_node;
+}
+
+int32_t BVH::build_range(int32_t *leaves, int32_t count) {
+  if (count == 1) {
+    return leaves[0];
+  }
+  AABB centers{};
+  for (int32_t i = 0; i < count; i++) {
+    centers.expand(nodes_[leaves[i]].box.center());
+  }
+  glm::vec3 size = centers.max - centers.min;
+  int axis = size.x > size.y ? (size.x > size.z ? 0 : 2)
+                             : (size.y > size.z ? 1 : 2);
+
+  int32_t split = -1;
+  if (size[axis] > 0.0f && count > 2) {
+    // bin the centers along the longest axis and split at the bin boundary
+    // with the lowest surface area cost
+    constexpr int bin_count = 16;
+    struct Bin {
+      AABB box{};
+      int32_t count{0};
+    } bins[bin_count];
+    float scale = bin_count / size[axis];
+    auto bin_of = [&](int32_t leaf) {
+      float center = nodes_[leaf].box.center()[axis];
+      int bin = static_cast<int>((center - centers.min[axis]) * scale);
+      return std::min(bin, bin_count - 1);
+    };
+    for (int32_t i = 0; i < count; i++) {
+      Bin &bin = bins[bin_of(leaves[i])];
+      bin.box.expand(nodes_[leaves[i]].box);
+      bin.count++;
+    }
+    float right_costs[bin_count]{};
+    AABB right_box{};
+    int32_t right_count = 0;
+    for (int i = bin_count - 1; i > 0; i--) {
+      right_box.expand(bins[i].box);
+      right_count += bins[i].count;
+      right_costs[i] = right_box.area() * right_count;
+    }
+    AABB left_box{};
+    int32_t left_count = 0;
+    float best_cost = std::numeric_limits<float>::max();
+    int best_bin = -1;
+    for (int i = 0; i < bin_count - 1; i++) {
+      left_box.expand(bins[i].box);
+      left_count += bins[i].count;
+      if (left_count == 0 || left_count == count) {
+        continue;
+      }
+      float cost = left_box.area() * left_count + right_costs[i + 1];
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_bin = i;
+      }
+    }
+    if (best_bin >= 0) {
+      int32_t *middle = std::partition(
+          leaves, leaves + count,
+          [&](int32_t leaf) { return bin_of(leaf) <= best_bin; });
+      split = static_cast<int32_t>(middle - leaves);
+    }
+  }
+  if (split <= 0 || split >= count) {
+    // coincident centers, split at the median
+    split = count / 2;
+    std::nth_element(leaves, leaves + split, leaves + count,
+                     [&](int32_t a, int32_t b) {
+                       return nodes_[a].box.center()[axis] <
+                              nodes_[b].box.center()[axis];
+                     });
+  }
+
+  int32_t left = build_range(leaves, split);
+  int32_t right = build_range(leaves + split, count - split);
+  int32_t node = allocate_node();
+  Node &parent = nodes_[node];
+  parent.left = left;
+  parent.right = right;
+  parent.box = merge(nodes_[left].box, nodes_[right].box);
+  parent.height = 1 + std::max(nodes_[left].height, nodes_[right].height);
+  nodes_[left].parent = node;
+  nodes_[right].parent = node;
+  return node;
+}
+
+} // namespace mare
@@ -0,0 +1,373 @@
+// MARE
+#include "BatchMath.hpp"
+
+// Standard Library
+#include <cstring>
+
+// The SIMD kernels are only built for 64-bit x86, where SSE2 is always
+// available. AVX2 kernels are compiled per function and only called if the CPU
+// supports them.
+#if defined(__x86_64__) || defined(_M_X64)
+#define MARE_BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MARE_TARGET_AVX2
+#else
+#define MARE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace mare {
+namespace batch {
+namespace {
+
+/**
+ * @brief The kernels of one instruction set.
+ */
+struct Kernels {
+  InstructionSet instruction_set;
+  void (*multiply)(const glm::mat4 *, const glm::mat4 *, glm::mat4 *, size_t);
+  void (*multiply_parent)(const glm::mat4 &, const glm::mat4 *, glm::mat4 *,
+                          size_t);
+  void (*multiply_parents)(glm::mat4 *, const glm::mat4 *, const int32_t *,
+                           const uint32_t *, size_t);
+  void (*transform_points)(const glm::mat4 &, const glm::vec3 *, glm::vec3 *,
+                           size_t);
+  void (*transform_aabbs)(const glm::mat4 *, const glm::vec3 *,
+                          const glm::vec3 *, glm::vec3 *, glm::vec3 *, size_t);
+};
+
+// Scalar ----------------------------------------------------------------------
+
+void multiply_scalar(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *out,
+                     size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = a[i] * b[i];
+  }
+}
+
+void multiply_parent_scalar(const glm::mat4 &parent, const glm::mat4 *locals,
+                            glm::mat4 *out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = parent * locals[i];
+  }
+}
+
+void multiply_parents_scalar(glm::mat4 *worlds, const glm::mat4 *locals,
+                             const int32_t *parents, const uint32_t *indices,
+                             size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    uint32_t node = indices[i];
+    worlds[node] = worlds[parents[node]] * locals[node];
+  }
+}
+
+void transform_points_scalar(const glm::mat4 &matrix, const glm::vec3 *points,
+                             glm::vec3 *out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = glm::vec3(matrix * glm::vec4(points[i], 1.0f));
+  }
+}
+
+void transform_aabbs_scalar(const glm::mat4 *matrices, const glm::vec3 *mins,
+                            const glm::vec3 *maxs, glm::vec3 *out_mins,
+                            glm::vec3 *out_maxs, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const glm::mat4 &matrix = matrices[i];
+    glm::vec3 center = glm::vec3(
+        matrix * glm::vec4(0.5f * (mins[i] + maxs[i]), 1.0f));
+    glm::vec3 extent = 0.5f * (maxs[i] - mins[i]);
+    glm::vec3 world_extent{0.0f};
+    for (int j = 0; j < 3; j++) {
+      world_extent += glm::abs(glm::vec3(matrix[j])) * extent[j];
+    }
+    out_mins[i] = center - world_extent;
+    out_maxs[i] = center + world_extent;
+  }
+}
+
+const Kernels scalar_kernels{InstructionSet::SCALAR,   multiply_scalar,
+                             multiply_parent_scalar,   multiply_parents_scalar,
+                             transform_points_scalar,  transform_aabbs_scalar};
+
+#ifdef MARE_BATCH_X86
+
+// SSE -------------------------------------------------------------------------
+
+inline __m128 splat(__m128 v, int lane) {
+  switch (lane) {
+  case 0:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+  case 1:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+  case 2:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+  default:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+}
+
+inline __m128 load3(const glm::vec3 &v) { return _mm_set_ps(0.0f, v.z, v.y, v.x); }
+
+inline void store3(glm::vec3 &v, __m128 value) {
+  float lanes[4];
+  _mm_storeu_ps(lanes, value);
+  std::memcpy(&v, lanes, sizeof(glm::vec3));
+}
+
+/**
+ * @brief out = a * b for column major 4x4 matrices. Both inputs are loaded
+ * before anything is stored so out may alias either of them.
+ */
+inline void multiply_sse(const float *a, const float *b, float *out) {
+  __m128 a0 = _mm_loadu_ps(a);
+  __m128 a1 = _mm_loadu_ps(a + 4);
+  __m128 a2 = _mm_loadu_ps(a + 8);
+  __m128 a3 = _mm_loadu_ps(a + 12);
+  __m128 b_columns[4] = {_mm_loadu_ps(b), _mm_loadu_ps(b + 4),
+                         _mm_loadu_ps(b + 8), _mm_loadu_ps(b + 12)};
+  for (int j = 0; j < 4; j++) {
+    __m128 column = _mm_mul_ps(a0, splat(b_columns[j], 0));
+    column = _mm_add_ps(column, _mm_mul_ps(a1, splat(b_columns[j], 1)));
+    column = _mm_add_ps(column, _mm_mul_ps(a2, splat(b_columns[j], 2)));
+    column = _mm_add_ps(column, _mm_mul_ps(a3, splat(b_columns[j], 3)));
+    _mm_storeu_ps(out + 4 * j, column);
+  }
+}
+
+void multiply_sse(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *out,
+                  size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    multiply_sse(&a[i][0][0], &b[i][0][0], &out[i][0][0]);
+  }
+}
+
+void multiply_parent_sse(const glm::mat4 &parent, const glm::mat4 *locals,
+                         glm::mat4 *out, size_t count) {
+  glm::mat4 a = parent;
+  for (size_t i = 0; i < count; i++) {
+    multiply_sse(&a[0][0], &locals[i][0][0], &out[i][0][0]);
+  }
+}
+
+void multiply_parents_sse(glm::mat4 *worlds, const glm::mat4 *locals,
+                          const int32_t *parents, const uint32_t *indices,
+                          size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    uint32_t node = indices[i];
+    multiply_sse(&worlds[parents[node]][0][0], &locals[node][0][0],
+                 &worlds[node][0][0]);
+  }
+}
+
+void transform_points_sse(const glm::mat4 &matrix, const glm::vec3 *points,
+                          glm::vec3 *out, size_t count) {
+  __m128 c0 = _mm_loadu_ps(&matrix[0][0]);
+  __m128 c1 = _mm_loadu_ps(&matrix[1][0]);
+  __m128 c2 = _mm_loadu_ps(&matrix[2][0]);
+  __m128 c3 = _mm_loadu_ps(&matrix[3][0]);
+  for (size_t i = 0; i < count; i++) {
+    __m128 point = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(points[i].x)));
+    point = _mm_add_ps(point, _mm_mul_ps(c1, _mm_set1_ps(points[i].y)));
+    point = _mm_add_ps(point, _mm_mul_ps(c2, _mm_set1_ps(points[i].z)));
+    store3(out[i], point);
+  }
+}
+
+void transform_aabbs_sse(const glm::mat4 *matrices, const glm::vec3 *mins,
+                         const glm::vec3 *maxs, glm::vec3 *out_mins,
+                         glm::vec3 *out_maxs, size_t count) {
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  for (size_t i = 0; i < count; i++) {
+    const float *matrix = &matrices[i][0][0];
+    __m128 c0 = _mm_loadu_ps(matrix);
+    __m128 c1 = _mm_loadu_ps(matrix + 4);
+    __m128 c2 = _mm_loadu_ps(matrix + 8);
+    __m128 c3 = _mm_loadu_ps(matrix + 12);
+    __m128 min = load3(mins[i]);
+    __m128 max = load3(maxs[i]);
+    __m128 center = _mm_mul_ps(half, _mm_add_ps(min, max));
+    __m128 extent = _mm_mul_ps(half, _mm_sub_ps(max, min));
+    // Transform the center and grow the extent by the absolute basis
+    __m128 world_center = _mm_add_ps(c3, _mm_mul_ps(c0, splat(center, 0)));
+    world_center = _mm_add_ps(world_center, _mm_mul_ps(c1, splat(center, 1)));
+    world_center = _mm_add_ps(world_center, _mm_mul_ps(c2, splat(center, 2)));
+    __m128 world_extent =
+        _mm_mul_ps(_mm_andnot_ps(sign_mask, c0), splat(extent, 0));
+    world_extent = _mm_add_ps(
+        world_extent, _mm_mul_ps(_mm_andnot_ps(sign_mask, c1), splat(extent, 1)));
+    world_extent = _mm_add_ps(
+        world_extent, _mm_mul_ps(_mm_andnot_ps(sign_mask, c2), splat(extent, 2)));
+    store3(out_mins[i], _mm_sub_ps(world_center, world_extent));
+    store3(out_maxs[i], _mm_add_ps(world_center, world_extent));
+  }
+}
+
+const Kernels sse_kernels{InstructionSet::SSE,  multiply_sse,
+                          multiply_parent_sse,  multiply_parents_sse,
+                          transform_points_sse, transform_aabbs_sse};
+
+// AVX2 ------------------------------------------------------------------------
+
+/**
+ * @brief out = a * b for column major 4x4 matrices, two columns at a time.
+ * Both inputs are loaded before anything is stored so out may alias either of
+ * them.
+ */
+MARE_TARGET_AVX2 inline void multiply_avx2(const float *a, const float *b,
+                                           float *out) {
+  __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a));
+  __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 4));
+  __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 8));
+  __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 12));
+  __m256 b01 = _mm256_loadu_ps(b);
+  __m256 b23 = _mm256_loadu_ps(b + 8);
+  __m256 c01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+  __m256 c23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+  c01 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55), c01);
+  c23 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55), c23);
+  c01 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA), c01);
+  c23 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA), c23);
+  c01 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF), c01);
+  c23 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF), c23);
+  _mm256_storeu_ps(out, c01);
+  _mm256_storeu_ps(out + 8, c23);
+}
+
+MARE_TARGET_AVX2 void multiply_avx2(const glm::mat4 *a, const glm::mat4 *b,
+                                    glm::mat4 *out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    multiply_avx2(&a[i][0][0], &b[i][0][0], &out[i][0][0]);
+  }
+}
+
+MARE_TARGET_AVX2 void multiply_parent_avx2(const glm::mat4 &parent,
+                                           const glm::mat4 *locals,
+                                           glm::mat4 *out, size_t count) {
+  glm::mat4 a = parent;
+  for (size_t i = 0; i < count; i++) {
+    multiply_avx2(&a[0][0], &locals[i][0][0], &out[i][0][0]);
+  }
+}
+
+MARE_TARGET_AVX2 void multiply_parents_avx2(glm::mat4 *worlds,
+                                            const glm::mat4 *locals,
+                                            const int32_t *parents,
+                                            const uint32_t *indices,
+                                            size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    uint32_t node = indices[i];
+    multiply_avx2(&worlds[parents[node]][0][0], &locals[node][0][0],
+                  &worlds[node][0][0]);
+  }
+}
+
+const Kernels avx2_kernels{InstructionSet::AVX2,  multiply_avx2,
+                           multiply_parent_avx2,  multiply_parents_avx2,
+                           transform_points_sse,  transform_aabbs_sse};
+
+bool cpu_supports_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  bool fma = (info[2] & (1 << 12)) != 0;
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  // The OS must save the YMM registers on context switches
+  if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif
+
+InstructionSet best_instruction_set() {
+#ifdef MARE_BATCH_X86
+  return cpu_supports_avx2() ? InstructionSet::AVX2 : InstructionSet::SSE;
+#else
+  return InstructionSet::SCALAR;
+#endif
+}
+
+const Kernels *select_kernels(InstructionSet instruction_set) {
+#ifdef MARE_BATCH_X86
+  static const InstructionSet best = best_instruction_set();
+  if (instruction_set == InstructionSet::AVX2 &&
+      best == InstructionSet::AVX2) {
+    return &avx2_kernels;
+  }
+  if (instruction_set != InstructionSet::SCALAR) {
+    return &sse_kernels;
+  }
+#endif
+  return &scalar_kernels;
+}
+
+const Kernels *&active_kernels() {
+  static const Kernels *kernels = select_kernels(best_instruction_set());
+  return kernels;
+}
+
+} // namespace
+
+InstructionSet get_instruction_set() {
+  return active_kernels()->instruction_set;
+}
+
+InstructionSet set_instruction_set(InstructionSet instruction_set) {
+  active_kernels() = select_kernels(instruction_set);
+  return get_instruction_set();
+}
+
+void multiply(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *out,
+              size_t count) {
+  active_kernels()->multiply(a, b, out, count);
+}
+
+void multiply(const glm::mat4 &parent, const glm::mat4 *locals,
+              glm::mat4 *out, size_t count) {
+  active_kernels()->multiply_parent(parent, locals, out, count);
+}
+
+void multiply_parents(glm::mat4 *worlds, const glm::mat4 *locals,
+                      const int32_t *parents, const uint32_t *indices,
+                      size_t count) {
+  active_kernels()->multiply_parents(worlds, locals, parents, indices, count);
+}
+
+void compose(const glm::vec3 *positions, const glm::quat *rotations,
+             const glm::vec3 *scales, glm::mat4 *out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    glm::mat3 rotation = glm::mat3_cast(rotations[i]);
+    out[i][0] = glm::vec4(rotation[0] * scales[i].x, 0.0f);
+    out[i][1] = glm::vec4(rotation[1] * scales[i].y, 0.0f);
+    out[i][2] = glm::vec4(rotation[2] * scales[i].z, 0.0f);
+    out[i][3] = glm::vec4(positions[i], 1.0f);
+  }
+}
+
+void transform_points(const glm::mat4 &matrix, const glm::vec3 *points,
+                      glm::vec3 *out, size_t count) {
+  active_kernels()->transform_points(matrix, points, out, count);
+}
+
+void transform_aabbs(const glm::mat4 *matrices, const glm::vec3 *mins,
+                     const glm::vec3 *maxs, glm::vec3 *out_mins,
+                     glm::vec3 *out_maxs, size_t count) {
+  active_kernels()->transform_aabbs(matrices, mins, maxs, out_mins, out_maxs,
+                                    count);
+}
+
+} // namespace batch
+} // namespace mare
@@ -28,6 +28,8 @@ GLenum opengl::gl_sized_tex_format(TextureType type) {
     return GL_RGB32F;
   case TextureType::RGBA32F:
     return GL_RGBA32F;
+  case TextureType::R32UI:
+    return GL_R32UI;
   case TextureType::DEPTH:
     return GL_DEPTH_COMPONENT32F;
   default:
@@ -53,6 +55,8 @@ GLenum opengl::gl_tex_format(TextureType type) {
     return GL_RGB;
   case TextureType::RGBA32F:
     return GL_RGBA;
+  case TextureType::R32UI:
+    return GL_RED_INTEGER;
   case TextureType::DEPTH:
     return GL_DEPTH_COMPONENT;
   default:
@@ -78,6 +82,8 @@ int opengl::gl_tex_bytes(TextureType type) {
     return 4;
   case TextureType::RGBA32F:
     return 4;
+  case TextureType::R32UI:
+    return 4;
   case TextureType::DEPTH:
     return 1;
   default:
@@ -103,6 +109,8 @@ GLenum opengl::gl_tex_type(TextureType type) {
     return GL_FLOAT;
   case TextureType::RGBA32F:
     return GL_FLOAT;
+  case TextureType::R32UI:
+    return GL_UNSIGNED_INT;
   case TextureType::DEPTH:
     return GL_FLOAT;
   default:
@@ -140,11 +148,11 @@ GLTexture2D::GLTexture2D(const char *filepath) : Texture2D(filepath) {
   }
   glTextureStorage2D(texture_ID_, 1, opengl::gl_sized_tex_format(type_), width_,
                      height_);
-  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, texture_buffer_->name());
+  GLState::bind_buffer(GL_PIXEL_UNPACK_BUFFER, texture_buffer_->name());
   glTextureSubImage2D(texture_ID_, 0, 0, 0, width_, height_,
                       opengl::gl_tex_format(type_), opengl::gl_tex_type(type_),
                       nullptr);
-  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  GLState::bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 GLTexture2D::GLTexture2D(TextureType type, int width, int height)
     : Texture2D(type, width, height) {
@@ -200,39 +208,49 @@ GLTexture2D::GLTexture2D(TextureType type, int width, int height)
         nullptr, width_ * height_ * channels_ * opengl::gl_tex_bytes(type_),
         BufferType::READ_WRITE);
     break;
+  case TextureType::R32UI:
+    channels_ = 1;
+    texture_buffer_ = std::make_unique<GLBuffer<uint32_t>>(
+        nullptr, width_ * height_ * channels_ * opengl::gl_tex_bytes(type_),
+        BufferType::READ_WRITE);
+    // integer textures are incomplete with linear filtering
+    glTextureParameteri(texture_ID_, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    break;
   case TextureType::DEPTH:
     channels_ = 1;
     texture_buffer_ = std::make_unique<GLBuffer<float>>(
         nullptr, width_ * height_ * channels_ * 4, BufferType::READ_WRITE);
 
-    glBindTexture(GL_TEXTURE_2D, texture_ID_);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE,
-                    GL_COMPARE_REF_TO_TEXTURE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_COMPARE_MODE,
+                        GL_COMPARE_REF_TO_TEXTURE);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture_ID_, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     break;
   default:
     break;
   }
-  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, texture_buffer_->name());
+  GLState::bind_buffer(GL_PIXEL_UNPACK_BUFFER, texture_buffer_->name());
   glTextureSubImage2D(texture_ID_, 0, 0, 0, width_, height_,
                       opengl::gl_tex_format(type_), opengl::gl_tex_type(type_),
                       nullptr);
-  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  GLState::bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+GLTexture2D::~GLTexture2D() {
+  GLState::forget_texture(texture_ID_);
+  glDeleteTextures(1, &texture_ID_);
 }
-GLTexture2D::~GLTexture2D() { glDeleteTextures(1, &texture_ID_); }
 
-GLFramebuffer::GLFramebuffer(int width, int height)
-    : Framebuffer(width, height) {
+GLFramebuffer::GLFramebuffer(int width, int height, TextureType color_type)
+    : Framebuffer(width, height, color_type) {
   glCreateFramebuffers(1, &framebuffer_ID_);
   depth_texture_ =
       std::make_unique<GLTexture2D>(TextureType::DEPTH, width, height);
   color_texture_ =
-      std::make_unique<GLTexture2D>(TextureType::RGBA32F, width, height);
+      std::make_unique<GLTexture2D>(color_type, width, height);
   glNamedFramebufferTexture(framebuffer_ID_, GL_DEPTH_ATTACHMENT,
                             depth_texture_->name(), 0);
   glNamedFramebufferTexture(framebuffer_ID_, GL_COLOR_ATTACHMENT0,
@@ -261,7 +279,60 @@ GLFramebuffer::GLFramebuffer(int width, int height)
       std::cerr << "Framebuffer is incomplete (multisample)" << std::endl;
     }
   }
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
+}
+GLFramebuffer::~GLFramebuffer() {
+  GLState::forget_framebuffer(framebuffer_ID_);
+  glDeleteFramebuffers(1, &framebuffer_ID_);
+}
+
+GLGeometryHeap::~GLGeometryHeap() {
+  destroy_pages();
+  if (scratch_) {
+    GLState::forget_buffer(scratch_);
+    glDeleteBuffers(1, &scratch_);
+  }
+}
+uint32_t GLGeometryHeap::create_page(size_t size) {
+  GLuint name;
+  glCreateBuffers(1, &name);
+  glNamedBufferStorage(name, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+  return name;
+}
+void GLGeometryHeap::destroy_page(uint32_t name) {
+  GLState::forget_buffer(name);
+  glDeleteBuffers(1, &name);
+}
+void GLGeometryHeap::write_page(uint32_t name, size_t offset,
+                                const void *data, size_t size) {
+  glNamedBufferSubData(name, offset, size, data);
+}
+void GLGeometryHeap::read_page(uint32_t name, size_t offset, void *data,
+                               size_t size) const {
+  glGetNamedBufferSubData(name, offset, size, data);
+}
+void GLGeometryHeap::move_in_page(uint32_t name, size_t from, size_t to,
+                                  size_t size) {
+  if (to + size <= from) {
+    glCopyNamedBufferSubData(name, name, from, to, size);
+    return;
+  }
+  // copies within a buffer must not overlap
+  if (scratch_size_ < size) {
+    if (scratch_) {
+      GLState::forget_buffer(scratch_);
+      glDeleteBuffers(1, &scratch_);
+    }
+    scratch_size_ = size;
+    glCreateBuffers(1, &scratch_);
+    glNamedBufferStorage(scratch_, scratch_size_, nullptr, 0);
+  }
+  glCopyNamedBufferSubData(name, scratch_, from, 0, size);
+  glCopyNamedBufferSubData(scratch_, name, 0, to, size);
+}
+bool GLGeometryHeap::copy_to_page(const IBuffer &source, uint32_t name,
+                                  size_t offset, size_t size) {
+  glCopyNamedBufferSubData(source.name(), name, source.offset(), offset, size);
+  return true;
 }
-GLFramebuffer::~GLFramebuffer() { glDeleteFramebuffers(1, &framebuffer_ID_); }
 } // namespace mare
\ No newline at end of file
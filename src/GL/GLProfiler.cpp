@@ -0,0 +1,82 @@
+// MARE GL
+#include "GL/GLProfiler.hpp"
+
+namespace mare {
+
+GLGpuTimer::~GLGpuTimer() {
+  for (auto &frame : frames_) {
+    if (!frame.queries.empty()) {
+      glDeleteQueries(static_cast<GLsizei>(frame.queries.size()),
+                      frame.queries.data());
+    }
+  }
+}
+
+void GLGpuTimer::begin(const char *name) {
+  FrameQueries &frame = frames_[current_];
+  if (frame.queries.size() < 2 * (frame.used + 1)) {
+    GLuint queries[2];
+    glGenQueries(2, queries);
+    frame.queries.push_back(queries[0]);
+    frame.queries.push_back(queries[1]);
+  }
+  frame.last_query = frame.queries[2 * frame.used];
+  glQueryCounter(frame.last_query, GL_TIMESTAMP);
+  frame.names.push_back(name);
+  frame.ended.push_back(0);
+  open_scopes_.push_back(frame.used);
+  frame.used++;
+}
+
+void GLGpuTimer::end() {
+  if (open_scopes_.empty()) {
+    return;
+  }
+  FrameQueries &frame = frames_[current_];
+  frame.last_query = frame.queries[2 * open_scopes_.back() + 1];
+  glQueryCounter(frame.last_query, GL_TIMESTAMP);
+  frame.ended[open_scopes_.back()] = 1;
+  open_scopes_.pop_back();
+}
+
+void GLGpuTimer::collect() {
+  // Scopes left open at the end of a frame belong to no frame, their end
+  // query was never issued so they are skipped when the frame is read
+  open_scopes_.clear();
+  current_ = (current_ + 1) % frames_in_flight;
+  FrameQueries &frame = frames_[current_];
+  if (frame.used) {
+    // Queries complete in order so the last query covers the whole frame
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame.last_query, GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (available) {
+      // Map GPU timestamps onto the Profiler's CPU clock
+      GLint64 gpu_now = 0;
+      glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+      int64_t offset =
+          static_cast<int64_t>(Profiler::now()) - static_cast<int64_t>(gpu_now);
+      for (size_t i = 0; i < frame.used; i++) {
+        if (!frame.ended[i]) {
+          continue;
+        }
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(frame.queries[2 * i], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[2 * i + 1], GL_QUERY_RESULT, &end);
+        if (end < begin) {
+          continue;
+        }
+        Profiler::record(frame.names[i],
+                         static_cast<uint64_t>(static_cast<int64_t>(begin) +
+                                               offset),
+                         end - begin, Profiler::gpu_thread);
+      }
+    }
+  }
+  frame.used = 0;
+  frame.names.clear();
+  frame.ended.clear();
+}
+
+} // namespace mare
@@ -0,0 +1,128 @@
+// MARE GL
+#include "GL/GLReadback.hpp"
+#include "GL/GLState.hpp"
+
+// MARE
+#include "Buffers.hpp"
+#include "Renderer.hpp"
+
+namespace mare {
+
+GLPixelReader::~GLPixelReader() {
+  for (Ring *ring : {&depths_, &ids_}) {
+    for (auto &slot : ring->slots) {
+      if (slot.fence) {
+        glDeleteSync(slot.fence);
+      }
+      if (slot.buffer) {
+        GLState::forget_buffer(slot.buffer);
+        glDeleteBuffers(1, &slot.buffer);
+      }
+    }
+  }
+}
+
+bool GLPixelReader::read(const std::vector<glm::ivec2> &pixels) {
+  Slot *slot = begin_read(depths_, pixels.size() * sizeof(float));
+  if (!slot) {
+    return false;
+  }
+  GLuint read_framebuffer = GLState::get_framebuffer(GL_READ_FRAMEBUFFER);
+  GLState::bind_framebuffer(GL_READ_FRAMEBUFFER, 0);
+  int height = Renderer::get_info().window_height;
+  for (size_t i = 0; i < pixels.size(); i++) {
+    // with a pack buffer bound the pointer is an offset into the buffer
+    glReadPixels(pixels[i].x, height - pixels[i].y, 1, 1, GL_DEPTH_COMPONENT,
+                 GL_FLOAT, reinterpret_cast<void *>(i * sizeof(float)));
+  }
+  GLState::bind_framebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+  end_read(depths_, *slot);
+  return true;
+}
+
+bool GLPixelReader::poll(std::vector<float> &depths) {
+  Slot *slot = poll_ring(depths_);
+  if (!slot) {
+    return false;
+  }
+  depths.resize(slot->size / sizeof(float));
+  glGetNamedBufferSubData(slot->buffer, 0, slot->size, depths.data());
+  return true;
+}
+
+bool GLPixelReader::read_ids(Framebuffer *framebuffer,
+                             const std::vector<PixelRect> &rects) {
+  size_t count = 0;
+  for (auto &rect : rects) {
+    count += rect.area();
+  }
+  Slot *slot = begin_read(ids_, count * sizeof(uint32_t));
+  if (!slot) {
+    return false;
+  }
+  GLuint read_framebuffer = GLState::get_framebuffer(GL_READ_FRAMEBUFFER);
+  GLState::bind_framebuffer(GL_READ_FRAMEBUFFER, framebuffer->name());
+  int height = Renderer::get_info().window_height;
+  size_t offset = 0;
+  for (auto &rect : rects) {
+    glm::ivec2 size = rect.max - rect.min;
+    glReadPixels(rect.min.x, height - rect.max.y, size.x, size.y,
+                 GL_RED_INTEGER, GL_UNSIGNED_INT,
+                 reinterpret_cast<void *>(offset));
+    offset += rect.area() * sizeof(uint32_t);
+  }
+  GLState::bind_framebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+  end_read(ids_, *slot);
+  return true;
+}
+
+bool GLPixelReader::poll_ids(std::vector<uint32_t> &ids) {
+  Slot *slot = poll_ring(ids_);
+  if (!slot) {
+    return false;
+  }
+  ids.resize(slot->size / sizeof(uint32_t));
+  glGetNamedBufferSubData(slot->buffer, 0, slot->size, ids.data());
+  return true;
+}
+
+GLPixelReader::Slot *GLPixelReader::begin_read(Ring &ring, size_t size) {
+  if (ring.used == frames_in_flight) {
+    return nullptr;
+  }
+  Slot &slot = ring.slots[(ring.oldest + ring.used) % frames_in_flight];
+  if (!slot.buffer) {
+    glCreateBuffers(1, &slot.buffer);
+  }
+  if (slot.capacity < size) {
+    slot.capacity = size;
+    glNamedBufferData(slot.buffer, slot.capacity, nullptr, GL_STREAM_READ);
+  }
+  slot.size = size;
+  GLState::bind_buffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  return &slot;
+}
+
+void GLPixelReader::end_read(Ring &ring, Slot &slot) {
+  GLState::bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  ring.used++;
+}
+
+GLPixelReader::Slot *GLPixelReader::poll_ring(Ring &ring) {
+  if (!ring.used) {
+    return nullptr;
+  }
+  Slot &slot = ring.slots[ring.oldest];
+  GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+    return nullptr;
+  }
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+  ring.oldest = (ring.oldest + 1) % frames_in_flight;
+  ring.used--;
+  return &slot;
+}
+
+} // namespace mare
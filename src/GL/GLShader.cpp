@@ -14,6 +14,7 @@ GLShader::GLShader(const char *directory) : shaders_{} {
 }
 
 GLShader::~GLShader() {
+  GLState::forget_program(shader_ID_);
   glDeleteProgram(shader_ID_); // Silently ignored if m_programID is 0
   for (auto s : shaders_) {
     glDeleteShader(s);
@@ -253,13 +254,15 @@ void GLShader::upload_uniform(const char *name, IBuffer *uniform,
     // cache the location
     resource_index_cache_.insert_or_assign(
         name, glGetProgramResourceIndex(shader_ID_, GL_UNIFORM_BLOCK, name));
+    // the camera block keeps its own binding for every shader
     uniform_binding_cache_.insert_or_assign(
-        name, static_cast<GLuint>(uniform_binding_cache_.size()));
+        name, static_cast<GLuint>(uniform_binding_cache_.size()) +
+                  Shader::camera_binding + 1);
     glUniformBlockBinding(shader_ID_, resource_index_cache_[name],
                           uniform_binding_cache_[name]);
   }
-  glBindBufferBase(GL_UNIFORM_BUFFER, uniform_binding_cache_[name],
-                   uniform->name());
+  GLState::bind_buffer_base(GL_UNIFORM_BUFFER, uniform_binding_cache_[name],
+                            uniform->name());
   if (resource_index_cache_[name] == GL_INVALID_INDEX &&
       suppress_warnings == false) {
     std::cerr << "SHADER WARNING: No uniform block '" << name
@@ -282,8 +285,8 @@ void GLShader::upload_storage(const char *name, IBuffer *storage,
     glShaderStorageBlockBinding(shader_ID_, resource_index_cache_[name],
                                 storage_binding_cache_[name]);
   }
-  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, storage_binding_cache_[name],
-                   storage->name());
+  GLState::bind_buffer_base(GL_SHADER_STORAGE_BUFFER,
+                            storage_binding_cache_[name], storage->name());
   if (resource_index_cache_[name] == GL_INVALID_INDEX &&
       suppress_warnings == false) {
     std::cerr << "SHADER WARNING: No storage buffer block '" << name
@@ -304,7 +307,7 @@ void GLShader::upload_texture2D(const char *name, Texture2D *texture2D,
         name, static_cast<GLuint>(texture_binding_cache_.size()));
     glUniform1i(resource_location_cache_[name], texture_binding_cache_[name]);
   }
-  glBindTextureUnit(texture_binding_cache_[name], texture2D->name());
+  GLState::bind_texture_unit(texture_binding_cache_[name], texture2D->name());
   if (resource_location_cache_[name] == -1 && suppress_warnings == false) {
     std::cerr << "SHADER WARNING: No uniform sampler2D '" << name
               << "' exists in the shader" << std::endl;
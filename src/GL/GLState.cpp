@@ -0,0 +1,109 @@
+// MARE GL
+#include "GL/GLState.hpp"
+
+// Standard Library
+#include <limits>
+
+namespace mare {
+// Static variables
+GLuint GLState::program_{GLState::unknown};          // current program
+GLuint GLState::vertex_array_{GLState::unknown};     // bound vertex array
+GLuint GLState::draw_framebuffer_{GLState::unknown}; // bound draw framebuffer
+GLuint GLState::read_framebuffer_{GLState::unknown}; // bound read framebuffer
+GLuint GLState::depth_func_{GLState::unknown};       // depth comparison
+GLuint GLState::depth_mask_{GLState::unknown};       // depth writes
+GLuint GLState::cull_face_{GLState::unknown};        // culled faces
+GLuint GLState::polygon_mode_{GLState::unknown};     // polygon rasterization
+GLuint GLState::restart_index_{GLState::unknown};    // primitive restart index
+std::pair<GLenum, GLenum> GLState::blend_func_{
+    GLState::unknown, GLState::unknown}; // blend factors
+std::pair<GLfloat, GLfloat> GLState::polygon_offset_{
+    std::numeric_limits<GLfloat>::quiet_NaN(),
+    std::numeric_limits<GLfloat>::quiet_NaN()}; // polygon depth offset
+std::array<GLint, 4> GLState::viewport_{-1, -1, -1, -1}; // viewport
+std::unordered_map<GLenum, GLuint> GLState::buffers_{}; // non indexed buffers
+std::vector<GLuint> GLState::uniform_buffers_{};         // uniform buffers
+std::vector<GLuint> GLState::storage_buffers_{};         // storage buffers
+std::vector<GLuint> GLState::textures_{};                // texture units
+std::unordered_map<GLenum, GLuint> GLState::capabilities_{}; // capabilities
+uint32_t GLState::issued_{0};  // calls issued since the last reset
+uint32_t GLState::skipped_{0}; // calls skipped since the last reset
+
+void GLState::invalidate() {
+  program_ = unknown;
+  vertex_array_ = unknown;
+  draw_framebuffer_ = unknown;
+  read_framebuffer_ = unknown;
+  depth_func_ = unknown;
+  depth_mask_ = unknown;
+  cull_face_ = unknown;
+  polygon_mode_ = unknown;
+  restart_index_ = unknown;
+  blend_func_ = {unknown, unknown};
+  // NaN never compares equal, so the next offset is always issued
+  polygon_offset_ = {std::numeric_limits<GLfloat>::quiet_NaN(),
+                     std::numeric_limits<GLfloat>::quiet_NaN()};
+  // a negative size is never a valid viewport
+  viewport_ = {-1, -1, -1, -1};
+  buffers_.clear();
+  uniform_buffers_.clear();
+  storage_buffers_.clear();
+  textures_.clear();
+  capabilities_.clear();
+}
+
+GLuint GLState::get_framebuffer(GLenum target) {
+  GLuint &framebuffer =
+      target == GL_READ_FRAMEBUFFER ? read_framebuffer_ : draw_framebuffer_;
+  if (framebuffer == unknown) {
+    GLint binding = 0;
+    glGetIntegerv(target == GL_READ_FRAMEBUFFER ? GL_READ_FRAMEBUFFER_BINDING
+                                                : GL_DRAW_FRAMEBUFFER_BINDING,
+                  &binding);
+    framebuffer = static_cast<GLuint>(binding);
+  }
+  return framebuffer;
+}
+
+void GLState::forget_program(GLuint program) {
+  if (program_ == program) {
+    program_ = unknown;
+  }
+}
+
+void GLState::forget_vertex_array(GLuint vertex_array) {
+  if (vertex_array_ == vertex_array) {
+    vertex_array_ = unknown;
+  }
+}
+
+void GLState::forget_buffer(GLuint buffer) {
+  for (auto &[target, binding] : buffers_) {
+    if (binding == buffer) {
+      binding = unknown;
+    }
+  }
+  forget(uniform_buffers_, buffer);
+  forget(storage_buffers_, buffer);
+}
+
+void GLState::forget_texture(GLuint texture) { forget(textures_, texture); }
+
+void GLState::forget_framebuffer(GLuint framebuffer) {
+  if (draw_framebuffer_ == framebuffer) {
+    draw_framebuffer_ = unknown;
+  }
+  if (read_framebuffer_ == framebuffer) {
+    read_framebuffer_ = unknown;
+  }
+}
+
+void GLState::forget(std::vector<GLuint> &bindings, GLuint name) {
+  for (auto &binding : bindings) {
+    if (binding == name) {
+      binding = unknown;
+    }
+  }
+}
+
+} // namespace mare
@@ -0,0 +1,194 @@
+// MARE
+#include "GeometryHeap.hpp"
+
+// Standard Library
+#include <algorithm>
+
+namespace mare {
+
+bool GeometryHeap::contains(const IBuffer &buffer) const {
+  for (auto &page : pages_) {
+    if (page.name && page.name == buffer.name()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void GeometryHeap::defragment() {
+  defragmentations_++;
+  std::vector<std::vector<uint32_t>> page_allocations(pages_.size());
+  for (uint32_t handle = 0; handle < allocations_.size(); handle++) {
+    if (allocations_[handle].live) {
+      page_allocations[allocations_[handle].page].push_back(handle);
+    }
+  }
+  for (uint32_t index = 0; index < pages_.size(); index++) {
+    Page &page = pages_[index];
+    if (!page.name) {
+      continue;
+    }
+    std::vector<uint32_t> &handles = page_allocations[index];
+    if (handles.empty()) {
+      destroy_page(page.name);
+      page = Page{};
+      continue;
+    }
+    std::sort(handles.begin(), handles.end(), [&](uint32_t a, uint32_t b) {
+      return allocations_[a].offset < allocations_[b].offset;
+    });
+    // Buffers only ever move down, so each move reads data that is not yet
+    // overwritten
+    size_t end = 0;
+    for (uint32_t handle : handles) {
+      Allocation &allocation = allocations_[handle];
+      size_t offset = align(end, allocation.alignment);
+      if (offset < allocation.offset) {
+        move_in_page(page.name, allocation.offset, offset, allocation.size);
+        bytes_moved_ += allocation.size;
+        allocation.offset = offset;
+      }
+      end = allocation.offset + allocation.size;
+    }
+    page.free_offsets.clear();
+    page.free_sizes.clear();
+    if (end < page.size) {
+      insert_free(page, end, page.size - end);
+    }
+  }
+}
+
+GeometryHeapStats GeometryHeap::get_stats() const {
+  GeometryHeapStats stats{};
+  for (auto &page : pages_) {
+    if (!page.name) {
+      continue;
+    }
+    stats.pages++;
+    stats.capacity += page.size;
+    stats.free_blocks += static_cast<uint32_t>(page.free_sizes.size());
+    if (!page.free_sizes.empty()) {
+      stats.largest_free_block =
+          std::max(stats.largest_free_block, page.free_sizes.rbegin()->first);
+    }
+  }
+  for (auto &allocation : allocations_) {
+    if (allocation.live) {
+      stats.allocations++;
+      stats.used += allocation.size;
+    }
+  }
+  stats.defragmentations = defragmentations_;
+  stats.bytes_moved = bytes_moved_;
+  return stats;
+}
+
+void GeometryHeap::destroy_pages() {
+  for (auto &page : pages_) {
+    if (page.name) {
+      destroy_page(page.name);
+      page = Page{};
+    }
+  }
+}
+
+uint32_t GeometryHeap::allocate(size_t size, size_t alignment) {
+  alignment = std::max(alignment, size_t(1));
+  uint32_t index = 0;
+  size_t offset = 0;
+  std::set<std::pair<size_t, size_t>>::iterator block;
+  for (; index < pages_.size(); index++) {
+    block = best_fit(pages_[index], size, alignment, offset);
+    if (block != pages_[index].free_sizes.end()) {
+      break;
+    }
+  }
+  if (index == pages_.size()) {
+    // reuse the slot of a released page so the page indices stay stable
+    index = 0;
+    while (index < pages_.size() && pages_[index].name) {
+      index++;
+    }
+    if (index == pages_.size()) {
+      pages_.emplace_back();
+    }
+    Page &page = pages_[index];
+    page.size = std::max(page_size_, size);
+    page.name = create_page(page.size);
+    insert_free(page, 0, page.size);
+    block = best_fit(page, size, alignment, offset);
+  }
+  Page &page = pages_[index];
+  size_t block_offset = block->second;
+  size_t block_end = block->second + block->first;
+  erase_free(page, block_offset);
+  if (offset > block_offset) {
+    insert_free(page, block_offset, offset - block_offset);
+  }
+  if (offset + size < block_end) {
+    insert_free(page, offset + size, block_end - offset - size);
+  }
+  uint32_t handle;
+  if (free_handles_.empty()) {
+    handle = static_cast<uint32_t>(allocations_.size());
+    allocations_.emplace_back();
+  } else {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+  }
+  allocations_[handle] = {index, offset, size, alignment, true};
+  return handle;
+}
+
+void GeometryHeap::free(uint32_t handle) {
+  Allocation &allocation = allocations_[handle];
+  insert_free(pages_[allocation.page], allocation.offset, allocation.size);
+  allocation.live = false;
+  free_handles_.push_back(handle);
+}
+
+std::set<std::pair<size_t, size_t>>::iterator
+GeometryHeap::best_fit(Page &page, size_t size, size_t alignment,
+                       size_t &offset) {
+  // the smallest range that fits is usually the first one large enough,
+  // larger ranges are only needed when alignment padding does not fit
+  for (auto it = page.free_sizes.lower_bound({size, 0});
+       it != page.free_sizes.end(); ++it) {
+    size_t aligned = align(it->second, alignment);
+    if (aligned + size <= it->second + it->first) {
+      offset = aligned;
+      return it;
+    }
+  }
+  return page.free_sizes.end();
+}
+
+void GeometryHeap::insert_free(Page &page, size_t offset, size_t size) {
+  if (!size) {
+    return;
+  }
+  auto next = page.free_offsets.lower_bound(offset);
+  if (next != page.free_offsets.end() && offset + size == next->first) {
+    size += next->second;
+    erase_free(page, next->first);
+  }
+  auto previous = page.free_offsets.lower_bound(offset);
+  if (previous != page.free_offsets.begin()) {
+    --previous;
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      size += previous->second;
+      erase_free(page, offset);
+    }
+  }
+  page.free_offsets[offset] = size;
+  page.free_sizes.insert({size, offset});
+}
+
+void GeometryHeap::erase_free(Page &page, size_t offset) {
+  auto it = page.free_offsets.find(offset);
+  page.free_sizes.erase({it->second, it->first});
+  page.free_offsets.erase(it);
+}
+
+} // namespace mare
@@ -0,0 +1,78 @@
+// MARE
+#include "Headless/HeadlessBuffers.hpp"
+
+// External Libraries
+#include "stb_image.h"
+
+// Standard Library
+#include <atomic>
+#include <cstring>
+
+namespace mare {
+
+uint32_t headless::gen_name() {
+  static std::atomic<uint32_t> next_name{1};
+  return next_name++;
+}
+
+HostTexture2D::HostTexture2D(const char *filepath) : Texture2D(filepath) {
+  texture_ID_ = headless::gen_name();
+  type_ = TextureType::RGBA8;
+  width_ = 0;
+  height_ = 0;
+  channels_ = 0;
+  if (!stbi_info(filepath, &width_, &height_, &channels_)) {
+    std::cerr << "Failed to load texture: " << filepath << std::endl;
+  }
+  switch (channels_) {
+  case 1:
+    type_ = TextureType::R8;
+    break;
+  case 2:
+    type_ = TextureType::RG8;
+    break;
+  case 3:
+    type_ = TextureType::RGB8;
+    break;
+  default:
+    break;
+  }
+}
+
+HostTexture2D::HostTexture2D(TextureType type, int width, int height)
+    : Texture2D(type, width, height) {
+  texture_ID_ = headless::gen_name();
+  channels_ = 0;
+}
+
+HostFramebuffer::HostFramebuffer(int width, int height,
+                                 TextureType color_type)
+    : Framebuffer(width, height, color_type) {
+  framebuffer_ID_ = headless::gen_name();
+  depth_texture_ =
+      std::make_unique<HostTexture2D>(TextureType::DEPTH, width, height);
+  color_texture_ =
+      std::make_unique<HostTexture2D>(color_type, width, height);
+}
+
+uint32_t HostGeometryHeap::create_page(size_t size) {
+  uint32_t name = headless::gen_name();
+  storage_[name].resize(size);
+  return name;
+}
+void HostGeometryHeap::destroy_page(uint32_t name) { storage_.erase(name); }
+void HostGeometryHeap::write_page(uint32_t name, size_t offset,
+                                  const void *data, size_t size) {
+  std::memcpy(storage_.at(name).data() + offset, data, size);
+}
+void HostGeometryHeap::read_page(uint32_t name, size_t offset, void *data,
+                                 size_t size) const {
+  std::memcpy(data, storage_.at(name).data() + offset, size);
+}
+void HostGeometryHeap::move_in_page(uint32_t name, size_t from, size_t to,
+                                    size_t size) {
+  uint8_t *page = storage_.at(name).data();
+  std::memmove(page + to, page + from, size);
+}
+
+} // namespace mare
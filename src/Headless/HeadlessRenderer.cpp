@@ -0,0 +1,302 @@
+// MARE Headless
+#include "Headless/HeadlessRenderer.hpp"
+#include "Headless/HeadlessBuffers.hpp"
+#include "Headless/HeadlessShader.hpp"
+
+// MARE
+#include "Entities/Camera.hpp"
+#include "Profiler.hpp"
+#include "Scene.hpp"
+
+// Standard Library
+#include <chrono>
+
+namespace mare {
+
+namespace headless {
+/**
+ * @brief The render states recorded in Command::key by SET_STATE commands.
+ */
+enum StateKey : uint32_t {
+  WIREFRAME = 0,
+  PRIMITIVE_RESTART,
+  DEPTH_TEST,
+  FACE_CULLING,
+  BLENDING,
+  POLYGON_OFFSET
+};
+} // namespace headless
+
+void HeadlessRenderer::run() {
+  init_info();
+  info.API = RendererAPI::Headless;
+  init_renderer();
+  startup();
+  start_renderer();
+}
+
+void HeadlessRenderer::init_renderer() {
+  running = true;
+  frame_count_ = 0;
+  total_frame_time_ = 0.0;
+  info.window_aspect = float(info.window_width) / float(info.window_height);
+}
+
+void HeadlessRenderer::start_renderer() {
+  info.current_time = 0.0;
+  while (running && (frame_limit_ == 0 || frame_count_ < frame_limit_)) {
+    MARE_PROFILE_SCOPE("Frame");
+    auto frame_start = std::chrono::steady_clock::now();
+    log_.clear();
+    collect_readbacks(&pixel_reader_);
+    render_frame(frame_time_);
+    flush_readbacks(&pixel_reader_);
+    info.current_time += frame_time_;
+    input.begin_frame();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - frame_start;
+    last_frame_time_ = elapsed.count();
+    total_frame_time_ += last_frame_time_;
+    frame_count_++;
+  }
+  shutdown();
+  scenes_.clear();
+  scene_index_.invalidate();
+  clear_readbacks();
+  geometry_heap_.reset();
+}
+
+std::string HeadlessRenderer::api_get_vendor_string() {
+  return "HEADLESS VENDOR: MARE";
+}
+std::string HeadlessRenderer::api_get_version_string() {
+  return "HEADLESS VERSION: 1.0";
+}
+std::string HeadlessRenderer::api_get_renderer_string() {
+  return "HEADLESS RENDERER: Command Log";
+}
+
+void HeadlessRenderer::api_set_clipboard_string(std::string str) {
+  clipboard_ = str;
+}
+std::string HeadlessRenderer::api_get_clipboard_string() { return clipboard_; }
+
+void HeadlessRenderer::api_set_window_title(const char *title) {
+  info.window_title = title;
+}
+
+void HeadlessRenderer::api_set_cursor(CursorType type) {
+  if (type == CursorType::DISABLED) {
+    info.cursor = false;
+  }
+}
+
+void HeadlessRenderer::api_clear_color_buffer(glm::vec4 color) {
+  log_.record({CommandType::CLEAR_COLOR, 0, 0, 0, 0});
+}
+void HeadlessRenderer::api_clear_color_buffer(glm::uvec4 color) {
+  log_.record({CommandType::CLEAR_COLOR, 0, 0, 0, 0});
+}
+
+void HeadlessRenderer::api_clear_depth_buffer() {
+  log_.record({CommandType::CLEAR_DEPTH, 0, 0, 0, 0});
+}
+
+void HeadlessRenderer::api_resize_viewport(int width, int height) {
+  info.window_width = width;
+  info.window_height = height;
+  info.window_aspect = float(info.window_width) / float(info.window_height);
+  log_.record({CommandType::VIEWPORT, 0, 0, static_cast<uint32_t>(width),
+               static_cast<uint32_t>(height)});
+}
+
+void HeadlessRenderer::api_wireframe_mode(bool wireframe) {
+  log_.record({CommandType::SET_STATE, 0, headless::WIREFRAME,
+               static_cast<uint32_t>(wireframe), 0});
+}
+
+void HeadlessRenderer::api_enable_primative_restart(bool enable,
+                                                    uint32_t index) {
+  log_.record({CommandType::SET_STATE, index, headless::PRIMITIVE_RESTART,
+               static_cast<uint32_t>(enable), 0});
+}
+
+void HeadlessRenderer::api_enable_depth_testing(bool enable) {
+  log_.record({CommandType::SET_STATE, 0, headless::DEPTH_TEST,
+               static_cast<uint32_t>(enable), 0});
+}
+
+void HeadlessRenderer::api_enable_face_culling(bool enable) {
+  log_.record({CommandType::SET_STATE, 0, headless::FACE_CULLING,
+               static_cast<uint32_t>(enable), 0});
+}
+
+void HeadlessRenderer::api_enable_blending(bool enable) {
+  log_.record({CommandType::SET_STATE, 0, headless::BLENDING,
+               static_cast<uint32_t>(enable), 0});
+}
+
+void HeadlessRenderer::api_enable_polygon_offset(bool enable, float factor,
+                                                 float units) {
+  log_.record({CommandType::SET_STATE, 0, headless::POLYGON_OFFSET,
+               static_cast<uint32_t>(enable), 0});
+}
+
+glm::vec3 HeadlessRenderer::api_raycast(Camera *camera) {
+  return api_raycast(camera, input.mouse_pos);
+}
+
+glm::vec3 HeadlessRenderer::api_raycast(Camera *camera,
+                                        glm::ivec2 screen_coords) {
+  log_.record({CommandType::READ_PIXELS, 0, 0, 1, 0});
+  glm::mat4 inversed_camera =
+      glm::inverse(camera->get_projection() * camera->get_view_matrix());
+  float x = 2.0f * (float)screen_coords.x / (float)(info.window_width) - 1.0f;
+  float y = -2.0f * (float)screen_coords.y / (float)(info.window_height) + 1.0f;
+  glm::vec4 screen_vector = glm::vec4(x, y, 1.0f, 1.0f);
+  glm::vec4 world_vector = inversed_camera * screen_vector;
+  world_vector /= world_vector.w;
+  return glm::vec3(world_vector);
+}
+
+void HeadlessRenderer::api_set_framebuffer(Framebuffer *framebuffer) {
+  log_.record({CommandType::BIND_FRAMEBUFFER,
+               framebuffer ? framebuffer->name() : 0, 0, 0, 0});
+}
+void HeadlessRenderer::api_bind_uniform_buffer(uint32_t binding,
+                                               IBuffer *uniform) {
+  // the key of the command is the binding point
+  log_.record({CommandType::BIND_UNIFORM, uniform->name(), binding,
+               static_cast<uint32_t>(uniform->size()), 0});
+}
+
+// Textures
+Scoped<Texture2D>
+HeadlessRenderer::api_gen_texture2D(const char *image_filepath) {
+  return std::make_unique<HostTexture2D>(image_filepath);
+}
+Scoped<Texture2D> HeadlessRenderer::api_gen_texture2D(TextureType type,
+                                                      int width, int height) {
+  return std::make_unique<HostTexture2D>(type, width, height);
+}
+
+// Framebuffers
+Scoped<Framebuffer>
+HeadlessRenderer::api_gen_framebuffer(int width, int height,
+                                      TextureType color_type) {
+  return std::make_unique<HostFramebuffer>(width, height, color_type);
+}
+
+// Shaders
+Scoped<Shader> HeadlessRenderer::api_gen_shader(const char *directory) {
+  return std::make_unique<HeadlessShader>(directory, &log_);
+}
+
+void HeadlessRenderer::record_draw(SimpleMesh *mesh, Material *material,
+                                   unsigned int instance_count) {
+  auto state = mesh->render_states.find(material->name());
+  uint32_t render_state =
+      state != mesh->render_states.end() ? state->second : 0;
+  log_.record({instance_count ? CommandType::DRAW_INSTANCED : CommandType::DRAW,
+               render_state, static_cast<uint32_t>(mesh->get_draw_method()),
+               static_cast<uint32_t>(mesh->render_count()), instance_count});
+}
+
+// normal rendering of simple meshes
+void HeadlessRenderer::api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                                              Material *material) {
+  material->bind();
+  mesh->bind(material);
+  material->upload_camera(camera);
+  material->upload_mesh(mesh, true);
+  material->render();
+  record_draw(mesh, material, 0);
+}
+// composite rendering
+void HeadlessRenderer::api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                                              Material *material,
+                                              Transform *parent_model) {
+  material->bind();
+  mesh->bind(material);
+  material->upload_camera(camera);
+  material->upload_mesh(mesh, parent_model, true);
+  material->render();
+  record_draw(mesh, material, 0);
+}
+// instanced rendering
+void HeadlessRenderer::api_render_simple_mesh(Camera *camera, SimpleMesh *mesh,
+                                              Material *material,
+                                              Transform *parent_model,
+                                              unsigned int instance_count,
+                                              Buffer<Transform> *models) {
+  material->bind();
+  mesh->bind(material);
+  material->upload_camera(camera);
+  material->upload_mesh(mesh, parent_model, models, true);
+  material->render();
+  record_draw(mesh, material, instance_count);
+}
+// multi-draw rendering of batched meshes
+void HeadlessRenderer::api_render_simple_mesh_indirect(
+    Camera *camera, SimpleMesh *mesh, Material *material,
+    Transform *parent_model, Buffer<DrawCommand> *commands,
+    unsigned int draw_count, Buffer<Transform> *models) {
+  material->bind();
+  mesh->bind(material);
+  material->upload_camera(camera);
+  material->upload_mesh(mesh, parent_model, models, true);
+  material->render();
+  api_draw_simple_mesh_indirect(mesh, material, commands, draw_count);
+}
+void HeadlessRenderer::api_draw_simple_mesh(SimpleMesh *mesh,
+                                            Material *material,
+                                            unsigned int instance_count) {
+  record_draw(mesh, material, instance_count);
+}
+void HeadlessRenderer::api_draw_simple_mesh_indirect(
+    SimpleMesh *mesh, Material *material, Buffer<DrawCommand> *commands,
+    unsigned int draw_count) {
+  auto state = mesh->render_states.find(material->name());
+  uint32_t render_state =
+      state != mesh->render_states.end() ? state->second : 0;
+  log_.record({CommandType::DRAW_INDIRECT, render_state,
+               static_cast<uint32_t>(mesh->get_draw_method()), draw_count, 0});
+}
+// Mesh functions
+void HeadlessRenderer::api_bind_mesh_render_state(SimpleMesh *mesh,
+                                                  Material *material) {
+  if (!material) {
+    log_.record({CommandType::BIND_RENDER_STATE, 0, 0, 0, 0});
+    return;
+  }
+  auto state = mesh->render_states.find(material->name());
+  if (state == mesh->render_states.end()) {
+    state =
+        mesh->render_states.insert({material->name(), headless::gen_name()})
+            .first;
+    for (auto &buffer : mesh->geometry_buffers) {
+      mesh->vertex_render_count = buffer->count();
+    }
+  }
+  log_.record({CommandType::BIND_RENDER_STATE, state->second, 0, 0, 0});
+}
+void HeadlessRenderer::api_destroy_mesh_render_states(SimpleMesh *mesh) {}
+void HeadlessRenderer::api_push_mesh_geometry_buffer(
+    SimpleMesh *mesh, Referenced<Buffer<float>> geometry_buffer) {
+  mesh->geometry_buffers.push_back(geometry_buffer);
+  mesh->invalidate_render_state_cache();
+}
+void HeadlessRenderer::api_set_mesh_index_buffer(
+    SimpleMesh *mesh, Referenced<Buffer<uint32_t>> index_buffer) {
+  mesh->index_render_count = index_buffer->count();
+  mesh->index_buffer = index_buffer;
+  mesh->invalidate_render_state_cache();
+}
+
+// Compute Programs
+void HeadlessRenderer::api_dispatch_compute(uint32_t x, uint32_t y,
+                                            uint32_t z) {
+  log_.record({CommandType::DISPATCH_COMPUTE, 0, x, y, z});
+}
+
+} // namespace mare
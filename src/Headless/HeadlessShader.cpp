@@ -0,0 +1,78 @@
+// MARE
+#include "Headless/HeadlessShader.hpp"
+#include "Headless/HeadlessBuffers.hpp"
+
+namespace mare {
+
+HeadlessShader::HeadlessShader(const char *directory, CommandLog *log)
+    : log_(log) {
+  shader_ID_ = headless::gen_name();
+}
+
+void HeadlessShader::use() const {
+  log_->record({CommandType::USE_SHADER, shader_ID_, 0, 0, 0});
+}
+
+void HeadlessShader::record_uniform(const char *name, uint32_t count) {
+  log_->record({CommandType::UPLOAD_UNIFORM, shader_ID_,
+                CommandLog::hash(name), count, 0});
+}
+
+void HeadlessShader::upload_int(const char *name, int value,
+                                bool suppress_warnings) {
+  record_uniform(name, 1);
+}
+void HeadlessShader::upload_float(const char *name, float value,
+                                  bool suppress_warnings) {
+  record_uniform(name, 1);
+}
+void HeadlessShader::upload_vec2(const char *name, glm::vec2 value,
+                                 bool suppress_warnings) {
+  record_uniform(name, 2);
+}
+void HeadlessShader::upload_vec3(const char *name, glm::vec3 value,
+                                 bool suppress_warnings) {
+  record_uniform(name, 3);
+}
+void HeadlessShader::upload_vec4(const char *name, glm::vec4 value,
+                                 bool suppress_warnings) {
+  record_uniform(name, 4);
+}
+void HeadlessShader::upload_mat3(const char *name, glm::mat3 value,
+                                 bool suppress_warnings) {
+  record_uniform(name, 9);
+}
+void HeadlessShader::upload_mat4(const char *name, glm::mat4 value,
+                                 bool suppress_warnings) {
+  record_uniform(name, 16);
+}
+void HeadlessShader::upload_uniform(const char *name, IBuffer *uniform,
+                                    bool suppress_warnings) {
+  log_->record({CommandType::UPLOAD_BUFFER, uniform ? uniform->name() : 0,
+                CommandLog::hash(name),
+                uniform ? static_cast<uint32_t>(uniform->size()) : 0, 0});
+}
+void HeadlessShader::upload_storage(const char *name, IBuffer *storage,
+                                    bool suppress_warnings) {
+  log_->record({CommandType::UPLOAD_BUFFER, storage ? storage->name() : 0,
+                CommandLog::hash(name),
+                storage ? static_cast<uint32_t>(storage->size()) : 0, 0});
+}
+void HeadlessShader::upload_texture2D(const char *name, Texture2D *texture2D,
+                                      bool suppress_warnings) {
+  log_->record({CommandType::UPLOAD_TEXTURE,
+                texture2D ? texture2D->name() : 0, CommandLog::hash(name), 1,
+                0});
+}
+void HeadlessShader::upload_image2D(const char *name, Texture2D *texture2D,
+                                    bool suppress_warnings) {
+  log_->record({CommandType::UPLOAD_TEXTURE,
+                texture2D ? texture2D->name() : 0, CommandLog::hash(name), 1,
+                0});
+}
+void HeadlessShader::barrier(BarrierType type) {
+  log_->record(
+      {CommandType::BARRIER, shader_ID_, static_cast<uint32_t>(type), 0, 0});
+}
+
+} // namespace mare
@@ -0,0 +1,119 @@
+#include "JobSystem.hpp"
+
+namespace mare {
+
+JobSystem::JobSystem(unsigned int thread_count) {
+  if (thread_count == 0) {
+    unsigned int hardware_threads = std::thread::hardware_concurrency();
+    thread_count = hardware_threads > 1 ? hardware_threads - 1 : 0;
+  }
+  // The last queue belongs to the thread calling parallel_for()
+  for (unsigned int i = 0; i <= thread_count; i++) {
+    queues_.push_back(gen_scoped<WorkQueue>());
+  }
+  for (unsigned int i = 0; i < thread_count; i++) {
+    workers_.emplace_back(&JobSystem::worker_loop, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void JobSystem::parallel_for(size_t count, size_t grain_size,
+                             const std::function<void(size_t, size_t)> &job) {
+  if (count == 0) {
+    return;
+  }
+  if (grain_size == 0) {
+    grain_size = 1;
+  }
+  // Run small jobs inline instead of waking the pool
+  if (workers_.empty() || count <= grain_size) {
+    job(0, count);
+    return;
+  }
+  size_t task_count = (count + grain_size - 1) / grain_size;
+  size_t queue_count = queues_.size();
+  // Distribute the tasks round-robin so every thread starts with local work
+  for (size_t i = 0; i < task_count; i++) {
+    Task task{&job, i * grain_size, std::min(count, (i + 1) * grain_size)};
+    WorkQueue &queue = *queues_[i % queue_count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    pending_ += task_count;
+  }
+  wake_.notify_all();
+  // The calling thread helps until every task has finished
+  size_t caller_queue = queue_count - 1;
+  Task task;
+  while (pending_.load() > 0) {
+    if (pop_task(caller_queue, task)) {
+      run_task(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool JobSystem::pop_task(size_t queue_index, Task &task) {
+  // Pop from the back of the local queue
+  {
+    WorkQueue &queue = *queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+  // Steal from the front of the other queues
+  size_t queue_count = queues_.size();
+  for (size_t i = 1; i < queue_count; i++) {
+    WorkQueue &victim = *queues_[(queue_index + i) % queue_count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::run_task(const Task &task) {
+  (*task.job)(task.begin, task.end);
+  pending_--;
+}
+
+void JobSystem::worker_loop(size_t queue_index) {
+  Task task;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait(lock, [this]() { return stopping_ || pending_.load() > 0; });
+      if (stopping_) {
+        return;
+      }
+    }
+    while (pending_.load() > 0) {
+      if (pop_task(queue_index, task)) {
+        run_task(task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+} // namespace mare
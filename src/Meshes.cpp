@@ -1,8 +1,113 @@
 // MARE
 #include "Meshes.hpp"
+#include "BatchMath.hpp"
 #include "Renderer.hpp"
 
+// Standard Library
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
 namespace mare {
+namespace {
+// The diameter of a model space sphere as a fraction of the viewport height,
+// the w of the clip space center is the view depth or 1 for an orthographic
+// projection
+float projected_size(const glm::mat4 &view_projection, float projection_scale,
+                     const BoundingSphere &sphere, const glm::mat4 &model) {
+  if (sphere.empty()) {
+    return std::numeric_limits<float>::max();
+  }
+  BoundingSphere world = sphere.transformed(model);
+  float w = (view_projection * glm::vec4(world.center, 1.0f)).w;
+  if (w <= std::numeric_limits<float>::epsilon()) {
+    // the center is at or behind the Camera
+    return std::numeric_limits<float>::max();
+  }
+  return world.radius * projection_scale / w;
+}
+
+// Moller-Trumbore, both faces of the triangle are hit
+bool intersect_triangle(glm::vec3 origin, glm::vec3 direction, glm::vec3 a,
+                        glm::vec3 b, glm::vec3 c, float &distance) {
+  glm::vec3 edge1 = b - a;
+  glm::vec3 edge2 = c - a;
+  glm::vec3 p = glm::cross(direction, edge2);
+  float determinant = glm::dot(edge1, p);
+  if (std::fabs(determinant) < 1e-12f) {
+    return false;
+  }
+  float inverse_determinant = 1.0f / determinant;
+  glm::vec3 s = origin - a;
+  float u = glm::dot(s, p) * inverse_determinant;
+  if (u < 0.0f || u > 1.0f) {
+    return false;
+  }
+  glm::vec3 q = glm::cross(s, edge1);
+  float v = glm::dot(direction, q) * inverse_determinant;
+  if (v < 0.0f || u + v > 1.0f) {
+    return false;
+  }
+  distance = glm::dot(edge2, q) * inverse_determinant;
+  return distance >= 0.0f;
+}
+bool has_positions(BufferFormat &format) {
+  for (auto &attribute : format) {
+    if (attribute.type == AttributeType::POSITION_2D ||
+        attribute.type == AttributeType::POSITION_3D) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The positions of interleaved vertex data, empty if the format has none
+std::vector<glm::vec3> positions_of(const float *data, BufferFormat &format,
+                                    uint32_t vertex_count) {
+  size_t stride = format.stride / sizeof(float);
+  if (!data || !stride || !vertex_count) {
+    return {};
+  }
+  for (auto &attribute : format) {
+    if (attribute.type != AttributeType::POSITION_2D &&
+        attribute.type != AttributeType::POSITION_3D) {
+      continue;
+    }
+    size_t offset = attribute.offset / sizeof(float);
+    uint32_t dimensions = attribute.component_count();
+    std::vector<glm::vec3> positions(vertex_count, glm::vec3(0.0f));
+    for (uint32_t vertex = 0; vertex < vertex_count; vertex++) {
+      for (uint32_t i = 0; i < dimensions; i++) {
+        positions[vertex][i] = data[vertex * stride + offset + i];
+      }
+    }
+    return positions;
+  }
+  return {};
+}
+} // namespace
+
+bool Mesh::intersects(const Frustum &frustum, Transform *parent_transform) {
+  const AABB &aabb = get_aabb();
+  if (aabb.empty()) {
+    return true;
+  }
+  glm::mat4 model = get_transformation_matrix();
+  if (parent_transform) {
+    model = parent_transform->get_transformation_matrix() * model;
+  }
+  // The sphere test is cheaper and rejects most packets, the box is tighter
+  return frustum.intersects(get_bounding_sphere().transformed(model)) &&
+         frustum.intersects(aabb.transformed(model));
+}
+
+void Mesh::bounds_changed() {
+  for (Entity *owner : owners_) {
+    owner->mark_bounds_dirty();
+  }
+}
+
 SimpleMesh::SimpleMesh()
     : geometry_buffer_count(0), vertex_render_count(0), index_render_count(0) {}
 SimpleMesh::~SimpleMesh() { Renderer::destroy_mesh_render_states(this); }
@@ -21,17 +126,171 @@ void SimpleMesh::render(Camera *camera, Material *material,
                                instance_count, models);
 }
 void SimpleMesh::bind(Material *material) {
+  if (use_geometry_heap && render_states.empty()) {
+    Renderer::store_mesh_geometry(this);
+  }
   Renderer::bind_mesh_render_state(this, material);
 }
 void SimpleMesh::add_geometry_buffer(
     Referenced<Buffer<float>> geometry_buffer) {
   Renderer::push_mesh_geometry_buffer(this, geometry_buffer);
 }
+void SimpleMesh::add_geometry_buffer(Referenced<Buffer<float>> geometry_buffer,
+                                     const float *data) {
+  // the positions of a Mesh come from its first Geometry Buffer with them
+  bool has_positions_buffer =
+      std::any_of(geometry_buffers.begin(), geometry_buffers.end(),
+                  [](const Referenced<Buffer<float>> &buffer) {
+                    return has_positions(buffer->format());
+                  });
+  std::vector<glm::vec3> positions = positions_of(
+      data, geometry_buffer->format(), geometry_buffer->count());
+  add_geometry_buffer(std::move(geometry_buffer));
+  if (!has_positions_buffer && !positions.empty()) {
+    positions_ = std::move(positions);
+    triangles_.clear();
+    triangles_dirty_ = true;
+    fit_bounds(positions_);
+    bounds_changed();
+  }
+}
+void SimpleMesh::update_bounds() {
+  positions_ = read_positions();
+  triangles_.clear();
+  triangles_dirty_ = true;
+  fit_bounds(positions_);
+  bounds_changed();
+}
+void SimpleMesh::fit_bounds(const std::vector<glm::vec3> &positions) {
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  for (auto &position : positions) {
+    aabb_.expand(position);
+  }
+  if (aabb_.empty()) {
+    return;
+  }
+  glm::vec3 center = aabb_.center();
+  float radius_squared = 0.0f;
+  for (auto &position : positions) {
+    glm::vec3 offset_from_center = position - center;
+    radius_squared = std::max(
+        radius_squared, glm::dot(offset_from_center, offset_from_center));
+  }
+  sphere_ = {center, std::sqrt(radius_squared)};
+}
+std::vector<glm::vec3> SimpleMesh::read_positions() const {
+  for (auto &buffer : geometry_buffers) {
+    size_t stride = buffer->format().stride / sizeof(float);
+    uint32_t vertex_count = buffer->count();
+    if (!stride || !vertex_count || !has_positions(buffer->format())) {
+      continue;
+    }
+    std::vector<float> data(stride * vertex_count);
+    buffer->read(data.data(), 0, data.size() * sizeof(float));
+    return positions_of(data.data(), buffer->format(), vertex_count);
+  }
+  return {};
+}
+void SimpleMesh::update_triangles() {
+  triangles_.clear();
+  triangles_dirty_ = false;
+  if (draw_method_ != DrawMethod::TRIANGLES &&
+      draw_method_ != DrawMethod::TRIANGLE_STRIP &&
+      draw_method_ != DrawMethod::TRIANGLE_FAN) {
+    return;
+  }
+  if (positions_.empty()) {
+    positions_ = read_positions();
+  }
+  const std::vector<glm::vec3> &positions = positions_;
+  std::vector<uint32_t> indices(render_count());
+  if (index_buffer && indices_.size() == indices.size()) {
+    indices = indices_;
+  } else if (index_buffer) {
+    index_buffer->read(indices.data(), 0, indices.size() * sizeof(uint32_t));
+    indices_ = indices;
+  } else {
+    for (uint32_t i = 0; i < indices.size(); i++) {
+      indices[i] = i;
+    }
+  }
+  auto vertex = [&](size_t i) {
+    uint32_t index = indices[i];
+    return index < positions.size() ? positions[index] : glm::vec3(0.0f);
+  };
+  auto push = [&](size_t a, size_t b, size_t c) {
+    triangles_.push_back(vertex(a));
+    triangles_.push_back(vertex(b));
+    triangles_.push_back(vertex(c));
+  };
+  if (draw_method_ == DrawMethod::TRIANGLES) {
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+      push(i, i + 1, i + 2);
+    }
+  } else if (draw_method_ == DrawMethod::TRIANGLE_STRIP) {
+    for (size_t i = 0; i + 2 < indices.size(); i++) {
+      push(i, i + 1, i + 2);
+    }
+  } else {
+    for (size_t i = 1; i + 1 < indices.size(); i++) {
+      push(0, i, i + 1);
+    }
+  }
+}
+bool SimpleMesh::raycast(const Ray &ray, Transform *parent_transform,
+                         RayHit &hit) {
+  if (aabb_.empty()) {
+    return false;
+  }
+  glm::mat4 model = get_transformation_matrix();
+  if (parent_transform) {
+    model = parent_transform->get_transformation_matrix() * model;
+  }
+  // Intersect in model space, distances along an affinely transformed ray
+  // are the same as in world space
+  glm::mat4 inverse_model = glm::inverse(model);
+  glm::vec3 origin = glm::vec3(inverse_model * glm::vec4(ray.origin, 1.0f));
+  glm::vec3 direction =
+      glm::vec3(inverse_model * glm::vec4(ray.direction, 0.0f));
+  float max_distance = std::min(hit.distance, ray.length);
+  float distance;
+  if (!aabb_.intersects(origin, 1.0f / direction, max_distance, distance)) {
+    return false;
+  }
+  if (triangles_dirty_) {
+    update_triangles();
+  }
+  bool found = false;
+  for (size_t i = 0; i + 2 < triangles_.size(); i += 3) {
+    if (intersect_triangle(origin, direction, triangles_[i],
+                           triangles_[i + 1], triangles_[i + 2], distance) &&
+        distance < max_distance) {
+      max_distance = distance;
+      hit.triangle = static_cast<uint32_t>(i / 3);
+      found = true;
+    }
+  }
+  if (found) {
+    hit.mesh = this;
+    hit.distance = max_distance;
+    hit.position = ray.at(max_distance);
+  }
+  return found;
+}
 std::vector<Referenced<Buffer<float>>> SimpleMesh::get_geometry_buffers() {
   return geometry_buffers;
 }
 void SimpleMesh::set_index_buffer(Referenced<Buffer<uint32_t>> index_buffer) {
   Renderer::set_mesh_index_buffer(this, index_buffer);
+  indices_.clear();
+  triangles_dirty_ = true;
+}
+void SimpleMesh::set_index_buffer(Referenced<Buffer<uint32_t>> index_buffer,
+                                  const uint32_t *data) {
+  std::vector<uint32_t> indices(data, data + index_buffer->count());
+  set_index_buffer(std::move(index_buffer));
+  indices_ = std::move(indices);
 }
 Referenced<Buffer<uint32_t>> SimpleMesh::get_index_buffer() {
   return index_buffer;
@@ -48,7 +307,10 @@ void SimpleMesh::invalidate_render_state_cache() {
   render_states.clear();
 }
 bool SimpleMesh::is_indexed() const { return static_cast<bool>(index_buffer); }
-void SimpleMesh::set_draw_method(DrawMethod method) { draw_method_ = method; }
+void SimpleMesh::set_draw_method(DrawMethod method) {
+  draw_method_ = method;
+  triangles_dirty_ = true;
+}
 DrawMethod SimpleMesh::get_draw_method() { return draw_method_; }
 // swap the rendered buffer to the next buffer if vertex data is multibuffered
 void SimpleMesh::swap_buffers() {
@@ -57,8 +319,20 @@ void SimpleMesh::swap_buffers() {
   }
 }
 unsigned int SimpleMesh::get_render_index() {
-  return geometry_buffers[0]->buffer_index() *
-         static_cast<unsigned int>(vertex_render_count);
+  Buffer<float> *buffer = geometry_buffers[0].get();
+  unsigned int base_vertex = 0;
+  if (size_t offset = buffer->offset()) {
+    // Geometry Buffers in the GeometryHeap start at a whole vertex
+    base_vertex = static_cast<unsigned int>(offset / buffer->format().stride);
+  }
+  return base_vertex + buffer->buffer_index() *
+                           static_cast<unsigned int>(vertex_render_count);
+}
+unsigned int SimpleMesh::get_first_index() {
+  if (!index_buffer) {
+    return 0;
+  }
+  return static_cast<unsigned int>(index_buffer->offset() / sizeof(uint32_t));
 }
 void SimpleMesh::wait_buffers() {
   for (auto &buffer : geometry_buffers) {
@@ -103,11 +377,173 @@ void CompositeMesh::render(Camera *camera, Material *material,
 
 void CompositeMesh::push_mesh(Referenced<Mesh> mesh) {
   meshes_.push_back(mesh);
+  update_bounds();
+}
+
+void CompositeMesh::update_bounds() {
+  bounds_changed();
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  for (auto &mesh : meshes_) {
+    const AABB &bounds = mesh->get_aabb();
+    if (bounds.empty()) {
+      // a Mesh without bounds makes the whole CompositeMesh unbounded
+      aabb_ = AABB{};
+      return;
+    }
+    aabb_.expand(bounds.transformed(mesh->get_transformation_matrix()));
+  }
+  if (!aabb_.empty()) {
+    sphere_ = {aabb_.center(), glm::length(aabb_.extent())};
+  }
+}
+
+bool CompositeMesh::raycast(const Ray &ray, Transform *parent_transform,
+                            RayHit &hit) {
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform ? parent_transform->get_transformation_matrix() *
+                             get_transformation_matrix()
+                       : get_transformation_matrix());
+  bool found = false;
+  for (auto &mesh : meshes_) {
+    found = mesh->raycast(ray, &trans, hit) || found;
+  }
+  return found;
+}
+
+void CompositeMesh::pop_mesh() {
+  meshes_.pop_back();
+  update_bounds();
+}
+
+void CompositeMesh::clear() {
+  meshes_.clear();
+  update_bounds();
+}
+
+void LODMesh::render(Camera *camera, Material *material) {
+  if (Mesh *mesh = select(camera, get_transformation_matrix())) {
+    mesh->render(camera, material, this);
+  }
+}
+
+void LODMesh::render(Camera *camera, Material *material,
+                     Transform *parent_transform) {
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform->get_transformation_matrix() *
+      get_transformation_matrix());
+  if (Mesh *mesh = select(camera, trans.get_transformation_matrix())) {
+    mesh->render(camera, material, &trans);
+  }
 }
 
-void CompositeMesh::pop_mesh() { meshes_.pop_back(); }
+void LODMesh::render(Camera *camera, Material *material,
+                     Transform *parent_transform, unsigned int instance_count,
+                     Buffer<Transform> *models) {
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform->get_transformation_matrix() *
+      get_transformation_matrix());
+  if (Mesh *mesh = select(camera, trans.get_transformation_matrix())) {
+    mesh->render(camera, material, &trans, instance_count, models);
+  }
+}
 
-void CompositeMesh::clear() { meshes_.clear(); }
+void LODMesh::push_level(Referenced<Mesh> mesh, float screen_size) {
+  auto it = std::find_if(levels_.begin(), levels_.end(),
+                         [screen_size](const Level &level) {
+                           return level.screen_size < screen_size;
+                         });
+  levels_.insert(it, {mesh, screen_size});
+  // the level indices of the selections have changed
+  selections_.clear();
+  update_bounds();
+}
+
+void LODMesh::clear() {
+  levels_.clear();
+  selections_.clear();
+  update_bounds();
+}
+
+float LODMesh::get_screen_size(Camera *camera, const glm::mat4 &model) {
+  if (levels_.empty()) {
+    return 0.0f;
+  }
+  glm::mat4 projection = camera->get_projection();
+  return projected_size(projection * camera->get_view_matrix(),
+                        projection[1][1],
+                        levels_.front().mesh->get_bounding_sphere(), model);
+}
+
+size_t LODMesh::select_level(float screen_size, size_t current) const {
+  if (levels_.empty()) {
+    return 0;
+  }
+  size_t level = std::min(current, levels_.size() - 1);
+  // refine while the next finer threshold is exceeded by the margin
+  while (level > 0 &&
+         screen_size >= levels_[level - 1].screen_size * (1.0f + hysteresis_)) {
+    level--;
+  }
+  // coarsen while the current threshold is undercut by the margin
+  while (level + 1 < levels_.size() &&
+         screen_size < levels_[level].screen_size * (1.0f - hysteresis_)) {
+    level++;
+  }
+  return level;
+}
+
+Mesh *LODMesh::select(Camera *camera, const glm::mat4 &parent) {
+  if (levels_.empty()) {
+    return nullptr;
+  }
+  auto it = std::find_if(selections_.begin(), selections_.end(),
+                         [camera](const std::pair<const Camera *, size_t> &s) {
+                           return s.first == camera;
+                         });
+  if (it == selections_.end()) {
+    // start from the coarsest level so a new Camera refines straight away
+    selections_.push_back({camera, levels_.size() - 1});
+    it = selections_.end() - 1;
+  }
+  glm::mat4 model = parent * levels_.front().mesh->get_transformation_matrix();
+  it->second = select_level(get_screen_size(camera, model), it->second);
+  return levels_[it->second].mesh.get();
+}
+
+void LODMesh::update_bounds() {
+  bounds_changed();
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  for (auto &level : levels_) {
+    const AABB &bounds = level.mesh->get_aabb();
+    if (bounds.empty()) {
+      // a level without bounds makes the whole LODMesh unbounded
+      aabb_ = AABB{};
+      return;
+    }
+    aabb_.expand(bounds.transformed(level.mesh->get_transformation_matrix()));
+  }
+  if (!aabb_.empty()) {
+    sphere_ = {aabb_.center(), glm::length(aabb_.extent())};
+  }
+}
+
+bool LODMesh::raycast(const Ray &ray, Transform *parent_transform,
+                      RayHit &hit) {
+  if (levels_.empty()) {
+    return false;
+  }
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform ? parent_transform->get_transformation_matrix() *
+                             get_transformation_matrix()
+                       : get_transformation_matrix());
+  return levels_.front().mesh->raycast(ray, &trans, hit);
+}
 
 InstancedMesh::InstancedMesh(unsigned int max_instances)
     : instance_count_(0), instance_transforms_(nullptr), mesh_(nullptr),
@@ -116,23 +552,170 @@ InstancedMesh::InstancedMesh(unsigned int max_instances)
       nullptr, max_instances * sizeof(Transform), BufferType::READ_WRITE);
 }
 
-void InstancedMesh::set_mesh(Referenced<Mesh> mesh) { mesh_ = mesh; }
+void InstancedMesh::set_mesh(Referenced<Mesh> mesh) {
+  mesh_ = mesh;
+  lod_mesh_ = dynamic_cast<LODMesh *>(mesh_.get());
+  level_instances_.clear();
+  update_bounds();
+}
 
 void InstancedMesh::push_instance(Transform model) {
   (*instance_transforms_)[instance_count_] = model;
   instance_count_++;
+  expand_bounds(&model, 1);
+  bounds_changed();
 }
 
-void InstancedMesh::pop_instance() { instance_count_--; }
+void InstancedMesh::push_instances(const glm::vec3 *positions,
+                                   const glm::quat *rotations,
+                                   const glm::vec3 *scales, uint32_t count) {
+  assert(instance_count_ + count <= max_instances_);
+  flush_instances(positions, rotations, scales, instance_count_, count);
+  instance_count_ += count;
+}
 
-void InstancedMesh::clear_instances() { instance_count_ = 0; }
+void InstancedMesh::pop_instance() {
+  instance_count_--;
+  bounds_dirty_ = true;
+  bounds_changed();
+}
+
+void InstancedMesh::clear_instances() {
+  instance_count_ = 0;
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  bounds_dirty_ = false;
+  bounds_changed();
+}
 
 void InstancedMesh::flush_instances(Transform *models, uint32_t offset,
                                     uint32_t count) {
   instance_transforms_->flush(models, offset, count * sizeof(Transform));
+  expand_bounds(models, count);
+  bounds_changed();
+}
+
+void InstancedMesh::flush_instances(const glm::vec3 *positions,
+                                    const glm::quat *rotations,
+                                    const glm::vec3 *scales, uint32_t offset,
+                                    uint32_t count) {
+  static_assert(sizeof(Transform) == sizeof(glm::mat4),
+                "Transform must be a single matrix");
+  constexpr uint32_t batch_size = 256;
+  glm::mat4 models[batch_size];
+  for (uint32_t begin = 0; begin < count; begin += batch_size) {
+    uint32_t size = std::min(batch_size, count - begin);
+    batch::compose(positions + begin, rotations + begin, scales + begin,
+                   models, size);
+    flush_instances(reinterpret_cast<Transform *>(models), offset + begin,
+                    size);
+  }
+}
+
+const AABB &InstancedMesh::get_aabb() {
+  if (bounds_dirty_) {
+    update_bounds();
+  }
+  return aabb_;
+}
+
+const BoundingSphere &InstancedMesh::get_bounding_sphere() {
+  if (bounds_dirty_) {
+    update_bounds();
+  }
+  return sphere_;
+}
+
+void InstancedMesh::update_bounds() {
+  bounds_changed();
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  bounds_dirty_ = false;
+  if (!instance_count_) {
+    return;
+  }
+  std::vector<Transform> models(instance_count_);
+  instance_transforms_->read(models.data(), 0,
+                             instance_count_ * sizeof(Transform));
+  expand_bounds(models.data(), instance_count_);
+}
+
+void InstancedMesh::expand_bounds(Transform *models, uint32_t count) {
+  if (!mesh_ || !count) {
+    return;
+  }
+  const AABB &bounds = mesh_->get_aabb();
+  if (bounds.empty()) {
+    return;
+  }
+  // Each instance is drawn with the instanced Mesh's Transform times the
+  // instance Transform, transform the bounds in batches of that product
+  constexpr uint32_t batch_size = 256;
+  glm::mat4 matrices[batch_size];
+  glm::vec3 mins[batch_size];
+  glm::vec3 maxs[batch_size];
+  std::fill(mins, mins + batch_size, bounds.min);
+  std::fill(maxs, maxs + batch_size, bounds.max);
+  glm::mat4 mesh_matrix = mesh_->get_transformation_matrix();
+  for (uint32_t begin = 0; begin < count; begin += batch_size) {
+    uint32_t size = std::min(batch_size, count - begin);
+    batch::multiply(mesh_matrix,
+                    reinterpret_cast<const glm::mat4 *>(models + begin),
+                    matrices, size);
+    batch::transform_aabbs(matrices, mins, maxs, mins, maxs, size);
+    for (uint32_t i = 0; i < size; i++) {
+      aabb_.expand(mins[i]);
+      aabb_.expand(maxs[i]);
+    }
+    std::fill(mins, mins + size, bounds.min);
+    std::fill(maxs, maxs + size, bounds.max);
+  }
+  sphere_ = {aabb_.center(), glm::length(aabb_.extent())};
+}
+
+bool InstancedMesh::raycast(const Ray &ray, Transform *parent_transform,
+                            RayHit &hit) {
+  if (!mesh_ || !instance_count_) {
+    return false;
+  }
+  glm::mat4 model = get_transformation_matrix();
+  if (parent_transform) {
+    model = parent_transform->get_transformation_matrix() * model;
+  }
+  // Instances are drawn with model * mesh * instance, pass the instanced Mesh
+  // the parent that gives the same product with its own Transform
+  glm::mat4 mesh_matrix = mesh_->get_transformation_matrix();
+  glm::mat4 inverse_mesh_matrix = glm::inverse(mesh_matrix);
+  const AABB &bounds = mesh_->get_aabb();
+  glm::vec3 inverse_direction = 1.0f / ray.direction;
+  constexpr uint32_t batch_size = 256;
+  Transform models[batch_size];
+  bool found = false;
+  for (uint32_t begin = 0; begin < instance_count_; begin += batch_size) {
+    uint32_t size = std::min(batch_size, instance_count_ - begin);
+    instance_transforms_->read(models, begin, size * sizeof(Transform));
+    for (uint32_t i = 0; i < size; i++) {
+      glm::mat4 instance =
+          model * mesh_matrix * models[i].get_transformation_matrix();
+      float distance;
+      if (!bounds.empty() &&
+          !bounds.transformed(instance).intersects(
+              ray.origin, inverse_direction,
+              std::min(hit.distance, ray.length), distance)) {
+        continue;
+      }
+      Transform trans{};
+      trans.set_transformation_matrix(instance * inverse_mesh_matrix);
+      found = mesh_->raycast(ray, &trans, hit) || found;
+    }
+  }
+  return found;
 }
 
 Transform &InstancedMesh::operator[](unsigned int i) {
+  // the Transform may be written through the reference
+  bounds_dirty_ = true;
+  bounds_changed();
   return (*instance_transforms_)[i];
 }
 
@@ -141,6 +724,10 @@ Transform InstancedMesh::operator[](unsigned int i) const {
 }
 
 void InstancedMesh::render(Camera *camera, Material *material) {
+  if (lod_mesh_) {
+    render_levels(camera, material, this);
+    return;
+  }
   mesh_->render(camera, material, this, instance_count_,
                 instance_transforms_.get());
 }
@@ -151,10 +738,86 @@ void InstancedMesh::render(Camera *camera, Material *material,
   trans.set_transformation_matrix(
       parent_transform->get_transformation_matrix() *
       get_transformation_matrix());
+  if (lod_mesh_) {
+    render_levels(camera, material, &trans);
+    return;
+  }
   mesh_->render(camera, material, &trans, instance_count_,
                 instance_transforms_.get());
 }
 
+void InstancedMesh::render_levels(Camera *camera, Material *material,
+                                  Transform *parent_transform) {
+  size_t level_count = lod_mesh_->get_level_count();
+  if (!level_count || !instance_count_) {
+    return;
+  }
+  auto it = std::find_if(
+      level_instances_.begin(), level_instances_.end(),
+      [camera](const LevelInstances &lods) { return lods.camera == camera; });
+  if (it == level_instances_.end()) {
+    level_instances_.push_back({camera, {}, {}, {}});
+    it = level_instances_.end() - 1;
+  }
+  LevelInstances &lods = *it;
+  // the level of each instance is only kept while the instances stay the
+  // same, otherwise they restart at the coarsest level and refine straight away
+  if (lods.levels.size() != instance_count_) {
+    lods.levels.assign(instance_count_, uint8_t(level_count - 1));
+  }
+  lods.models.resize(level_count);
+  lods.sorted.resize(level_count);
+  for (auto &sorted : lods.sorted) {
+    sorted.clear();
+  }
+
+  // Each level is drawn with parent * LODMesh * level * instance, the screen
+  // size is measured on the finest level
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform->get_transformation_matrix() *
+      lod_mesh_->get_transformation_matrix());
+  Mesh *finest = lod_mesh_->get_level(0);
+  glm::mat4 model =
+      trans.get_transformation_matrix() * finest->get_transformation_matrix();
+  const BoundingSphere &sphere = finest->get_bounding_sphere();
+  glm::mat4 projection = camera->get_projection();
+  glm::mat4 view_projection = projection * camera->get_view_matrix();
+
+  // Sort the instances into the Transform Buffer of their level
+  constexpr uint32_t batch_size = 256;
+  Transform models[batch_size];
+  for (uint32_t begin = 0; begin < instance_count_; begin += batch_size) {
+    uint32_t size = std::min(batch_size, instance_count_ - begin);
+    instance_transforms_->read(models, begin, size * sizeof(Transform));
+    for (uint32_t i = 0; i < size; i++) {
+      float screen_size =
+          projected_size(view_projection, projection[1][1], sphere,
+                         model * models[i].get_transformation_matrix());
+      uint8_t &level = lods.levels[begin + i];
+      level = uint8_t(lod_mesh_->select_level(screen_size, level));
+      lods.sorted[level].push_back(models[i]);
+    }
+  }
+  // Upload each level in one call, the Buffers are not mapped so this never
+  // overwrites instances the GPU is still drawing from
+  for (size_t level = 0; level < level_count; level++) {
+    std::vector<Transform> &sorted = lods.sorted[level];
+    if (sorted.empty()) {
+      continue;
+    }
+    Referenced<Buffer<Transform>> &level_models = lods.models[level];
+    if (!level_models) {
+      level_models = Renderer::gen_buffer<Transform>(
+          nullptr, max_instances_ * sizeof(Transform), BufferType::DYNAMIC);
+    }
+    level_models->flush(sorted.data(), 0, sorted.size() * sizeof(Transform));
+    lod_mesh_->get_level(level)->render(camera, material, &trans,
+                                        static_cast<uint32_t>(sorted.size()),
+                                        level_models.get());
+  }
+}
+
 void InstancedMesh::render(Camera *camera, Material *material,
                            Transform *parent_transform,
                            unsigned int instance_count,
@@ -169,21 +832,245 @@ void InstancedMesh::render(Camera *camera, Material *material,
 }
 
 Buffer<Transform> *InstancedMesh::get_instance_models() {
+  bounds_dirty_ = true;
+  bounds_changed();
   return instance_transforms_.get();
 }
 
 Referenced<Buffer<Transform>>
 InstancedMesh::swap_instance_models(Referenced<Buffer<Transform>> models) {
   models.swap(instance_transforms_);
+  level_instances_.clear();
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  bounds_dirty_ = false;
+  bounds_changed();
   return models;
 }
 
 void InstancedMesh::set_instance_models(Referenced<Buffer<Transform>> models) {
   instance_transforms_ = models;
+  level_instances_.clear();
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  bounds_dirty_ = false;
+  bounds_changed();
 }
 
 void InstancedMesh::set_instance_render_count(unsigned int count) {
   instance_count_ = std::min(max_instances_, count);
+  update_bounds();
+}
+
+void BatchedMesh::render(Camera *camera, Material *material) {
+  render(camera, material, nullptr);
+}
+
+void BatchedMesh::render(Camera *camera, Material *material,
+                         Transform *parent_transform) {
+  if (meshes_.empty()) {
+    return;
+  }
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform ? parent_transform->get_transformation_matrix() *
+                             get_transformation_matrix()
+                       : get_transformation_matrix());
+  if (!material->is_batched()) {
+    for (auto &mesh : meshes_) {
+      mesh->render(camera, material, &trans);
+    }
+    return;
+  }
+  if (dirty_) {
+    build();
+  }
+  Renderer::render_simple_mesh_indirect(
+      camera, &packed_, material, &trans, commands_.get(),
+      static_cast<unsigned int>(meshes_.size()), models_.get());
+}
+
+void BatchedMesh::render(Camera *camera, Material *material,
+                         Transform *parent_transform,
+                         unsigned int instance_count,
+                         Buffer<Transform> *models) {
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform ? parent_transform->get_transformation_matrix() *
+                             get_transformation_matrix()
+                       : get_transformation_matrix());
+  for (auto &mesh : meshes_) {
+    mesh->render(camera, material, &trans, instance_count, models);
+  }
+}
+
+bool BatchedMesh::push_mesh(Referenced<SimpleMesh> mesh) {
+  auto single_buffered = [](IBuffer *buffer) {
+    BufferType type = buffer->type();
+    return type == BufferType::STATIC || type == BufferType::READ_ONLY ||
+           type == BufferType::WRITE_ONLY || type == BufferType::READ_WRITE;
+  };
+  auto batchable = [&](SimpleMesh *mesh, SimpleMesh *first) {
+    if (mesh->geometry_buffers.empty() ||
+        (mesh->index_buffer && !single_buffered(mesh->index_buffer.get()))) {
+      return false;
+    }
+    for (auto &buffer : mesh->geometry_buffers) {
+      if (!single_buffered(buffer.get())) {
+        return false;
+      }
+    }
+    if (!first) {
+      return true;
+    }
+    if (mesh->get_draw_method() != first->get_draw_method() ||
+        mesh->geometry_buffers.size() != first->geometry_buffers.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < mesh->geometry_buffers.size(); i++) {
+      const BufferFormat &format = mesh->geometry_buffers[i]->format();
+      const BufferFormat &other = first->geometry_buffers[i]->format();
+      if (format.stride != other.stride ||
+          !std::equal(format.begin(), format.end(), other.begin(), other.end(),
+                      [](const BufferAttibrute &a, const BufferAttibrute &b) {
+                        return a.type == b.type && a.name == b.name;
+                      })) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!mesh ||
+      !batchable(mesh.get(), meshes_.empty() ? nullptr : meshes_[0].get())) {
+    return false;
+  }
+  meshes_.push_back(mesh);
+  dirty_ = true;
+  bounds_changed();
+  return true;
+}
+
+void BatchedMesh::clear() {
+  meshes_.clear();
+  packed_.invalidate_render_state_cache();
+  packed_.geometry_buffers.clear();
+  packed_.index_buffer = nullptr;
+  commands_ = nullptr;
+  models_ = nullptr;
+  dirty_ = false;
+  bounds_changed();
+}
+
+void BatchedMesh::update_transforms() {
+  bounds_changed();
+  if (dirty_ || !models_) {
+    // the Transforms are written when the batch is rebuilt
+    return;
+  }
+  std::vector<Transform> models(meshes_.size());
+  for (size_t i = 0; i < meshes_.size(); i++) {
+    models[i].set_transformation_matrix(
+        meshes_[i]->get_transformation_matrix());
+  }
+  models_->flush(models.data(), 0, models.size() * sizeof(Transform));
+}
+
+const AABB &BatchedMesh::get_aabb() {
+  update_bounds();
+  return aabb_;
+}
+
+const BoundingSphere &BatchedMesh::get_bounding_sphere() {
+  update_bounds();
+  return sphere_;
+}
+
+void BatchedMesh::update_bounds() {
+  aabb_ = AABB{};
+  sphere_ = BoundingSphere{};
+  for (auto &mesh : meshes_) {
+    const AABB &bounds = mesh->get_aabb();
+    if (bounds.empty()) {
+      // a Mesh without bounds makes the whole batch unbounded
+      aabb_ = AABB{};
+      return;
+    }
+    aabb_.expand(bounds.transformed(mesh->get_transformation_matrix()));
+  }
+  if (!aabb_.empty()) {
+    sphere_ = {aabb_.center(), glm::length(aabb_.extent())};
+  }
+}
+
+bool BatchedMesh::raycast(const Ray &ray, Transform *parent_transform,
+                          RayHit &hit) {
+  Transform trans{};
+  trans.set_transformation_matrix(
+      parent_transform ? parent_transform->get_transformation_matrix() *
+                             get_transformation_matrix()
+                       : get_transformation_matrix());
+  bool found = false;
+  for (auto &mesh : meshes_) {
+    found = mesh->raycast(ray, &trans, hit) || found;
+  }
+  return found;
+}
+
+void BatchedMesh::build() {
+  dirty_ = false;
+  packed_.invalidate_render_state_cache();
+  packed_.geometry_buffers.clear();
+  SimpleMesh *first = meshes_.front().get();
+  std::vector<std::vector<float>> vertices(first->geometry_buffers.size());
+  std::vector<uint32_t> indices{};
+  std::vector<DrawCommand> commands{};
+  commands.reserve(meshes_.size());
+  uint32_t vertex_count = 0;
+  for (size_t draw = 0; draw < meshes_.size(); draw++) {
+    SimpleMesh *mesh = meshes_[draw].get();
+    uint32_t mesh_vertices = mesh->geometry_buffers.front()->count();
+    for (size_t i = 0; i < vertices.size(); i++) {
+      auto &buffer = mesh->geometry_buffers[i];
+      size_t size = size_t(buffer->count()) * buffer->format().stride;
+      size_t offset = vertices[i].size();
+      vertices[i].resize(offset + size / sizeof(float));
+      buffer->read(vertices[i].data() + offset, 0, size);
+    }
+    uint32_t first_index = static_cast<uint32_t>(indices.size());
+    if (mesh->index_buffer) {
+      uint32_t count = mesh->index_buffer->count();
+      indices.resize(first_index + count);
+      mesh->index_buffer->read(indices.data() + first_index, 0,
+                               count * sizeof(uint32_t));
+    } else {
+      for (uint32_t i = 0; i < mesh_vertices; i++) {
+        indices.push_back(i);
+      }
+    }
+    // base_instance is not used by the batched shaders, it records the draw
+    commands.push_back({static_cast<uint32_t>(indices.size()) - first_index, 1,
+                        first_index, static_cast<int32_t>(vertex_count),
+                        static_cast<uint32_t>(draw)});
+    vertex_count += mesh_vertices;
+  }
+  packed_.set_draw_method(first->get_draw_method());
+  // the DrawCommands are relative to the start of the packed Buffers
+  packed_.use_geometry_heap = false;
+  for (size_t i = 0; i < vertices.size(); i++) {
+    Referenced<Buffer<float>> buffer = Renderer::gen_buffer<float>(
+        vertices[i].data(), vertices[i].size() * sizeof(float));
+    buffer->set_format(first->geometry_buffers[i]->format());
+    // pushed directly, the bounds come from the batched SimpleMeshes
+    Renderer::push_mesh_geometry_buffer(&packed_, buffer);
+  }
+  Renderer::set_mesh_index_buffer(
+      &packed_, Renderer::gen_buffer<uint32_t>(
+                    indices.data(), indices.size() * sizeof(uint32_t)));
+  commands_ = Renderer::gen_buffer<DrawCommand>(
+      commands.data(), commands.size() * sizeof(DrawCommand));
+  models_ = Renderer::gen_buffer<Transform>(
+      nullptr, meshes_.size() * sizeof(Transform), BufferType::READ_WRITE);
+  update_transforms();
 }
 
 } // namespace mare
\ No newline at end of file
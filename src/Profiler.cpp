@@ -0,0 +1,89 @@
+// MARE
+#include "Profiler.hpp"
+
+// Standard Library
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace mare {
+// Static variables
+std::atomic<uint64_t> Profiler::write_index_{0}; // total events recorded
+GpuTimer *Profiler::gpu_timer_{nullptr};         // the GPU timer
+bool Profiler::gpu_timing_{false};               // GPU timing enabled?
+
+uint64_t Profiler::now() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - epoch)
+          .count());
+}
+
+uint32_t Profiler::thread_id() {
+  static std::atomic<uint32_t> next_id{0};
+  thread_local uint32_t id = next_id++;
+  return id;
+}
+
+ProfileEvent *Profiler::ring() {
+  static Scoped<ProfileEvent[]> ring_buffer(new ProfileEvent[capacity]);
+  return ring_buffer.get();
+}
+
+void Profiler::record(const char *name, uint64_t start, uint64_t duration,
+                      uint32_t thread) {
+  // Each writer claims its own slot so no lock is needed
+  uint64_t index = write_index_.fetch_add(1, std::memory_order_relaxed);
+  ring()[index % capacity] = {name, start, duration, thread};
+}
+
+void Profiler::clear() { write_index_ = 0; }
+
+std::vector<ProfileEvent> Profiler::events() {
+  std::vector<ProfileEvent> result{};
+  uint64_t end = write_index_.load();
+  if (end == 0) {
+    return result;
+  }
+  ProfileEvent *ring_buffer = ring();
+  uint64_t begin = end > capacity ? end - capacity : 0;
+  result.reserve(static_cast<size_t>(end - begin));
+  for (uint64_t i = begin; i < end; i++) {
+    result.push_back(ring_buffer[i % capacity]);
+  }
+  return result;
+}
+
+bool Profiler::write_chrome_trace(const char *filepath) {
+  std::ofstream file(filepath);
+  if (!file) {
+    std::cerr << "PROFILER ERROR: Could not open " << filepath << std::endl;
+    return false;
+  }
+  file << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto &event : events()) {
+    if (!event.name) {
+      continue;
+    }
+    file << (first ? "\n" : ",\n");
+    first = false;
+    file << "{\"name\":\"";
+    for (const char *c = event.name; *c; c++) {
+      if (*c == '"' || *c == '\\') {
+        file << '\\';
+      }
+      file << *c;
+    }
+    // Chrome trace timestamps are in microseconds
+    file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+         << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+         << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+         << "}";
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return static_cast<bool>(file);
+}
+
+} // namespace mare
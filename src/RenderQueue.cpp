@@ -0,0 +1,202 @@
+// MARE
+#include "RenderQueue.hpp"
+#include "Entities/Camera.hpp"
+#include "Meshes.hpp"
+#include "Renderer.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cstring>
+
+namespace mare {
+namespace {
+// The order of the draws within a pass, in the two bits below the pass
+constexpr uint64_t OPAQUE_DRAWS = 0;
+constexpr uint64_t BLENDED_DRAWS = 1;
+constexpr uint64_t ORDERED_DRAWS = 2;
+
+// The bits of a non negative float increase with its value
+uint32_t depth_bits(float depth) {
+  depth = std::max(depth, 0.0f);
+  uint32_t bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return bits;
+}
+
+void set_render_state(const RenderState &state, const RenderState &current) {
+  if (state.depth_testing != current.depth_testing) {
+    Renderer::enable_depth_testing(state.depth_testing);
+  }
+  if (state.face_culling != current.face_culling) {
+    Renderer::enable_face_culling(state.face_culling);
+  }
+  if (state.blending != current.blending) {
+    Renderer::enable_blending(state.blending);
+  }
+}
+} // namespace
+
+void RenderQueue::push(Camera *camera, SimpleMesh *mesh, Material *material,
+                       Transform *parent_transform, unsigned int instance_count,
+                       Buffer<Transform> *models,
+                       Buffer<DrawCommand> *commands) {
+  glm::mat4 model = mesh->get_transformation_matrix();
+  if (parent_transform) {
+    model = parent_transform->get_transformation_matrix() * model;
+  }
+  const BoundingSphere &sphere = mesh->get_bounding_sphere();
+  glm::vec3 center = sphere.empty() ? glm::vec3(0.0f) : sphere.center;
+  float depth =
+      -(camera->get_view_matrix() * model * glm::vec4(center, 1.0f)).z;
+  auto render_state = mesh->render_states.find(material->name());
+  uint32_t vertex_array =
+      render_state != mesh->render_states.end() ? render_state->second : 0;
+  uint32_t material_index =
+      materials_.emplace(material, uint32_t(materials_.size())).first->second;
+  RenderState state = Renderer::get_render_state();
+  uint32_t sequence = static_cast<uint32_t>(items_.size());
+  uint64_t key;
+  if (!state.depth_testing) {
+    key = make_ordered_key(pass_, sequence);
+  } else if (state.blending) {
+    key = make_blended_key(pass_, depth, sequence);
+  } else {
+    key = make_key(pass_, material->name(), vertex_array, material_index,
+                   depth);
+  }
+  RenderItem item{key,
+                  state,
+                  camera,
+                  mesh,
+                  material,
+                  Transform{},
+                  parent_transform != nullptr,
+                  instance_count,
+                  models,
+                  commands};
+  if (parent_transform) {
+    item.parent_transform.set_transformation_matrix(
+        parent_transform->get_transformation_matrix());
+  }
+  items_.push_back(item);
+}
+
+void RenderQueue::submit() {
+  sort();
+  const RenderState before = Renderer::get_render_state();
+  RenderState state = before;
+  Camera *camera = nullptr;
+  SimpleMesh *mesh = nullptr;
+  Material *material = nullptr;
+  uint32_t program = 0;
+  for (uint32_t index : order_) {
+    RenderItem &item = items_[index];
+    set_render_state(item.state, state);
+    state = item.state;
+    // the uniforms of a program survive switching away from it, but a
+    // Material only uploads its own values in render()
+    bool program_changed = !material || item.material->name() != program;
+    if (program_changed) {
+      item.material->bind();
+      program = item.material->name();
+    }
+    // the camera block is shared by every program
+    if (item.camera != camera) {
+      item.material->upload_camera(item.camera);
+      camera = item.camera;
+    }
+    if (program_changed || item.mesh != mesh) {
+      item.mesh->bind(item.material);
+      mesh = item.mesh;
+    }
+    Transform *parent = item.has_parent ? &item.parent_transform : nullptr;
+    if (item.instance_count) {
+      item.material->upload_mesh(item.mesh, parent, item.models, true);
+    } else if (parent) {
+      item.material->upload_mesh(item.mesh, parent, true);
+    } else {
+      item.material->upload_mesh(item.mesh, true);
+    }
+    if (program_changed || item.material != material) {
+      item.material->render();
+      material = item.material;
+    }
+    if (item.commands) {
+      Renderer::draw_simple_mesh_indirect(item.mesh, item.material,
+                                          item.commands, item.instance_count);
+    } else {
+      Renderer::draw_simple_mesh(item.mesh, item.material,
+                                 item.instance_count);
+    }
+  }
+  set_render_state(before, state);
+  clear();
+}
+
+void RenderQueue::clear() {
+  items_.clear();
+  order_.clear();
+  materials_.clear();
+  pass_ = 0;
+}
+
+uint64_t RenderQueue::make_key(uint8_t pass, uint32_t program,
+                               uint32_t vertex_array, uint32_t material,
+                               float depth) {
+  return (uint64_t(pass & 0xF) << 60) | (OPAQUE_DRAWS << 58) |
+         (uint64_t(program & 0xFFF) << 46) |
+         (uint64_t(vertex_array & 0xFFFF) << 30) |
+         (uint64_t(material & 0x3FFF) << 16) |
+         uint64_t(depth_bits(depth) >> 16);
+}
+
+uint64_t RenderQueue::make_blended_key(uint8_t pass, float depth,
+                                       uint32_t sequence) {
+  // inverting the depth draws the farthest first
+  return (uint64_t(pass & 0xF) << 60) | (BLENDED_DRAWS << 58) |
+         (uint64_t(~depth_bits(depth)) << 26) |
+         uint64_t(sequence & 0x3FFFFFF);
+}
+
+uint64_t RenderQueue::make_ordered_key(uint8_t pass, uint32_t sequence) {
+  return (uint64_t(pass & 0xF) << 60) | (ORDERED_DRAWS << 58) |
+         uint64_t(sequence);
+}
+
+void RenderQueue::sort() {
+  size_t count = items_.size();
+  order_.resize(count);
+  scratch_.resize(count);
+  for (uint32_t i = 0; i < count; i++) {
+    order_[i] = i;
+  }
+  // Least significant digit first, one byte per pass. The histograms of every
+  // byte are counted in a single sweep and bytes shared by every key are
+  // skipped.
+  constexpr int digits = sizeof(uint64_t);
+  static uint32_t histograms[digits][256];
+  std::memset(histograms, 0, sizeof(histograms));
+  for (auto &item : items_) {
+    for (int d = 0; d < digits; d++) {
+      histograms[d][(item.key >> (8 * d)) & 0xFF]++;
+    }
+  }
+  for (int d = 0; d < digits; d++) {
+    uint32_t *histogram = histograms[d];
+    if (histogram[(items_.front().key >> (8 * d)) & 0xFF] == count) {
+      continue;
+    }
+    uint32_t offset = 0;
+    for (int b = 0; b < 256; b++) {
+      uint32_t bucket = histogram[b];
+      histogram[b] = offset;
+      offset += bucket;
+    }
+    for (uint32_t index : order_) {
+      scratch_[histogram[(items_[index].key >> (8 * d)) & 0xFF]++] = index;
+    }
+    order_.swap(scratch_);
+  }
+}
+
+} // namespace mare
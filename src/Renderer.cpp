@@ -1,5 +1,17 @@
+#include "Commands.hpp"
+#include "Components/RenderPack.hpp"
+#include "Components/Rigidbody.hpp"
+#include "Components/Widget.hpp"
+#include "Materials/EntityIDMaterial.hpp"
+#include "Meshes.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
 #include "Scene.hpp"
+#include "Systems.hpp"
+
+// Standard Library
+#include <algorithm>
+#include <cmath>
 
 namespace mare {
 // Static variables
@@ -9,11 +21,637 @@ RendererInput
 bool Renderer::running{false};                      // Program is running?
 Renderer *Renderer::API{nullptr};                   // The implemented API
 std::vector<Referenced<Scene>> Renderer::scenes_{}; // the scene stack
+TypeIndex<Scene> Renderer::scene_index_{};          // typed scene views
+Scoped<JobSystem> Renderer::jobs_{nullptr};         // the job system
+double Renderer::physics_accumulator_{0.0};         // unsimulated time
+uint64_t Renderer::frame_{0};                       // frames rendered
+Referenced<GeometryHeap> Renderer::geometry_heap_{nullptr}; // static geometry
+std::vector<std::pair<IPhysicsSystem *, Entity *>>
+    Renderer::parallel_physics_{}; // thread safe physics updates
+std::vector<std::pair<IPhysicsSystem *, Entity *>>
+    Renderer::serial_physics_{}; // serial physics updates
+bool Renderer::structure_dirty_{false}; // anything pulled since last sync?
+std::vector<Renderer::PixelRequests>
+    Renderer::readback_requests_{}; // pixels requested since the last flush
+std::deque<std::vector<Renderer::PixelRequests>>
+    Renderer::readbacks_in_flight_{};                 // flushed batches
+std::vector<glm::ivec2> Renderer::readback_pixels_{}; // scratch pixels
+std::vector<float> Renderer::readback_depths_{};      // scratch depths
+std::array<std::vector<PickTarget>, Renderer::id_tables>
+    Renderer::id_tables_{};            // packets of the last ID passes
+uint64_t Renderer::id_frame_{0};       // ID passes drawn
+uint64_t Renderer::id_valid_frame_{0}; // first ID pass without pulls
+Scoped<Framebuffer> Renderer::id_framebuffer_{nullptr};   // ID pass target
+glm::ivec2 Renderer::id_framebuffer_size_{0};             // size of target
+Scoped<EntityIDMaterial> Renderer::id_material_{nullptr}; // draws the IDs
+std::vector<Renderer::IDRequest>
+    Renderer::id_requests_{}; // rectangles requested since the last flush
+std::deque<Renderer::IDBatch> Renderer::ids_in_flight_{}; // flushed batches
+std::vector<PixelRect> Renderer::id_rects_{};             // scratch rects
+std::vector<uint32_t> Renderer::id_values_{};             // scratch IDs
+RenderQueue Renderer::queue_{};         // draws of the current layer
+bool Renderer::queue_recording_{false}; // push draws to the queue?
+bool Renderer::queue_enabled_{false};   // layer uses the queue?
+RenderState Renderer::render_state_{};  // state set through the renderer
 
 // Static methods
 void Renderer::end_renderer() { running = false; }
 RendererInfo &Renderer::get_info() { return info; }
 RendererInput &Renderer::get_input() { return input; }
+CommandBuffer &Renderer::commands() {
+  static CommandBuffer buffer{};
+  return buffer;
+}
+bool Renderer::cull_packet(Camera *camera, Mesh *mesh,
+                           Transform *parent_transform) {
+  if (info.frustum_culling && camera &&
+      !mesh->intersects(camera->get_frustum(), parent_transform)) {
+    info.packets_culled++;
+    return true;
+  }
+  info.packets_drawn++;
+  return false;
+}
+void Renderer::submit(Camera *camera, Mesh *mesh, Material *material,
+                      Transform *parent_transform, uint8_t pass) {
+  if (!info.render_queue || !queue_enabled_) {
+    mesh->render(camera, material, parent_transform);
+    return;
+  }
+  queue_.set_pass(pass);
+  queue_recording_ = true;
+  mesh->render(camera, material, parent_transform);
+  queue_recording_ = false;
+}
+void Renderer::flush_render_queue() {
+  if (queue_.empty()) {
+    return;
+  }
+  MARE_PROFILE_SCOPE("Render Queue");
+  queue_.submit();
+}
+void Renderer::push_mesh_geometry_buffer(
+    SimpleMesh *mesh, Referenced<Buffer<float>> geometry_buffer) {
+  if (geometry_heap_ && mesh->geometry_buffers.size() == 1 &&
+      geometry_heap_->contains(*mesh->geometry_buffers.front())) {
+    Referenced<Buffer<float>> &stored = mesh->geometry_buffers.front();
+    std::vector<float> data(stored->size() / sizeof(float));
+    stored->read(data.data(), 0, stored->size());
+    Referenced<Buffer<float>> buffer =
+        gen_buffer<float>(data.data(), stored->size());
+    buffer->set_format(stored->format());
+    stored = buffer;
+  }
+  API->api_push_mesh_geometry_buffer(mesh, geometry_buffer);
+}
+void Renderer::store_mesh_geometry(SimpleMesh *mesh) {
+  GeometryHeap *heap = get_geometry_heap();
+  if (!heap) {
+    return;
+  }
+  if (mesh->geometry_buffers.size() == 1) {
+    Referenced<Buffer<float>> &buffer = mesh->geometry_buffers.front();
+    size_t stride = buffer->format().stride;
+    if (buffer->type() == BufferType::STATIC && stride &&
+        !heap->contains(*buffer)) {
+      // aligned to the stride so the offset is a whole base vertex
+      buffer = heap->store(*buffer, stride);
+    }
+  }
+  Referenced<Buffer<uint32_t>> &indices = mesh->index_buffer;
+  if (indices && indices->type() == BufferType::STATIC &&
+      !heap->contains(*indices)) {
+    indices = heap->store(*indices, sizeof(uint32_t));
+  }
+}
+GeometryHeap *Renderer::get_geometry_heap() {
+  if (!geometry_heap_ && info.geometry_heap_page_size) {
+    switch (info.API) {
+    case RendererAPI::OpenGL_4_5:
+      geometry_heap_ = gen_ref<GLGeometryHeap>(info.geometry_heap_page_size);
+      break;
+    case RendererAPI::Headless:
+      geometry_heap_ = gen_ref<HostGeometryHeap>(info.geometry_heap_page_size);
+      break;
+    default:
+      break;
+    }
+  }
+  return geometry_heap_.get();
+}
+void Renderer::bind_camera(Camera *camera) {
+  API->api_bind_uniform_buffer(Shader::camera_binding,
+                               camera->get_properties(frame_));
+}
+Referenced<const PixelReadback>
+Renderer::raycast_async(Camera *camera, glm::ivec2 screen_coords,
+                        ReadbackCallback callback) {
+  auto result = gen_ref<PixelReadback>();
+  result->screen_coords = screen_coords;
+  ReadbackRequest request{
+      result,
+      glm::inverse(camera->get_projection() * camera->get_view_matrix()),
+      glm::vec2(
+          2.0f * (float)screen_coords.x / (float)(info.window_width) - 1.0f,
+          -2.0f * (float)screen_coords.y / (float)(info.window_height) + 1.0f),
+      std::move(callback)};
+  // coalesce requests for the same pixel into one read
+  for (auto &pixel : readback_requests_) {
+    if (pixel.screen_coords == screen_coords) {
+      pixel.requests.push_back(std::move(request));
+      return result;
+    }
+  }
+  readback_requests_.push_back({screen_coords, {}});
+  readback_requests_.back().requests.push_back(std::move(request));
+  return result;
+}
+void Renderer::flush_readbacks(PixelReader *reader) {
+  if (!reader) {
+    return;
+  }
+  if (!readback_requests_.empty()) {
+    readback_pixels_.clear();
+    for (auto &pixel : readback_requests_) {
+      readback_pixels_.push_back(pixel.screen_coords);
+    }
+    if (reader->read(readback_pixels_)) {
+      readbacks_in_flight_.push_back(std::move(readback_requests_));
+      readback_requests_.clear();
+    }
+  }
+  if (id_requests_.empty()) {
+    return;
+  }
+  if (!info.id_pass || !id_framebuffer_) {
+    // there is nothing to read, deliver the empty results
+    std::vector<IDRequest> requests = std::move(id_requests_);
+    id_requests_.clear();
+    for (auto &request : requests) {
+      request.result->ready = true;
+      if (request.callback) {
+        request.callback(*request.result);
+      }
+    }
+    return;
+  }
+  id_rects_.clear();
+  for (auto &request : id_requests_) {
+    id_rects_.push_back(request.result->rect);
+  }
+  if (reader->read_ids(id_framebuffer_.get(), id_rects_)) {
+    ids_in_flight_.push_back({id_frame_, std::move(id_requests_)});
+    id_requests_.clear();
+  }
+}
+void Renderer::collect_readbacks(PixelReader *reader) {
+  if (!reader) {
+    return;
+  }
+  while (!readbacks_in_flight_.empty() && reader->poll(readback_depths_)) {
+    // move the batch out first so callbacks may request new reads
+    std::vector<PixelRequests> batch = std::move(readbacks_in_flight_.front());
+    readbacks_in_flight_.pop_front();
+    for (size_t i = 0; i < batch.size() && i < readback_depths_.size(); i++) {
+      float depth = readback_depths_[i];
+      for (auto &request : batch[i].requests) {
+        glm::vec4 world_vector =
+            request.inverse_view_projection *
+            glm::vec4(request.device_coords, 2.0f * depth - 1.0f, 1.0f);
+        request.result->depth = depth;
+        request.result->position = glm::vec3(world_vector) / world_vector.w;
+        request.result->ready = true;
+        if (request.callback) {
+          request.callback(*request.result);
+        }
+      }
+    }
+  }
+  while (!ids_in_flight_.empty() && reader->poll_ids(id_values_)) {
+    IDBatch batch = std::move(ids_in_flight_.front());
+    ids_in_flight_.pop_front();
+    const std::vector<PickTarget> *table = get_id_table(batch.frame);
+    size_t offset = 0;
+    for (auto &request : batch.requests) {
+      size_t count = request.result->rect.area();
+      if (table && offset + count <= id_values_.size()) {
+        // each packet is reported once no matter how many pixels it covers
+        auto begin = id_values_.begin() + offset;
+        std::sort(begin, begin + count);
+        auto end = std::unique(begin, begin + count);
+        for (auto it = begin; it != end; it++) {
+          if (*it && *it <= table->size()) {
+            request.result->targets.push_back((*table)[*it - 1]);
+          }
+        }
+      }
+      offset += count;
+      request.result->ready = true;
+      if (request.callback) {
+        request.callback(*request.result);
+      }
+    }
+  }
+}
+void Renderer::clear_readbacks() {
+  readback_requests_.clear();
+  readbacks_in_flight_.clear();
+  id_requests_.clear();
+  ids_in_flight_.clear();
+  for (auto &table : id_tables_) {
+    table.clear();
+  }
+  // The ID pass resources belong to the Rendering API
+  id_framebuffer_.reset();
+  id_framebuffer_size_ = glm::ivec2(0);
+  id_material_.reset();
+}
+void Renderer::enable_id_pass(bool enable) {
+  info.id_pass = enable;
+  if (!enable) {
+    id_framebuffer_.reset();
+    id_framebuffer_size_ = glm::ivec2(0);
+  }
+}
+PickTarget Renderer::resolve_id(uint32_t id) {
+  const std::vector<PickTarget> *table = get_id_table(id_frame_);
+  if (!table || !id || id > table->size()) {
+    return PickTarget{};
+  }
+  return (*table)[id - 1];
+}
+Referenced<const IDReadback>
+Renderer::pick_async(glm::ivec2 min, glm::ivec2 max,
+                     IDReadbackCallback callback) {
+  auto result = gen_ref<IDReadback>();
+  glm::ivec2 window{info.window_width, info.window_height};
+  result->rect.min = glm::clamp(glm::min(min, max), glm::ivec2(0), window);
+  result->rect.max = glm::clamp(glm::max(min, max), glm::ivec2(0), window);
+  id_requests_.push_back({result, std::move(callback)});
+  return result;
+}
+const std::vector<PickTarget> *Renderer::get_id_table(uint64_t frame) {
+  // a table is overwritten id_tables passes after it was drawn
+  if (!frame || frame < id_valid_frame_ || frame + id_tables <= id_frame_) {
+    return nullptr;
+  }
+  return &id_tables_[frame % id_tables];
+}
+void Renderer::render_id_pass() {
+  MARE_PROFILE_GPU_SCOPE("ID Pass");
+  glm::ivec2 size{info.window_width, info.window_height};
+  if (!id_framebuffer_ || id_framebuffer_size_ != size) {
+    id_framebuffer_ = gen_framebuffer(size.x, size.y, TextureType::R32UI);
+    id_framebuffer_size_ = size;
+  }
+  if (!id_material_) {
+    id_material_ = gen_scoped<EntityIDMaterial>();
+  }
+  id_frame_++;
+  std::vector<PickTarget> &table = id_tables_[id_frame_ % id_tables];
+  table.clear();
+
+  set_framebuffer(id_framebuffer_.get());
+  enable_depth_testing(true);
+  clear_color_buffer(glm::uvec4(0));
+  auto render_layer = [&table](Layer *layer) {
+    // Each Layer has its own projection, so it is drawn over the last one
+    clear_depth_buffer();
+    for (auto entity_it = layer->entity_begin();
+         entity_it != layer->entity_end(); entity_it++) {
+      Entity *entity = entity_it->get();
+      auto pack = dynamic_cast<RenderPack *>(entity);
+      if (!pack) {
+        continue;
+      }
+      Transform *world = entity->get_world_transform();
+      for (auto it = pack->packets_begin(); it != pack->packets_end(); it++) {
+        Mesh *mesh = it->first.get();
+        if (info.frustum_culling &&
+            !mesh->intersects(layer->get_frustum(), world)) {
+          continue;
+        }
+        table.push_back({entity, mesh});
+        id_material_->set_id(uint32_t(table.size()));
+        mesh->render(layer, id_material_.get(), world);
+      }
+    }
+  };
+  render_layer(info.scene);
+  for (auto layr_it = info.scene->layer_begin();
+       layr_it != info.scene->layer_end(); layr_it++) {
+    if (Layer *layer = layr_it->get()) {
+      render_layer(layer);
+    }
+  }
+  set_framebuffer(nullptr);
+}
+Ray Renderer::get_ray(Camera *camera, glm::ivec2 screen_coords) {
+  glm::mat4 inversed_camera =
+      glm::inverse(camera->get_projection() * camera->get_view_matrix());
+  float x = 2.0f * (float)screen_coords.x / (float)(info.window_width) - 1.0f;
+  float y = -2.0f * (float)screen_coords.y / (float)(info.window_height) + 1.0f;
+  glm::vec4 near_point = inversed_camera * glm::vec4(x, y, -1.0f, 1.0f);
+  glm::vec4 far_point = inversed_camera * glm::vec4(x, y, 1.0f, 1.0f);
+  glm::vec3 origin = glm::vec3(near_point) / near_point.w;
+  glm::vec3 segment = glm::vec3(far_point) / far_point.w - origin;
+  float length = glm::length(segment);
+  return {origin, segment / length, length};
+}
+RayHit Renderer::pick(Layer *layer, const Ray &ray) {
+  // Entities may have moved or changed their Packets since the frame's update,
+  // only those are refit
+  layer->get_hierarchy().update();
+  layer->get_spatial_index().update();
+  RayHit hit{};
+  layer->get_spatial_index().raycast(
+      ray.origin, ray.direction, ray.length, [&](Entity *entity, float) {
+        if (auto pack = dynamic_cast<RenderPack *>(entity)) {
+          for (auto it = pack->packets_begin(); it != pack->packets_end();
+               it++) {
+            if (it->first->raycast(ray, entity->get_world_transform(), hit)) {
+              hit.entity = entity;
+            }
+          }
+        }
+        return std::min(hit.distance, ray.length);
+      });
+  return hit;
+}
+RayHit Renderer::pick(Layer *layer, glm::ivec2 screen_coords) {
+  return pick(layer, get_ray(layer, screen_coords));
+}
+JobSystem *Renderer::get_job_system() {
+  if (!jobs_) {
+    jobs_ = gen_scoped<JobSystem>(info.physics_threads);
+  }
+  return jobs_.get();
+}
+void Renderer::update_physics(float delta_time) {
+  if (!info.scene) {
+    return;
+  }
+  MARE_PROFILE_SCOPE("Physics");
+  // Gather the physics updates of the frame. The vectors keep their capacity
+  // between frames so this does not allocate once the Scene is warmed up.
+  parallel_physics_.clear();
+  serial_physics_.clear();
+  auto gather = [](Entity *entity) {
+    for (auto system : entity->physics_systems()) {
+      if (system) {
+        if (system->is_thread_safe()) {
+          parallel_physics_.push_back({system, entity});
+        } else {
+          serial_physics_.push_back({system, entity});
+        }
+      }
+    }
+  };
+  gather(info.scene);
+  for (auto entity_it = info.scene->entity_begin();
+       entity_it != info.scene->entity_end(); entity_it++) {
+    if (Entity *entity = entity_it->get()) {
+      gather(entity);
+    }
+  }
+  for (auto layr_it = info.scene->layer_begin();
+       layr_it != info.scene->layer_end(); layr_it++) {
+    if (Layer *layer = layr_it->get()) {
+      gather(layer);
+      for (auto ent_it = layer->entity_begin(); ent_it != layer->entity_end();
+           ent_it++) {
+        if (Entity *entity = ent_it->get()) {
+          gather(entity);
+        }
+      }
+    }
+  }
+  // Thread safe Systems run on the job system, parallel_for() is the barrier
+  if (!parallel_physics_.empty()) {
+    // typed lookups from the workers must not build TypeIndex caches
+    type_index::ReadOnlyScope read_only{};
+    get_job_system()->parallel_for(
+        parallel_physics_.size(), info.physics_grain_size,
+        [delta_time](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++) {
+            MARE_PROFILE_TYPE(*parallel_physics_[i].first);
+            parallel_physics_[i].first->update(delta_time,
+                                               parallel_physics_[i].second);
+          }
+        });
+  }
+  for (auto &update : serial_physics_) {
+    MARE_PROFILE_TYPE(*update.first);
+    update.first->update(delta_time, update.second);
+  }
+}
+void Renderer::step_physics(float frame_time) {
+  if (info.fixed_timestep <= 0.0f) {
+    if (info.interpolation_alpha < 1.0f) {
+      interpolate_rigidbodies(false);
+    }
+    physics_accumulator_ = 0.0;
+    info.interpolation_alpha = 1.0f;
+    update_physics(frame_time);
+    return;
+  }
+  physics_accumulator_ += frame_time;
+  unsigned int steps = 0;
+  while (physics_accumulator_ >= info.fixed_timestep &&
+         steps < info.max_physics_steps) {
+    store_previous_positions();
+    update_physics(info.fixed_timestep);
+    physics_accumulator_ -= info.fixed_timestep;
+    steps++;
+  }
+  // Drop the time that could not be simulated this frame so a slow frame does
+  // not cause every following frame to run the maximum number of steps
+  if (physics_accumulator_ >= info.fixed_timestep) {
+    physics_accumulator_ = std::fmod(physics_accumulator_, info.fixed_timestep);
+  }
+  info.interpolation_alpha =
+      static_cast<float>(physics_accumulator_ / info.fixed_timestep);
+  interpolate_rigidbodies(true);
+}
+void Renderer::store_previous_positions() {
+  auto store = [](Layer *layer) {
+    for (Rigidbody *rb : layer->get_entities<Rigidbody>()) {
+      rb->previous_position = rb->get_position();
+      rb->previous_stored = true;
+    }
+    layer->each<Transform, RigidbodyState>(
+        [](Transform &transform, RigidbodyState &rb) {
+          rb.previous_position = transform.get_position();
+          rb.previous_stored = true;
+        });
+  };
+  store(info.scene);
+  for (auto layr_it = info.scene->layer_begin();
+       layr_it != info.scene->layer_end(); layr_it++) {
+    if (Layer *layer = layr_it->get()) {
+      store(layer);
+    }
+  }
+}
+void Renderer::interpolate_rigidbodies(bool interpolate) {
+  float alpha = info.interpolation_alpha;
+  auto apply = [interpolate, alpha](Layer *layer) {
+    for (Rigidbody *rb : layer->get_entities<Rigidbody>()) {
+      if (!interpolate) {
+        rb->clear_render_transform();
+        continue;
+      }
+      glm::mat4 matrix = rb->get_transformation_matrix();
+      matrix[3] = glm::vec4(rb->get_interpolated_position(alpha), 1.0f);
+      rb->set_render_transform(matrix);
+    }
+  };
+  apply(info.scene);
+  for (auto layr_it = info.scene->layer_begin();
+       layr_it != info.scene->layer_end(); layr_it++) {
+    if (Layer *layer = layr_it->get()) {
+      apply(layer);
+    }
+  }
+}
+void Renderer::sync_structure() {
+  if (!commands().empty()) {
+    MARE_PROFILE_SCOPE("Apply Commands");
+    commands().apply();
+  }
+  if (!structure_dirty_ || !info.scene) {
+    return;
+  }
+  structure_dirty_ = false;
+  // IDs read back from earlier passes may refer to pulled Entities
+  id_valid_frame_ = id_frame_ + 1;
+  {
+    MARE_PROFILE_SCOPE("Remove Null");
+    info.scene->remove_null_layers();
+    info.scene->remove_null_entities();
+    info.scene->remove_null_systems();
+    for (auto entity_it = info.scene->entity_begin();
+         entity_it != info.scene->entity_end(); entity_it++) {
+      if (Entity *entity = entity_it->get()) {
+        entity->remove_null_systems();
+      }
+    }
+    for (auto layr_it = info.scene->layer_begin();
+         layr_it != info.scene->layer_end(); layr_it++) {
+      if (Layer *layer = layr_it->get()) {
+        layer->remove_null_entities();
+        layer->remove_null_systems();
+        for (auto ent_it = layer->entity_begin();
+             ent_it != layer->entity_end(); ent_it++) {
+          if (Entity *entity = ent_it->get()) {
+            entity->remove_null_systems();
+          }
+        }
+      }
+    }
+  }
+}
+void Renderer::render_frame(float delta_time) {
+  // Update render and physics systems
+  if (!info.scene) {
+    return;
+  }
+  sync_structure();
+  frame_++;
+  info.packets_drawn = 0;
+  info.packets_culled = 0;
+
+  // Physics phase, every physics System finishes before rendering begins
+  step_physics(delta_time);
+
+  // World transforms of parented Entities and the spatial indices
+  {
+    MARE_PROFILE_SCOPE("Transforms");
+    info.scene->get_hierarchy().update();
+    info.scene->get_spatial_index().update();
+    for (auto layr_it = info.scene->layer_begin();
+         layr_it != info.scene->layer_end(); layr_it++) {
+      if (Layer *layer = layr_it->get()) {
+        layer->get_hierarchy().update();
+        layer->get_spatial_index().update();
+      }
+    }
+  }
+
+  // Render phase
+  {
+    MARE_PROFILE_GPU_SCOPE("Scene Systems");
+    queue_enabled_ = info.scene->uses_render_queue();
+    info.scene->render(delta_time);
+    // Scene/Camera systems
+    // The cached System lists are indexed rather than iterated so a System
+    // may safely push new Systems while the lists are being walked.
+    const auto &scene_render = info.scene->render_systems();
+    for (size_t i = 0; i < scene_render.size(); i++) {
+      if (IRenderSystem *system = scene_render[i]) {
+        MARE_PROFILE_TYPE(*system);
+        system->render(delta_time, info.scene, info.scene);
+      }
+    }
+  }
+
+  // Entities in scene
+  {
+    MARE_PROFILE_GPU_SCOPE("Scene Entities");
+    for (auto entity_it = info.scene->entity_begin();
+         entity_it != info.scene->entity_end(); entity_it++) {
+      Entity *entity = entity_it->get();
+      if (entity) {
+        const auto &render_systems = entity->render_systems();
+        for (size_t i = 0; i < render_systems.size(); i++) {
+          if (IRenderSystem *system = render_systems[i]) {
+            MARE_PROFILE_TYPE(*system);
+            system->render(delta_time, info.scene, entity);
+          }
+        }
+      }
+    }
+    flush_render_queue();
+  }
+  // Layers on scene and entities/widgets in overlays
+  for (auto layr_it = info.scene->layer_begin();
+       layr_it != info.scene->layer_end(); layr_it++) {
+    Layer *layer = layr_it->get();
+    if (layer) {
+      MARE_PROFILE_GPU_SCOPE(typeid(*layer).name());
+      queue_enabled_ = layer->uses_render_queue();
+      layer->render(delta_time);
+      const auto &layer_render = layer->render_systems();
+      for (size_t i = 0; i < layer_render.size(); i++) {
+        if (IRenderSystem *system = layer_render[i]) {
+          MARE_PROFILE_TYPE(*system);
+          system->render(delta_time, layer, layer);
+        }
+      }
+
+      for (auto ent_it = layer->entity_begin();
+           ent_it != layer->entity_end(); ent_it++) {
+        Entity *entity = ent_it->get();
+        if (entity) {
+          const auto &render_systems = entity->render_systems();
+          for (size_t i = 0; i < render_systems.size(); i++) {
+            if (IRenderSystem *system = render_systems[i]) {
+              MARE_PROFILE_TYPE(*system);
+              system->render(delta_time, layer, entity);
+            }
+          }
+        }
+      }
+      flush_render_queue();
+    }
+  }
+  queue_enabled_ = false;
+
+  // Entity ID pass
+  if (info.id_pass) {
+    render_id_pass();
+  }
+}
 void Renderer::load_scene(Scene *scene) {
   // If there is a current scene, exit scene
   if (info.scene) {
@@ -26,6 +664,8 @@ void Renderer::load_scene(Scene *scene) {
   }
   // Replace the scene pointer
   info.scene = scene;
+  // Entries pulled while the Scene was inactive are removed at the next sync
+  structure_dirty_ = true;
   // If the new scene is not nullptr, enter scene
   if (scene) {
     info.scene->on_enter();
@@ -50,6 +690,7 @@ void Renderer::load_scene(int index) {
   if (API) {
     info.scene = get_scenes<Scene>()[index];
   }
+  structure_dirty_ = true;
   // If the new scene is not nullptr, enter scene
   if (info.scene) {
     info.scene->on_enter();
@@ -60,4 +701,76 @@ void Renderer::load_scene(int index) {
     }
   }
 }
+void Renderer::invalidate_controls(Entity *entity) {
+  if (Layer *layer = entity->get_layer()) {
+    layer->invalidate_controls(entity);
+  }
+  if (Layer *layer = dynamic_cast<Layer *>(entity)) {
+    layer->invalidate_controls(entity);
+  }
+}
+bool Renderer::dispatch_controls(ControlsEvent event, char character) {
+  Scene *scene = info.scene;
+  if (!scene) {
+    return false;
+  }
+  // apply the changes made since the last event
+  for (auto layr_it = scene->layer_begin(); layr_it != scene->layer_end();
+       layr_it++) {
+    if (Layer *layer = layr_it->get()) {
+      layer->update_controls();
+    }
+  }
+  scene->update_controls();
+  // layers from the top of the layer stack, by index since a listener may
+  // push a layer
+  size_t layer_count = scene->layer_end() - scene->layer_begin();
+  for (size_t i = layer_count; i-- > 0;) {
+    Referenced<Layer> layer = *(scene->layer_begin() + i);
+    if (layer && dispatch_controls(layer.get(), event, character)) {
+      return true;
+    }
+  }
+  if (event == ControlsEvent::MOUSE_BUTTON) {
+    // if the event is not handled by layers, unfocus UIElements
+    UIElement::focus(nullptr);
+  }
+  // then the scene entities and the scene
+  return dispatch_controls(scene, event, character);
+}
+bool Renderer::dispatch_controls(Layer *layer, ControlsEvent event,
+                                 char character) {
+  const auto &listeners = layer->controls_listeners(event);
+  for (size_t i = 0; i < listeners.size(); i++) {
+    IControlsSystem *system = listeners[i].system;
+    Entity *entity = listeners[i].entity;
+    bool handled = false;
+    switch (event) {
+    case ControlsEvent::KEY:
+      handled = system->on_key(input, entity);
+      break;
+    case ControlsEvent::MOUSE_BUTTON:
+      handled = system->on_mouse_button(input, entity);
+      break;
+    case ControlsEvent::MOUSE_MOVE:
+      handled = system->on_mouse_move(input, entity);
+      break;
+    case ControlsEvent::MOUSE_WHEEL:
+      handled = system->on_mouse_wheel(input, entity);
+      break;
+    case ControlsEvent::RESIZE:
+      handled = system->on_resize(input, entity);
+      break;
+    case ControlsEvent::CHAR:
+      handled = system->on_char(character, entity);
+      break;
+    default:
+      break;
+    }
+    if (handled) {
+      return true;
+    }
+  }
+  return false;
+}
 } // namespace mare
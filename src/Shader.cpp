@@ -25,9 +25,7 @@ void ComputeProgram::dispatch_compute(uint32_t x, uint32_t y, uint32_t z) {
 void ComputeProgram::barrier(BarrierType type) { shader_->barrier(type); }
 
 void Material::upload_camera(Camera *camera, bool suppress_warnings) {
-  shader_->upload_mat4("projection", camera->get_projection(),
-                       suppress_warnings);
-  shader_->upload_mat4("view", camera->get_view_matrix(), suppress_warnings);
+  Renderer::bind_camera(camera);
 }
 void Material::upload_mesh_model_matrix(Mesh *mesh, bool suppress_warnings) {
   shader_->upload_mat4("model", mesh->get_transformation_matrix(),
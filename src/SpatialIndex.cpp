@@ -0,0 +1,86 @@
+// MARE
+#include "SpatialIndex.hpp"
+#include "Layer.hpp"
+#include "Profiler.hpp"
+
+namespace mare {
+
+void SpatialIndex::insert(Entity *entity) {
+  if (!entity || positions_.count(entity)) {
+    return;
+  }
+  positions_[entity] = entities_.size();
+  entities_.push_back(entity);
+  proxies_.push_back(BVH::null_node);
+  worlds_.push_back(glm::mat4(1.0f));
+  dirty_.push_back(1);
+}
+
+void SpatialIndex::remove(Entity *entity) {
+  auto found = positions_.find(entity);
+  if (found == positions_.end()) {
+    return;
+  }
+  size_t position = found->second;
+  positions_.erase(found);
+  if (proxies_[position] != BVH::null_node) {
+    bvh_.remove(proxies_[position]);
+  }
+  size_t last = entities_.size() - 1;
+  if (position != last) {
+    entities_[position] = entities_[last];
+    proxies_[position] = proxies_[last];
+    worlds_[position] = worlds_[last];
+    dirty_[position] = dirty_[last];
+    positions_[entities_[position]] = position;
+  }
+  entities_.pop_back();
+  proxies_.pop_back();
+  worlds_.pop_back();
+  dirty_.pop_back();
+}
+
+void SpatialIndex::mark_dirty(Entity *entity) {
+  auto found = positions_.find(entity);
+  if (found != positions_.end()) {
+    dirty_[found->second] = 1;
+  }
+}
+
+void Entity::mark_bounds_dirty() {
+  if (layer_) {
+    layer_->get_spatial_index().mark_dirty(this);
+  }
+}
+
+void SpatialIndex::update() {
+  MARE_PROFILE_SCOPE("SpatialIndex");
+  for (size_t i = 0; i < entities_.size(); i++) {
+    glm::mat4 world =
+        entities_[i]->get_world_transform()->get_transformation_matrix();
+    if (!dirty_[i] && world == worlds_[i]) {
+      continue;
+    }
+    worlds_[i] = world;
+    AABB box = entities_[i]->get_bounds().transformed(world);
+    // Meshes that refit their bounds lazily mark the Entity again
+    dirty_[i] = 0;
+    if (box.empty()) {
+      if (proxies_[i] != BVH::null_node) {
+        bvh_.remove(proxies_[i]);
+        proxies_[i] = BVH::null_node;
+      }
+    } else if (proxies_[i] == BVH::null_node) {
+      proxies_[i] = bvh_.insert(entities_[i], box);
+    } else {
+      bvh_.move(proxies_[i], box);
+    }
+  }
+}
+
+void SpatialIndex::build() {
+  update();
+  bvh_.build();
+}
+
+} // namespace mare
@@ -0,0 +1,126 @@
+// MARE
+#include "TransformHierarchy.hpp"
+#include "BatchMath.hpp"
+
+namespace mare {
+
+bool TransformHierarchy::set_parent(Entity *child, Entity *parent) {
+  if (!child || child->parent_ == parent) {
+    return false;
+  }
+  for (Entity *ancestor = parent; ancestor; ancestor = ancestor->parent_) {
+    if (ancestor == child) {
+      return false;
+    }
+  }
+  if (Entity *old_parent = child->parent_) {
+    child->parent_ = nullptr;
+    members_[old_parent]--;
+    release(old_parent);
+  }
+  if (parent) {
+    insert(child);
+    insert(parent);
+    members_[parent]++;
+    child->parent_ = parent;
+    child->world_transform_.set_transformation_matrix(
+        parent->get_world_transform()->get_transformation_matrix() *
+        child->get_render_matrix());
+  } else {
+    release(child);
+  }
+  sorted_ = false;
+  return true;
+}
+
+void TransformHierarchy::remove(Entity *entity) {
+  auto member = members_.find(entity);
+  if (member == members_.end()) {
+    return;
+  }
+  if (member->second) {
+    std::vector<Entity *> children{};
+    for (auto &other : members_) {
+      if (other.first->parent_ == entity) {
+        children.push_back(other.first);
+      }
+    }
+    for (Entity *child : children) {
+      child->parent_ = nullptr;
+      release(child);
+    }
+    members_[entity] = 0;
+  }
+  set_parent(entity, nullptr);
+  release(entity);
+  sorted_ = false;
+}
+
+void TransformHierarchy::update() {
+  // Every world matrix is recomputed on the first pass after a change
+  bool all_dirty = !sorted_;
+  if (!sorted_) {
+    sort();
+  }
+  // Find every dirty child first, then compose them all in one batch
+  dirty_children_.clear();
+  for (size_t i = 0; i < order_.size(); i++) {
+    glm::mat4 local = order_[i]->get_render_matrix();
+    int32_t parent = parents_[i];
+    dirty_[i] = all_dirty || local != locals_[i] ||
+                (parent >= 0 && dirty_[parent]);
+    if (dirty_[i]) {
+      locals_[i] = local;
+      if (parent >= 0) {
+        dirty_children_.push_back(static_cast<uint32_t>(i));
+      } else {
+        worlds_[i] = local;
+      }
+    }
+  }
+  batch::multiply_parents(worlds_.data(), locals_.data(), parents_.data(),
+                          dirty_children_.data(), dirty_children_.size());
+  for (uint32_t i : dirty_children_) {
+    order_[i]->world_transform_.set_transformation_matrix(worlds_[i]);
+  }
+}
+
+void TransformHierarchy::insert(Entity *entity) {
+  members_.emplace(entity, 0);
+}
+
+void TransformHierarchy::release(Entity *entity) {
+  auto member = members_.find(entity);
+  if (member != members_.end() && !member->second && !entity->parent_) {
+    members_.erase(member);
+  }
+}
+
+void TransformHierarchy::sort() {
+  std::unordered_map<Entity *, std::vector<Entity *>> children{};
+  order_.clear();
+  for (auto &member : members_) {
+    if (member.first->parent_) {
+      children[member.first->parent_].push_back(member.first);
+    } else {
+      order_.push_back(member.first);
+    }
+  }
+  // Breadth first from the roots so every parent precedes its children
+  parents_.assign(order_.size(), -1);
+  for (size_t i = 0; i < order_.size(); i++) {
+    auto node_children = children.find(order_[i]);
+    if (node_children != children.end()) {
+      for (Entity *child : node_children->second) {
+        order_.push_back(child);
+        parents_.push_back(static_cast<int32_t>(i));
+      }
+    }
+  }
+  locals_.resize(order_.size());
+  worlds_.resize(order_.size());
+  dirty_.resize(order_.size());
+  sorted_ = true;
+}
+
+} // namespace mare
@@ -0,0 +1,139 @@
+// MARE
+#include "Components/RenderPack.hpp"
+#include "Headless/HeadlessRenderer.hpp"
+#include "Layer.hpp"
+#include "Materials/BasicColorMaterial.hpp"
+#include "Meshes.hpp"
+#include "Meshes/CubeMesh.hpp"
+
+// Standard Library
+#include <cstdio>
+
+// External Libraries
+#include "glm.hpp"
+
+using namespace mare;
+
+namespace {
+
+/**
+ * @brief A HeadlessRenderer that is driven by the test instead of run().
+ */
+class TestRenderer : public HeadlessRenderer {
+public:
+  void init_info() override {}
+  void startup() override {}
+};
+
+/**
+ * @brief An empty Layer to insert the test Entities into.
+ */
+class TestLayer : public Layer {
+public:
+  TestLayer() : Layer(ProjectionType::PERSPECTIVE) {}
+  void on_enter() override {}
+  void on_exit() override {}
+};
+
+/**
+ * @brief An Entity with an empty Packet stack.
+ */
+class Pack : public RenderPack {};
+
+int failures = 0; /**< The number of failed checks.*/
+
+/**
+ * @brief Check if the Layer's SpatialIndex finds an Entity in a small box.
+ *
+ * @param layer The Layer.
+ * @param entity The Entity to look for.
+ * @param point The center of the box.
+ * @param expected true if the Entity should be found.
+ * @param what The name of the check.
+ */
+void check(Layer &layer, Entity *entity, glm::vec3 point, bool expected,
+           const char *what) {
+  layer.get_spatial_index().update();
+  bool found = false;
+  layer.get_spatial_index().query(
+      AABB{point - glm::vec3(0.1f), point + glm::vec3(0.1f)},
+      [&](Entity *hit) {
+        found = found || hit == entity;
+        return true;
+      });
+  if (found != expected) {
+    std::printf("FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+} // namespace
+
+int main() {
+  TestRenderer renderer{};
+  Renderer::set_renderer(&renderer);
+  Renderer::get_info().API = RendererAPI::Headless;
+
+  TestLayer layer{};
+  Referenced<Pack> pack = layer.gen_entity<Pack>();
+  check(layer, pack.get(), glm::vec3(0.0f), false, "empty packet stack");
+  Referenced<Material> material = gen_ref<BasicColorMaterial>();
+
+  // Bounds change after the Entity was inserted and first indexed
+  Referenced<CubeMesh> cube = gen_ref<CubeMesh>(1.0f);
+  pack->push_packet({cube, material});
+  check(layer, pack.get(), glm::vec3(0.0f), true, "push_packet");
+
+  cube->set_position({10.0f, 0.0f, 0.0f});
+  check(layer, pack.get(), glm::vec3(0.0f), false, "moved mesh, old place");
+  check(layer, pack.get(), glm::vec3(10.0f, 0.0f, 0.0f), true,
+        "moved mesh, new place");
+
+  // pick() must not miss an Entity that moved since the last update
+  pack->set_position({0.0f, -10.0f, 0.0f});
+  RayHit hit = Renderer::pick(
+      &layer, Ray{{10.0f, -10.0f, 10.0f}, {0.0f, 0.0f, -1.0f}});
+  if (hit.entity != pack.get()) {
+    std::printf("FAILED: pick after moving the entity\n");
+    failures++;
+  }
+  pack->set_position(glm::vec3(0.0f));
+
+  auto instances = gen_ref<InstancedMesh>(4);
+  instances->set_mesh(gen_ref<CubeMesh>(1.0f));
+  pack->push_packet({instances, material});
+  Transform model{};
+  model.set_position({0.0f, 20.0f, 0.0f});
+  instances->push_instance(model);
+  check(layer, pack.get(), glm::vec3(0.0f, 20.0f, 0.0f), true,
+        "push_instance");
+
+  pack->pull_packets<InstancedMesh, BasicColorMaterial>();
+  check(layer, pack.get(), glm::vec3(10.0f, 0.0f, 0.0f), true,
+        "pull_packets keeps the other packets");
+
+  auto composite = gen_ref<CompositeMesh>();
+  pack->push_packet({composite, material});
+  check(layer, pack.get(), glm::vec3(10.0f, 0.0f, 0.0f), false,
+        "empty CompositeMesh is unbounded");
+  Referenced<CubeMesh> part = gen_ref<CubeMesh>(1.0f);
+  part->set_position({0.0f, 0.0f, 30.0f});
+  composite->push_mesh(part);
+  check(layer, pack.get(), glm::vec3(0.0f, 0.0f, 30.0f), true, "push_mesh");
+
+  // The fat boxes of the BVH only grow, so empty the stack to see the pulls
+  pack->pull_packet<CompositeMesh, BasicColorMaterial>();
+  pack->pull_packet<CubeMesh, BasicColorMaterial>();
+  check(layer, pack.get(), glm::vec3(10.0f, 0.0f, 0.0f), false,
+        "pull_packet");
+
+  pack->push_packet({cube, material});
+  layer.pull_entity(pack.get());
+  cube->set_position(glm::vec3(0.0f));
+  check(layer, pack.get(), glm::vec3(0.0f), false, "pulled entity");
+
+  if (!failures) {
+    std::printf("all SpatialIndex checks passed\n");
+  }
+  return failures ? 1 : 0;
+}